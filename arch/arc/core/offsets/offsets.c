@@ -26,11 +26,11 @@
 #include <kernel_structs.h>
 #include <kernel_offsets.h>
 
-GEN_OFFSET_SYM(_thread_arch_t, intlock_key);
-GEN_OFFSET_SYM(_thread_arch_t, relinquish_cause);
-GEN_OFFSET_SYM(_thread_arch_t, return_value);
+GEN_OFFSET_SYM(_thread_arch_hot_t, intlock_key);
+GEN_OFFSET_SYM(_thread_arch_hot_t, relinquish_cause);
+GEN_OFFSET_SYM(_thread_arch_hot_t, return_value);
 #ifdef CONFIG_ARC_STACK_CHECKING
-GEN_OFFSET_SYM(_thread_arch_t, stack_base);
+GEN_OFFSET_SYM(_thread_arch_hot_t, stack_base);
 #endif
 
 /* ARCv2-specific IRQ stack frame structure member offsets */
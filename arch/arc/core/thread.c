@@ -85,7 +85,7 @@ void _new_thread(struct k_thread *thread, k_thread_stack_t stack,
 	 */
 #ifdef CONFIG_ARC_STACK_CHECKING
 	pInitCtx->status32 = _ARC_V2_STATUS32_SC | _ARC_V2_STATUS32_E(_ARC_V2_DEF_IRQ_LEVEL);
-	thread->arch.stack_base = (u32_t) stackEnd;
+	thread->arch_hot.stack_base = (u32_t) stackEnd;
 #else
 	pInitCtx->status32 = _ARC_V2_STATUS32_E(_ARC_V2_DEF_IRQ_LEVEL);
 #endif
@@ -104,8 +104,8 @@ void _new_thread(struct k_thread *thread, k_thread_stack_t stack,
 	 * dst[31:6] dst[5] dst[4]       dst[3:0]
 	 *    26'd0    1    STATUS32.IE  STATUS32.E[3:0]
 	 */
-	thread->arch.intlock_key = 0x3F;
-	thread->arch.relinquish_cause = _CAUSE_COOP;
+	thread->arch_hot.intlock_key = 0x3F;
+	thread->arch_hot.relinquish_cause = _CAUSE_COOP;
 	thread->callee_saved.sp =
 		(u32_t)pInitCtx - ___callee_saved_stack_t_SIZEOF;
 
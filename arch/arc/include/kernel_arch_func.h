@@ -39,7 +39,7 @@ static ALWAYS_INLINE void kernel_arch_init(void)
 static ALWAYS_INLINE void
 _set_thread_return_value(struct k_thread *thread, unsigned int value)
 {
-	thread->arch.return_value = value;
+	thread->arch_hot.return_value = value;
 }
 
 static ALWAYS_INLINE int _is_in_isr(void)
@@ -11,6 +11,7 @@
  * This file contains defintions for
  *
  *  struct _thread_arch
+ *  struct _thread_arch_hot
  *  struct _callee_saved
  *  struct _caller_saved
  *
@@ -46,7 +47,8 @@ struct _callee_saved {
 };
 typedef struct _callee_saved _callee_saved_t;
 
-struct _thread_arch {
+/* fields every context switch uses, kept with the saved registers */
+struct _thread_arch_hot {
 
 	/* interrupt key when relinquishing control */
 	u32_t intlock_key;
@@ -65,6 +67,12 @@ struct _thread_arch {
 #endif
 };
 
+typedef struct _thread_arch_hot _thread_arch_hot_t;
+
+struct _thread_arch {
+	/* nothing for now */
+};
+
 typedef struct _thread_arch _thread_arch_t;
 
 #endif /* _ASMLANGUAGE */
@@ -18,16 +18,17 @@
 /* threads */
 
 #define _thread_offset_to_intlock_key \
-	(___thread_t_arch_OFFSET + ___thread_arch_t_intlock_key_OFFSET)
+	(___thread_t_arch_hot_OFFSET + ___thread_arch_hot_t_intlock_key_OFFSET)
 
 #define _thread_offset_to_relinquish_cause \
-	(___thread_t_arch_OFFSET + ___thread_arch_t_relinquish_cause_OFFSET)
+	(___thread_t_arch_hot_OFFSET + \
+	 ___thread_arch_hot_t_relinquish_cause_OFFSET)
 
 #define _thread_offset_to_return_value \
-	(___thread_t_arch_OFFSET + ___thread_arch_t_return_value_OFFSET)
+	(___thread_t_arch_hot_OFFSET + ___thread_arch_hot_t_return_value_OFFSET)
 
 #define _thread_offset_to_stack_base \
-	(___thread_t_arch_OFFSET + ___thread_arch_t_stack_base_OFFSET)
+	(___thread_t_arch_hot_OFFSET + ___thread_arch_hot_t_stack_base_OFFSET)
 
 #define _thread_offset_to_sp \
 	(___thread_t_callee_saved_OFFSET + ___callee_saved_t_sp_OFFSET)
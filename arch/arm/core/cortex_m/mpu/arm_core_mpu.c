@@ -32,20 +32,41 @@ void configure_mpu_stack_guard(struct k_thread *thread)
 #endif
 
 #if defined(CONFIG_USERSPACE)
+/* memory domain the MPU is programmed for, and its generation then */
+static struct k_mem_domain *mpu_mem_domain;
+static u32_t mpu_mem_domain_generation;
+static u8_t mpu_mem_domain_valid;
+
 /*
  * @brief Configure MPU memory domain
  *
  * This function configures per thread memory domain reprogramming the MPU.
  * The functionality is meant to be used during context switch.
  *
+ * The MPU is left alone when the thread belongs to the memory domain it is
+ * already programmed for, and the partitions of that domain have not
+ * changed since.
+ *
  * @param thread thread info data structure.
  */
 void configure_mpu_mem_domain(struct k_thread *thread)
 {
+	struct k_mem_domain *mem_domain = thread->mem_domain_info.mem_domain;
+
+	if (mpu_mem_domain_valid && mem_domain == mpu_mem_domain &&
+	    (!mem_domain ||
+	     mem_domain->generation == mpu_mem_domain_generation)) {
+		return;
+	}
+
 	SYS_LOG_DBG("configure thread %p's domain", thread);
 	arm_core_mpu_disable();
-	arm_core_mpu_configure_mem_domain(thread->mem_domain_info.mem_domain);
+	arm_core_mpu_configure_mem_domain(mem_domain);
 	arm_core_mpu_enable();
+
+	mpu_mem_domain = mem_domain;
+	mpu_mem_domain_generation = mem_domain ? mem_domain->generation : 0;
+	mpu_mem_domain_valid = 1;
 }
 
 int _arch_mem_domain_max_partitions_get(void)
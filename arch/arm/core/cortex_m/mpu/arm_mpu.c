@@ -18,6 +18,19 @@
 /* ARM MPU Enabled state */
 static u8_t arm_mpu_enabled;
 
+#if defined(CONFIG_USERSPACE)
+/*
+ * Values last written to the regions of the memory domain partitions, so
+ * that switching between domains only rewrites the regions that differ.
+ * ARM MPU supports up to 16 Regions.
+ */
+static struct {
+	u32_t rbar;
+	u32_t rasr;
+} domain_regions[16];
+static u8_t domain_regions_valid;
+#endif /* CONFIG_USERSPACE */
+
 /**
  * The attributes referenced in this function are described at:
  * https://goo.gl/hMry3r
@@ -190,6 +203,22 @@ void arm_core_mpu_configure(u8_t type, u32_t base, u32_t size)
 }
 
 #if defined(CONFIG_USERSPACE)
+static void _domain_region_set(u32_t index, u32_t rbar, u32_t rasr)
+{
+	if (domain_regions_valid &&
+	    domain_regions[index].rbar == rbar &&
+	    domain_regions[index].rasr == rasr) {
+		return;
+	}
+
+	domain_regions[index].rbar = rbar;
+	domain_regions[index].rasr = rasr;
+
+	ARM_MPU_DEV->rnr = index;
+	ARM_MPU_DEV->rbar = rbar;
+	ARM_MPU_DEV->rasr = rasr;
+}
+
 /**
  * @brief configure MPU regions for the memory partitions of the memory domain
  *
@@ -219,17 +248,21 @@ void arm_core_mpu_configure_mem_domain(struct k_mem_domain *mem_domain)
 				    region_index, pparts->start, pparts->size);
 			region_attr = pparts->attr |
 				      _size_to_mpu_rasr_size(pparts->size);
-			_region_init(region_index, pparts->start, region_attr);
+			_domain_region_set(region_index,
+					   (pparts->start &
+					    REGION_BASE_ADDR_MASK) |
+					   REGION_VALID | region_index,
+					   region_attr | REGION_ENABLE);
 			num_partitions--;
 		} else {
 			SYS_LOG_DBG("disable region 0x%x", region_index);
 			/* Disable region */
-			ARM_MPU_DEV->rnr = region_index;
-			ARM_MPU_DEV->rbar = 0;
-			ARM_MPU_DEV->rasr = 0;
+			_domain_region_set(region_index, 0, 0);
 		}
 		pparts++;
 	}
+
+	domain_regions_valid = 1;
 }
 
 /**
@@ -251,14 +284,15 @@ void arm_core_mpu_configure_mem_partition(u32_t part_index,
 		SYS_LOG_DBG("set region 0x%x 0x%x 0x%x",
 			    region_index + part_index, part->start, part->size);
 		region_attr = part->attr | _size_to_mpu_rasr_size(part->size);
-		_region_init(region_index + part_index, part->start,
-			     region_attr);
+		region_index += part_index;
+		_domain_region_set(region_index,
+				   (part->start & REGION_BASE_ADDR_MASK) |
+				   REGION_VALID | region_index,
+				   region_attr | REGION_ENABLE);
 	} else {
 		SYS_LOG_DBG("disable region 0x%x", region_index + part_index);
 		/* Disable region */
-		ARM_MPU_DEV->rnr = region_index + part_index;
-		ARM_MPU_DEV->rbar = 0;
-		ARM_MPU_DEV->rasr = 0;
+		_domain_region_set(region_index + part_index, 0, 0);
 	}
 }
 
@@ -18,6 +18,15 @@
 /* NXP MPU Enabled state */
 static u8_t nxp_mpu_enabled;
 
+#if defined(CONFIG_USERSPACE)
+/*
+ * Region descriptors last written for the memory domain partitions, so
+ * that switching between domains only rewrites the regions that differ.
+ */
+static u32_t domain_regions[FSL_FEATURE_SYSMPU_DESCRIPTOR_COUNT][4];
+static u8_t domain_regions_valid;
+#endif /* CONFIG_USERSPACE */
+
 /**
  * This internal function is utilized by the MPU driver to parse the intent
  * type (i.e. THREAD_STACK_REGION) and return the correct parameter set.
@@ -209,6 +218,27 @@ void arm_core_mpu_configure(u8_t type, u32_t base, u32_t size)
 }
 
 #if defined(CONFIG_USERSPACE)
+static void _domain_region_set(u32_t index, u32_t base, u32_t end,
+			       u32_t attr, u32_t valid)
+{
+	u32_t *words = domain_regions[index];
+
+	if (domain_regions_valid && words[0] == base && words[1] == end &&
+	    words[2] == attr && words[3] == valid) {
+		return;
+	}
+
+	words[0] = base;
+	words[1] = end;
+	words[2] = attr;
+	words[3] = valid;
+
+	SYSMPU->WORD[index][0] = base;
+	SYSMPU->WORD[index][1] = end;
+	SYSMPU->WORD[index][2] = attr;
+	SYSMPU->WORD[index][3] = valid;
+}
+
 /**
  * @brief configure MPU regions for the memory partitions of the memory domain
  *
@@ -241,20 +271,20 @@ void arm_core_mpu_configure_mem_domain(struct k_mem_domain *mem_domain)
 			SYS_LOG_DBG("set region 0x%x 0x%x 0x%x",
 				    region_index, pparts->start, pparts->size);
 			region_attr = pparts->attr;
-			_region_init(region_index, pparts->start,
-				     ENDADDR_ROUND(pparts->start+pparts->size),
-				     region_attr);
+			_domain_region_set(region_index, pparts->start,
+					   ENDADDR_ROUND(pparts->start +
+							 pparts->size),
+					   region_attr, SYSMPU_WORD_VLD_MASK);
 			num_partitions--;
 		} else {
 			SYS_LOG_DBG("disable region 0x%x", region_index);
 			/* Disable region */
-			SYSMPU->WORD[region_index][0] = 0;
-			SYSMPU->WORD[region_index][1] = 0;
-			SYSMPU->WORD[region_index][2] = 0;
-			SYSMPU->WORD[region_index][3] = 0;
+			_domain_region_set(region_index, 0, 0, 0, 0);
 		}
 		pparts++;
 	}
+
+	domain_regions_valid = 1;
 }
 
 /**
@@ -276,16 +306,13 @@ void arm_core_mpu_configure_mem_partition(u32_t part_index,
 		SYS_LOG_DBG("set region 0x%x 0x%x 0x%x",
 			    region_index + part_index, part->start, part->size);
 		region_attr = part->attr;
-		_region_init(region_index + part_index, part->start,
-			     ENDADDR_ROUND(part->start + part->size),
-			     region_attr);
+		_domain_region_set(region_index + part_index, part->start,
+				   ENDADDR_ROUND(part->start + part->size),
+				   region_attr, SYSMPU_WORD_VLD_MASK);
 	} else {
 		SYS_LOG_DBG("disable region 0x%x", region_index);
 		/* Disable region */
-		SYSMPU->WORD[region_index + part_index][0] = 0;
-		SYSMPU->WORD[region_index + part_index][1] = 0;
-		SYSMPU->WORD[region_index + part_index][2] = 0;
-		SYSMPU->WORD[region_index + part_index][3] = 0;
+		_domain_region_set(region_index + part_index, 0, 0, 0, 0);
 	}
 }
 
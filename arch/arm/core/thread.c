@@ -84,7 +84,7 @@ void _new_thread(struct k_thread *thread, k_thread_stack_t stack,
 #endif
 
 	thread->callee_saved.psp = (u32_t)pInitCtx;
-	thread->arch.basepri = 0;
+	thread->arch_hot.basepri = 0;
 
 	/* swap_return_value can contain garbage */
 
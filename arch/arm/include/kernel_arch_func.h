@@ -87,7 +87,7 @@ _arch_switch_to_main_thread(struct k_thread *main_thread,
 static ALWAYS_INLINE void
 _set_thread_return_value(struct k_thread *thread, unsigned int value)
 {
-	thread->arch.swap_return_value = value;
+	thread->arch_hot.swap_return_value = value;
 }
 
 extern void k_cpu_atomic_idle(unsigned int key);
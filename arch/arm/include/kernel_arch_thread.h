@@ -11,6 +11,7 @@
  * This file contains defintions for
  *
  *  struct _thread_arch
+ *  struct _thread_arch_hot
  *  struct _callee_saved
  *  struct _caller_saved
  *
@@ -78,13 +79,19 @@ struct _preempt_float {
 };
 #endif
 
-struct _thread_arch {
+/* fields every context switch uses, kept with the saved registers */
+struct _thread_arch_hot {
 
 	/* interrupt locking key */
 	u32_t basepri;
 
 	/* r0 in stack frame cannot be written to reliably */
 	u32_t swap_return_value;
+};
+
+typedef struct _thread_arch_hot _thread_arch_hot_t;
+
+struct _thread_arch {
 
 #ifdef CONFIG_FLOAT
 	/*
@@ -18,10 +18,11 @@
 /* threads */
 
 #define _thread_offset_to_basepri \
-	(___thread_t_arch_OFFSET + ___thread_arch_t_basepri_OFFSET)
+	(___thread_t_arch_hot_OFFSET + ___thread_arch_hot_t_basepri_OFFSET)
 
 #define _thread_offset_to_swap_return_value \
-	(___thread_t_arch_OFFSET + ___thread_arch_t_swap_return_value_OFFSET)
+	(___thread_t_arch_hot_OFFSET + \
+	 ___thread_arch_hot_t_swap_return_value_OFFSET)
 
 #define _thread_offset_to_preempt_float \
 	(___thread_t_arch_OFFSET + ___thread_arch_t_preempt_float_OFFSET)
@@ -11,6 +11,7 @@
  * This file contains defintions for
  *
  *  struct _thread_arch
+ *  struct _thread_arch_hot
  *  struct _callee_saved
  *  struct _caller_saved
  *
@@ -63,6 +64,13 @@ struct _callee_saved {
 
 typedef struct _callee_saved _callee_saved_t;
 
+/* fields every context switch uses, kept with the saved registers */
+struct _thread_arch_hot {
+	/* nothing for now */
+};
+
+typedef struct _thread_arch_hot _thread_arch_hot_t;
+
 struct _thread_arch {
 	/* nothing for now */
 };
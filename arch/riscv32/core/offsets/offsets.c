@@ -17,8 +17,8 @@
 #include <kernel_structs.h>
 #include <kernel_offsets.h>
 
-/* thread_arch_t member offsets */
-GEN_OFFSET_SYM(_thread_arch_t, swap_return_value);
+/* thread_arch_hot_t member offsets */
+GEN_OFFSET_SYM(_thread_arch_hot_t, swap_return_value);
 
 /* struct coop member offsets */
 GEN_OFFSET_SYM(_callee_saved_t, sp);
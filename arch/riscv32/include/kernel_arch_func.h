@@ -34,7 +34,7 @@ static ALWAYS_INLINE void kernel_arch_init(void)
 static ALWAYS_INLINE void
 _set_thread_return_value(struct k_thread *thread, unsigned int value)
 {
-	thread->arch.swap_return_value = value;
+	thread->arch_hot.swap_return_value = value;
 }
 
 static inline void _IntLibInit(void)
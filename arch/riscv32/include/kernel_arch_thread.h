@@ -11,6 +11,7 @@
  * This file contains defintions for
  *
  *  struct _thread_arch
+ *  struct _thread_arch_hot
  *  struct _callee_saved
  *  struct _caller_saved
  *
@@ -54,10 +55,17 @@ struct _caller_saved {
 
 typedef struct _caller_saved _caller_saved_t;
 
-struct _thread_arch {
+/* fields every context switch uses, kept with the saved registers */
+struct _thread_arch_hot {
 	u32_t swap_return_value; /* Return value of _Swap() */
 };
 
+typedef struct _thread_arch_hot _thread_arch_hot_t;
+
+struct _thread_arch {
+	/* nothing for now */
+};
+
 typedef struct _thread_arch _thread_arch_t;
 
 #endif /* _ASMLANGUAGE */
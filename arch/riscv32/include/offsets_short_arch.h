@@ -57,7 +57,8 @@
 	(___thread_t_callee_saved_OFFSET + ___callee_saved_t_s11_OFFSET)
 
 #define _thread_offset_to_swap_return_value \
-	(___thread_t_arch_OFFSET + ___thread_arch_t_swap_return_value_OFFSET)
+	(___thread_t_arch_hot_OFFSET + \
+	 ___thread_arch_hot_t_swap_return_value_OFFSET)
 
 /* end - threads */
 
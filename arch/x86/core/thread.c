@@ -145,19 +145,50 @@ void _new_thread(struct k_thread *thread, k_thread_stack_t stack,
 }
 
 #ifdef CONFIG_X86_USERSPACE
+/*
+ * Thread stack userspace can access. The range is recorded rather than the
+ * thread, since the thread object may be reused for another stack.
+ */
+static u32_t user_stack_start;
+static u32_t user_stack_size;
+
+/*
+ * Give userspace access to the stack of a thread, and take it away from the
+ * stack that had it. Supervisor threads run on whatever stack userspace can
+ * access, so the page tables are only rewritten when switching to a user
+ * thread running on another stack than the last one.
+ */
+static void user_stack_update(struct k_thread *thread)
+{
+	u32_t start = thread->stack_info.start;
+	u32_t size = ROUND_UP(thread->stack_info.size, MMU_PAGE_SIZE);
+
+	if (start == user_stack_start && size == user_stack_size) {
+		return;
+	}
+
+	/* Previous stack no longer accessible */
+	if (user_stack_size) {
+		_x86_mmu_set_flags((void *)user_stack_start, user_stack_size,
+				   MMU_ENTRY_SUPERVISOR, MMU_PTE_US_MASK);
+	}
+
+	/* Userspace can now access the thread's stack */
+	_x86_mmu_set_flags((void *)start, size, MMU_ENTRY_USER,
+			   MMU_PTE_US_MASK);
+
+	user_stack_start = start;
+	user_stack_size = size;
+}
+
 void _x86_swap_update_page_tables(struct k_thread *incoming,
 				  struct k_thread *outgoing)
 {
-	/* Outgoing thread stack no longer accessible */
-	_x86_mmu_set_flags((void *)outgoing->stack_info.start,
-			   ROUND_UP(outgoing->stack_info.size, MMU_PAGE_SIZE),
-			   MMU_ENTRY_SUPERVISOR, MMU_PTE_US_MASK);
+	ARG_UNUSED(outgoing);
 
-
-	/* Userspace can now access the incoming thread's stack */
-	_x86_mmu_set_flags((void *)incoming->stack_info.start,
-			   ROUND_UP(incoming->stack_info.size, MMU_PAGE_SIZE),
-			   MMU_ENTRY_USER, MMU_PTE_US_MASK);
+	if (incoming->base.user_options & K_USER) {
+		user_stack_update(incoming);
+	}
 
 	/* In case of privilege elevation, use the incoming thread's kernel
 	 * stack, the top of the thread stack is the bottom of the kernel stack
@@ -174,6 +205,7 @@ FUNC_NORETURN void _arch_user_mode_enter(k_thread_entry_t user_entry,
 					 void *p1, void *p2, void *p3)
 {
 	u32_t stack_end;
+	unsigned int key;
 
 	/* Transition will reset stack pointer to initial, discarding
 	 * any old context since this is a one-way operation
@@ -181,6 +213,13 @@ FUNC_NORETURN void _arch_user_mode_enter(k_thread_entry_t user_entry,
 	stack_end = STACK_ROUND_DOWN(_current->stack_info.start +
 				     _current->stack_info.size);
 
+	/* A supervisor thread dropping to user mode may not have had access
+	 * to its stack
+	 */
+	key = irq_lock();
+	user_stack_update(_current);
+	irq_unlock(key);
+
 	/* Set up the kernel stack used during privilege elevation */
 	_x86_mmu_set_flags((void *)(_current->stack_info.start - MMU_PAGE_SIZE),
 			   MMU_PAGE_SIZE,
@@ -11,6 +11,7 @@
  * This file contains defintions for
  *
  *  struct _thread_arch
+ *  struct _thread_arch_hot
  *  struct _callee_saved
  *  struct _caller_saved
  *
@@ -232,6 +233,13 @@ typedef struct s_preempFloatReg {
 	} floatRegsUnion;
 } tPreempFloatReg;
 
+/* fields every context switch uses, kept with the saved registers */
+struct _thread_arch_hot {
+	/* nothing for now */
+};
+
+typedef struct _thread_arch_hot _thread_arch_hot_t;
+
 /*
  * The thread control stucture definition.  It contains the
  * various fields to manage a _single_ thread. The TCS will be aligned
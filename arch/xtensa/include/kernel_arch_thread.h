@@ -11,6 +11,7 @@
  * This file contains defintions for
  *
  *  struct _thread_arch
+ *  struct _thread_arch_hot
  *  struct _callee_saved
  *  struct _caller_saved
  *
@@ -95,6 +96,13 @@ typedef struct s_preempCoprocReg {
 #endif
 } tPreempCoprocReg;
 
+/* fields every context switch uses, kept with the saved registers */
+struct _thread_arch_hot {
+	/* nothing for now */
+};
+
+typedef struct _thread_arch_hot _thread_arch_hot_t;
+
 /*
  * The thread control stucture definition.  It contains the
  * various fields to manage a _single_ thread.
@@ -69,6 +69,28 @@ static u32_t idle_original_count;
 #ifdef CONFIG_TICKLESS_KERNEL
 static u32_t timer_overflow;
 #endif
+#ifdef CONFIG_HRTIMER
+/*
+ * The counter is shared by the ticks the timer is programmed for and the
+ * high-resolution timers: a program is split in segments, each ending either
+ * with the program or when a high-resolution timer is due.
+ */
+
+/* cycles of the current program, 0 once it is over and nothing reloaded */
+static u32_t program_cycles;
+/* cycles of the current program elapsed in its previous segments */
+static u32_t segment_start;
+/* cycles elapsed since the last whole tick when the program started */
+static u32_t cycle_remainder;
+/* get_elapsed_count() value requested by _timer_hr_program() */
+static u64_t hr_deadline;
+static int hr_armed;
+
+/* shortest segment, so that the counter does not expire while reloaded */
+#define HR_MIN_CYCLES 64
+
+static inline u64_t get_elapsed_count(void);
+#endif
 static u32_t __noinit max_system_ticks;
 static u32_t idle_original_ticks;
 static u32_t __noinit max_load_value;
@@ -200,6 +222,118 @@ static ALWAYS_INLINE void sysTickReloadSet(
 	SysTick->VAL = 0; /* also clears the countflag */
 }
 
+#ifdef CONFIG_TICKLESS_KERNEL
+#ifdef CONFIG_HRTIMER
+/* get_elapsed_count() value when the current segment started */
+static u64_t segment_base(void)
+{
+	return _sys_clock_tick_count * default_load_value + cycle_remainder +
+	       segment_start;
+}
+
+/* length of the next segment of the current program */
+static u32_t segment_length(void)
+{
+	u32_t left = program_cycles - segment_start;
+	s64_t hr_left;
+
+	if (!hr_armed) {
+		return left;
+	}
+
+	hr_left = hr_deadline - segment_base();
+	if (hr_left < HR_MIN_CYCLES) {
+		hr_left = HR_MIN_CYCLES;
+	}
+
+	return hr_left < left ? (u32_t)hr_left : left;
+}
+
+/*
+ * Runs the high-resolution timers if their time has come, at the end of
+ * each segment: returns 1 if the program goes on, its next segment started.
+ */
+static int hr_interrupt(void)
+{
+	u32_t segment = SysTick->LOAD;
+	int more = program_cycles && segment_start + segment < program_cycles;
+	int due = hr_armed && hr_deadline <= segment_base() + segment;
+
+	if (due) {
+		hr_armed = 0;
+	}
+
+	if (more) {
+		sysTickStop();
+		segment_start += segment;
+		timer_overflow = 0;
+		sysTickReloadSet(segment_length());
+		sysTickStart();
+	}
+
+	if (due) {
+		_hrtimer_announce();
+	}
+
+	return more;
+}
+
+#define clock_needed() (_sys_clock_always_on || hr_armed)
+#else
+#define clock_needed() (_sys_clock_always_on)
+#endif /* CONFIG_HRTIMER */
+
+/*
+ * Account for the time elapsed so far, before the counter is reloaded for a
+ * new program. With high-resolution timers, the cycles elapsed since the
+ * last whole tick are kept as well, so that the cycle count never goes back.
+ */
+static void rebase_clock(void)
+{
+#ifdef CONFIG_HRTIMER
+	u64_t elapsed = get_elapsed_count();
+
+	_sys_clock_tick_count = elapsed / default_load_value;
+	cycle_remainder = elapsed % default_load_value;
+	segment_start = 0;
+#else
+	_sys_clock_tick_count = _get_elapsed_clock_time();
+#endif
+	/* clear overflow tracking flag as it is accounted */
+	timer_overflow = 0;
+}
+
+/* load the counter for a new program of that many cycles */
+static void program_load(u32_t cycles)
+{
+#ifdef CONFIG_HRTIMER
+	program_cycles = cycles;
+	sysTickReloadSet(segment_length());
+#else
+	sysTickReloadSet(cycles);
+#endif
+}
+
+/* the program is over and the counter is not reloaded */
+static inline void program_over(void)
+{
+#ifdef CONFIG_HRTIMER
+	program_cycles = 0;
+#endif
+}
+
+/* cycles left before the end of the current program */
+static inline u32_t program_cycles_left(void)
+{
+#ifdef CONFIG_HRTIMER
+	return program_cycles - segment_start - SysTick->LOAD +
+	       sysTickCurrentGet();
+#else
+	return sysTickCurrentGet();
+#endif
+}
+#endif /* CONFIG_TICKLESS_KERNEL */
+
 /**
  *
  * @brief System clock tick handler
@@ -243,16 +377,25 @@ void _timer_int_handler(void *unused)
 
 #ifdef CONFIG_TICKLESS_IDLE
 #if defined(CONFIG_TICKLESS_KERNEL)
+#ifdef CONFIG_HRTIMER
+	if (hr_interrupt()) {
+		__asm__(" cpsie i"); /* re-enable interrupts (PRIMASK = 0) */
+
+		_ExcExit();
+		return;
+	}
+#endif
+
 	if (!idle_original_ticks) {
-		if (_sys_clock_always_on) {
-			_sys_clock_tick_count = _get_elapsed_clock_time();
-			/* clear overflow tracking flag as it is accounted */
-			timer_overflow = 0;
+		if (clock_needed()) {
+			rebase_clock();
 			sysTickStop();
 			idle_original_ticks = max_system_ticks;
-			sysTickReloadSet(max_load_value);
+			program_load(max_load_value);
 			sysTickStart();
 			sys_tick_reload();
+		} else {
+			program_over();
 		}
 		__asm__(" cpsie i"); /* re-enable interrupts (PRIMASK = 0) */
 
@@ -274,14 +417,14 @@ void _timer_int_handler(void *unused)
 	_sys_clock_tick_announce();
 
 	/* _sys_clock_tick_announce() could cause new programming */
-	if (!idle_original_ticks && _sys_clock_always_on) {
-		_sys_clock_tick_count = _get_elapsed_clock_time();
-		/* clear overflow tracking flag as it is accounted */
-		timer_overflow = 0;
+	if (!idle_original_ticks && clock_needed()) {
+		rebase_clock();
 		sysTickStop();
-		sysTickReloadSet(max_load_value);
+		program_load(max_load_value);
 		sysTickStart();
 		sys_tick_reload();
+	} else if (!idle_original_ticks) {
+		program_over();
 	}
 #else
 	/*
@@ -370,7 +513,7 @@ u32_t _get_remaining_program_time(void)
 		return 0;
 	}
 
-	return (u32_t)ceiling_fraction((u32_t)sysTickCurrentGet(),
+	return (u32_t)ceiling_fraction(program_cycles_left(),
 						default_load_value);
 }
 
@@ -380,7 +523,8 @@ u32_t _get_elapsed_program_time(void)
 		return 0;
 	}
 
-	return idle_original_ticks - (sysTickCurrentGet() / default_load_value);
+	return idle_original_ticks -
+	       (program_cycles_left() / default_load_value);
 }
 
 void _set_time(u32_t time)
@@ -392,12 +536,9 @@ void _set_time(u32_t time)
 
 	idle_original_ticks = time > max_system_ticks ? max_system_ticks : time;
 
-	_sys_clock_tick_count = _get_elapsed_clock_time();
-
-	/* clear overflow tracking flag as it is accounted */
-	timer_overflow = 0;
+	rebase_clock();
 	sysTickStop();
-	sysTickReloadSet(idle_original_ticks * default_load_value);
+	program_load(idle_original_ticks * default_load_value);
 
 	sysTickStart();
 	sys_tick_reload();
@@ -425,7 +566,11 @@ static inline u64_t get_elapsed_count(void)
 		elapsed = (SysTick->LOAD - SysTick->VAL);
 	}
 
+#ifdef CONFIG_HRTIMER
+	elapsed += segment_base();
+#else
 	elapsed += (_sys_clock_tick_count * default_load_value);
+#endif
 
 	return elapsed;
 }
@@ -434,6 +579,37 @@ u64_t _get_elapsed_clock_time(void)
 {
 	return get_elapsed_count() / default_load_value;
 }
+
+#ifdef CONFIG_HRTIMER
+void _timer_hr_program(u32_t cycles)
+{
+	hr_deadline = get_elapsed_count() + cycles;
+	hr_armed = 1;
+
+	if (!program_cycles) {
+		/* the counter is stopped or stale: keep time until then */
+		rebase_clock();
+		sysTickStop();
+		program_load(max_load_value);
+		sysTickStart();
+		sys_tick_reload();
+		return;
+	}
+
+	if (timer_overflow) {
+		/* the segment is over: the interrupt handler programs it */
+		return;
+	}
+
+	if (cycles + HR_MIN_CYCLES < sysTickCurrentGet()) {
+		/* due before the end of the segment: cut it short */
+		sysTickStop();
+		segment_start += SysTick->LOAD - SysTick->VAL;
+		sysTickReloadSet(segment_length());
+		sysTickStart();
+	}
+}
+#endif /* CONFIG_HRTIMER */
 #endif
 
 #ifdef CONFIG_TICKLESS_IDLE
@@ -541,8 +717,16 @@ void _timer_idle_enter(s32_t ticks /* system ticks */
 			_set_time(ticks);
 		}
 	} else {
-		sysTickStop();
 		idle_original_ticks = 0;
+#ifdef CONFIG_HRTIMER
+		/* keep counting for the high-resolution timers */
+		if (!hr_armed) {
+			sysTickStop();
+			program_over();
+		}
+#else
+		sysTickStop();
+#endif
 	}
 	idle_mode = IDLE_TICKLESS;
 #else
@@ -606,10 +790,9 @@ void _timer_idle_exit(void)
 #ifdef CONFIG_TICKLESS_KERNEL
 	if (idle_mode == IDLE_TICKLESS) {
 		idle_mode = IDLE_NOT_TICKLESS;
-		if (!idle_original_ticks && _sys_clock_always_on) {
-			_sys_clock_tick_count = _get_elapsed_clock_time();
-			timer_overflow = 0;
-			sysTickReloadSet(max_load_value);
+		if (!idle_original_ticks && clock_needed()) {
+			rebase_clock();
+			program_load(max_load_value);
 			sysTickStart();
 			sys_tick_reload();
 		}
@@ -48,6 +48,7 @@
 #include <drivers/ioapic.h>
 #include <drivers/system_timer.h>
 #include <kernel_structs.h>
+#include <debug/int_latency.h>
 
 #include <board.h>
 
@@ -215,12 +216,92 @@ static u64_t _hpetMainCounterAtomic(void)
 #endif /* CONFIG_TICKLESS_IDLE */
 
 #ifdef CONFIG_TICKLESS_KERNEL
+#ifdef CONFIG_HRTIMER
+/*
+ * The comparator is shared by the ticks the timer is programmed for and the
+ * high-resolution timers: it is loaded with the earliest of both.
+ */
+
+/* comparator value for the programmed ticks */
+static u64_t tick_comparator;
+/* comparator value requested by _timer_hr_program(), if hr_armed */
+static u64_t hr_comparator;
+static int hr_armed;
+
+static void program_comparator(void)
+{
+	u64_t comparator = ~(u64_t)0;
+
+	if (programmed_ticks || _sys_clock_always_on) {
+		comparator = tick_comparator;
+	}
+
+	if (hr_armed && hr_comparator < comparator) {
+		comparator = hr_comparator;
+	}
+
+	*_HPET_TIMER0_CONFIG_CAPS |= HPET_Tn_VAL_SET_CNF;
+	*_HPET_TIMER0_COMPARATOR = comparator;
+}
+
+/*
+ * Runs the high-resolution timers if their time has come: returns 1 if the
+ * programmed ticks are not due yet, the interrupt being for them only.
+ */
+static int hr_interrupt(void)
+{
+	if (hr_armed && _hpetMainCounterAtomic() >= hr_comparator) {
+		hr_armed = 0;
+		_hrtimer_announce();
+	}
+
+	if (programmed_ticks &&
+	    _hpetMainCounterAtomic() + HPET_COMP_DELAY < tick_comparator) {
+		program_comparator();
+		return 1;
+	}
+
+	return 0;
+}
+
+void _timer_hr_program(u32_t cycles)
+{
+	if (cycles < HPET_COMP_DELAY) {
+		cycles = HPET_COMP_DELAY;
+	}
+
+	hr_comparator = _hpetMainCounterAtomic() + cycles;
+	hr_armed = 1;
+
+	program_comparator();
+}
+#endif /* CONFIG_HRTIMER */
+
+static inline u64_t get_tick_comparator(void)
+{
+#ifdef CONFIG_HRTIMER
+	return tick_comparator;
+#else
+	return *_HPET_TIMER0_COMPARATOR;
+#endif
+}
+
+static inline void set_tick_comparator(u64_t value)
+{
+#ifdef CONFIG_HRTIMER
+	tick_comparator = value;
+	program_comparator();
+#else
+	*_HPET_TIMER0_CONFIG_CAPS |= HPET_Tn_VAL_SET_CNF;
+	*_HPET_TIMER0_COMPARATOR = value;
+#endif
+}
+
 static inline void program_max_cycles(void)
 {
 	stale_irq_check = 1;
-	*_HPET_TIMER0_CONFIG_CAPS |= HPET_Tn_VAL_SET_CNF;
-	counter_last_value = *_HPET_TIMER0_COMPARATOR;
-	*_HPET_TIMER0_COMPARATOR = counter_last_value - 1;
+	counter_last_value = get_tick_comparator();
+	set_tick_comparator(counter_last_value - 1);
 }
 #endif
 
@@ -249,6 +330,10 @@ void _timer_int_handler(void *unused)
 		/* keep the lowest value observed */
 		_hw_irq_to_c_handler_latency = delta;
 	}
+	if (delta < main_count_first_irq_value) {
+		/* else ticks were skipped, and the expected value is stale */
+		int_latency_record(INT_LATENCY_ISR_ENTRY, delta);
+	}
 	/* compute the next expected main counter value */
 	main_count_expected_value += main_count_first_irq_value;
 #endif
@@ -268,6 +353,12 @@ void _timer_int_handler(void *unused)
 	/* see if interrupt was triggered while timer was being reprogrammed */
 
 #if defined(CONFIG_TICKLESS_KERNEL)
+#ifdef CONFIG_HRTIMER
+	if (hr_interrupt()) {
+		return;
+	}
+#endif
+
 	/* If timer not programmed or already consumed exit */
 	if (!programmed_ticks) {
 		if (_sys_clock_always_on) {
@@ -303,6 +394,11 @@ void _timer_int_handler(void *unused)
 		_sys_clock_tick_count = _get_elapsed_clock_time();
 		program_max_cycles();
 	}
+
+#ifdef CONFIG_HRTIMER
+	/* the comparator is still loaded with the ticks that just expired */
+	program_comparator();
+#endif
 #else
 	counter_last_value = *_HPET_TIMER0_COMPARATOR;
 	*_HPET_TIMER0_CONFIG_CAPS |= HPET_Tn_VAL_SET_CNF;
@@ -327,7 +423,7 @@ u32_t _get_remaining_program_time(void)
 	}
 
 	return (u32_t) ((s64_t)
-			  (*_HPET_TIMER0_COMPARATOR -
+			  (get_tick_comparator() -
 			   _hpetMainCounterAtomic()) / counter_load_value);
 }
 
@@ -338,7 +434,7 @@ u32_t _get_elapsed_program_time(void)
 	}
 
 	return (u32_t) (programmed_ticks -
-		       ((s64_t)(*_HPET_TIMER0_COMPARATOR -
+		       ((s64_t)(get_tick_comparator() -
 			 _hpetMainCounterAtomic()) / counter_load_value));
 }
 
@@ -357,10 +453,8 @@ void _set_time(u32_t time)
 
 	stale_irq_check = 1;
 
-	*_HPET_TIMER0_CONFIG_CAPS |= HPET_Tn_VAL_SET_CNF;
 	counter_last_value = _hpetMainCounterAtomic();
-	*_HPET_TIMER0_COMPARATOR =
-	    counter_last_value + time * counter_load_value;
+	set_tick_comparator(counter_last_value + time * counter_load_value);
 }
 
 void _enable_sys_clock(void)
@@ -419,8 +513,13 @@ void _timer_idle_enter(s32_t ticks /* system ticks */
 		}
 	} else {
 		programmed_ticks = 0;
-		counter_last_value = *_HPET_TIMER0_COMPARATOR;
+		counter_last_value = get_tick_comparator();
+#ifdef CONFIG_HRTIMER
+		/* keep counting for the high-resolution timers */
+		set_tick_comparator(counter_last_value - 1);
+#else
 		*_HPET_GENERAL_CONFIG &= ~HPET_ENABLE_CNF;
+#endif
 	}
 #else
 	/*
@@ -653,6 +752,9 @@ int _sys_clock_driver_init(struct device *device)
 	 */
 	*_HPET_TIMER0_CONFIG_CAPS |= HPET_Tn_VAL_SET_CNF;
 	*_HPET_TIMER0_COMPARATOR = counter_load_value;
+#ifdef CONFIG_HRTIMER
+	tick_comparator = counter_load_value;
+#endif
 	/*
 	 * After the comparator is loaded, 32-bit mode can be safely
 	 * switched off
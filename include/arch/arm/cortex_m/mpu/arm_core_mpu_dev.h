@@ -62,6 +62,8 @@ void arm_core_mpu_configure(u8_t type, u32_t base, u32_t size);
 /**
  * @brief configure MPU regions for the memory partitions of the memory domain
  *
+ * Only the regions that differ from the previous call are written.
+ *
  * @param   mem_domain    memory domain that thread belongs to
  */
 void arm_core_mpu_configure_mem_domain(struct k_mem_domain *mem_domain);
@@ -69,6 +71,9 @@ void arm_core_mpu_configure_mem_domain(struct k_mem_domain *mem_domain);
 /**
  * @brief configure MPU region for a single memory partition
  *
+ * The context switch code does not notice the change, and leaves the region
+ * as set until it switches to a thread of another memory domain.
+ *
  * @param   part_index  memory partition index
  * @param   part        memory partition info
  */
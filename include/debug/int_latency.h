@@ -0,0 +1,128 @@
+/*
+ * Copyright (c) 2017 Intel Corporation
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+/**
+ * @file
+ * @brief Interrupt latency benchmark APIs.
+ *
+ * The interrupt latency benchmark records, in hardware clock cycles, how
+ * long interrupts stay locked, how long the hardware takes to enter an
+ * interrupt handler, and how long a thread woken by an interrupt handler
+ * waits to run. Each is kept in a histogram with logarithmic buckets, four
+ * per power of two, from which percentiles are estimated to within 25%.
+ * The code sections that kept interrupts locked the longest are also
+ * attributed to their call sites.
+ */
+
+#ifndef _INT_LATENCY_H_
+#define _INT_LATENCY_H_
+
+#ifdef CONFIG_INT_LATENCY_BENCHMARK
+
+#include <zephyr/types.h>
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/** Latencies tracked by the interrupt latency benchmark */
+enum int_latency_type {
+	/** time spent with interrupts locked */
+	INT_LATENCY_IRQ_LOCKED,
+	/** time from a hardware interrupt up to its handler */
+	INT_LATENCY_ISR_ENTRY,
+	/** time from an interrupt handler waking a thread up to it running */
+	INT_LATENCY_ISR_TO_THREAD,
+
+	INT_LATENCY_TYPES
+};
+
+/** Latency distribution, in hardware clock cycles */
+struct int_latency_stats {
+	u32_t count;
+	u32_t min;
+	u32_t max;
+	/* upper bounds of the histogram buckets holding the percentiles */
+	u32_t p50;
+	u32_t p99;
+	u32_t p999;
+};
+
+/** Code section that kept interrupts locked */
+struct int_latency_site {
+	/* where interrupts were locked */
+	void *site;
+	/* longest time interrupts were kept locked from there */
+	u32_t cycles;
+};
+
+/**
+ * @brief Initialize the interrupt latency benchmark.
+ *
+ * Measures the overhead of the benchmark itself and starts tracking
+ * latencies.
+ *
+ * @return N/A
+ */
+extern void int_latency_init(void);
+
+/**
+ * @brief Print the interrupt latencies, and start a new sampling interval.
+ *
+ * @return N/A
+ */
+extern void int_latency_show(void);
+
+/**
+ * @brief Record a latency.
+ *
+ * This routine lets drivers and applications record latencies the kernel
+ * cannot measure itself, e.g. the entry latency of an interrupt whose time
+ * of occurrence is known to its handler.
+ *
+ * @param type Type of the latency.
+ * @param cycles Latency, in hardware clock cycles.
+ *
+ * @return N/A
+ */
+extern void int_latency_record(enum int_latency_type type, u32_t cycles);
+
+/**
+ * @brief Get the distribution of a latency.
+ *
+ * @param type Type of the latency.
+ * @param stats Distribution, filled by this routine.
+ *
+ * @return N/A
+ */
+extern void int_latency_stats_get(enum int_latency_type type,
+				  struct int_latency_stats *stats);
+
+/**
+ * @brief Get the code sections that kept interrupts locked the longest.
+ *
+ * @param sites Array of at least @a max elements, filled by this routine
+ *              from the longest to the shortest section.
+ * @param max Number of elements of @a sites.
+ *
+ * @return Number of elements filled.
+ */
+extern int int_latency_sites_get(struct int_latency_site *sites, int max);
+
+/**
+ * @brief Forget all recorded latencies.
+ *
+ * @return N/A
+ */
+extern void int_latency_reset(void);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* CONFIG_INT_LATENCY_BENCHMARK */
+
+#endif /* _INT_LATENCY_H_ */
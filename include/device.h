@@ -207,6 +207,61 @@ static const int _INIT_LEVEL_APPLICATION = 1;
   */
 #define DEVICE_DECLARE(name) static struct device DEVICE_NAME_GET(name)
 
+#ifdef CONFIG_DEVICE_INIT_PARALLEL
+/**
+ * @brief Parallel initialization of a device
+ * @param dev device to initialize
+ * @param deps devices whose initialization must complete first
+ * @param num_deps number of devices in @a deps
+ * @param done given once the device is initialized
+ */
+struct device_init_parallel {
+	void *_reserved; /* for the queue of the initialization threads */
+	struct device *dev;
+	struct device * const *deps;
+	u32_t num_deps;
+	struct k_sem done;
+};
+
+/**
+ * @def DEVICE_INIT_PARALLEL
+ *
+ * @brief Let a device be initialized concurrently with other devices
+ *
+ * @details With CONFIG_DEVICE_INIT_PARALLEL enabled, the initialization
+ * function of a device created by DEVICE_INIT() and marked with this macro
+ * is run by a helper thread, while the kernel goes on with initializing the
+ * next devices; it is run as usual otherwise. It must therefore not rely on
+ * other devices of its level with a higher priority, and the devices of its
+ * level must not use it, unless they are marked too and list it as a
+ * dependency. A marked device of the PRE_KERNEL_1 or PRE_KERNEL_2 level is
+ * only initialized once the kernel is running, with the devices of the
+ * POST_KERNEL level, and must not be used before.
+ *
+ * @param dev_name The same as dev_name provided to DEVICE_INIT()
+ * @param ... Pointers to marked devices whose initialization must complete
+ * before this one starts, e.g. DEVICE_GET(phy0); they must precede it in
+ * initialization order.
+ */
+#define DEVICE_INIT_PARALLEL(dev_name, ...) \
+	static struct device * const \
+	_CONCAT(__device_init_deps_, dev_name)[] = { NULL, ##__VA_ARGS__ }; \
+	static struct device_init_parallel \
+	_CONCAT(__device_init_parallel_, dev_name) __used \
+	__attribute__((__section__(".device_init_parallel." #dev_name))) = { \
+		.dev = DEVICE_GET(dev_name), \
+		.deps = &_CONCAT(__device_init_deps_, dev_name)[1], \
+		.num_deps = ARRAY_SIZE(_CONCAT(__device_init_deps_, dev_name)) \
+			    - 1, \
+		.done = _K_SEM_INITIALIZER( \
+			_CONCAT(__device_init_parallel_, dev_name).done, \
+			0, UINT_MAX), \
+	}
+#else
+#define DEVICE_INIT_PARALLEL(dev_name, ...) \
+	BUILD_ASSERT(sizeof(DEVICE_NAME_GET(dev_name)) != 0)
+#endif
+
 struct device;
 
 #ifdef CONFIG_DEVICE_POWER_MANAGEMENT
@@ -309,6 +364,40 @@ void _sys_device_do_config_level(int level);
  */
 struct device *device_get_binding(const char *name);
 
+#ifdef CONFIG_DEVICE_INIT_PROFILING
+/**
+ * @brief Profile of a device or system initialization function
+ * @param dev device initialized
+ * @param start cycle count when the initialization function was called
+ * @param end cycle count when it returned
+ * @param level initialization level of the device
+ * @param parallel run by a parallel initialization thread
+ */
+struct device_init_record {
+	struct device *dev;
+	u32_t start;
+	u32_t end;
+	u8_t level;
+	u8_t parallel;
+};
+
+/**
+ * @brief Retrieve the profile of the initialization functions run so far
+ *
+ * @param records set to the records, in the order the initialization
+ * functions returned
+ *
+ * @return number of initialization functions run, which may exceed the
+ * number of records, CONFIG_DEVICE_INIT_PROFILING_RECORDS
+ */
+int device_init_profile_get(const struct device_init_record **records);
+
+/**
+ * @brief Print the profile of the initialization functions run so far
+ */
+void device_init_profile_show(void);
+#endif
+
 /**
  * @brief Device Power Management APIs
  * @defgroup device_power_management_api Device Power Management APIs
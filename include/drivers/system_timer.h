@@ -52,6 +52,23 @@ extern u32_t _get_elapsed_program_time(void);
 extern u64_t _get_elapsed_clock_time(void);
 #endif
 
+#ifdef CONFIG_HRTIMER
+/*
+ * Implemented by the driver: make the system clock interrupt fire no later
+ * than 'cycles' from now, in addition to the ticks it is programmed for,
+ * replacing any previous request. Called with interrupts locked.
+ */
+extern void _timer_hr_program(u32_t cycles);
+
+/*
+ * Implemented by the kernel: called by the driver's interrupt handler once
+ * the time requested by _timer_hr_program() has come, the request having
+ * been forgotten. Runs the expired high-resolution timers and programs the
+ * next one.
+ */
+extern void _hrtimer_announce(void);
+#endif
+
 extern int sys_clock_device_ctrl(struct device *device,
 				 u32_t ctrl_command, void *context);
 
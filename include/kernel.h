@@ -98,6 +98,42 @@ typedef sys_dlist_t _wait_q_t;
 #define _OBJECT_TRACING_NEXT_PTR(type)
 #endif
 
+#ifdef CONFIG_CONTENTION_STATS
+/**
+ * @brief Thread among those that waited the longest on an object
+ */
+struct k_contention_waiter {
+	struct k_thread *thread;
+	/* number of times the thread waited */
+	u32_t waits;
+	/* total time the thread waited, in cycles */
+	u64_t wait_cycles;
+};
+
+/**
+ * @brief Contention statistics of a mutex or semaphore
+ */
+struct k_contention_stats {
+	/* number of successful takes */
+	u32_t acquisitions;
+	/* takes that had to wait, successful or not */
+	u32_t contended;
+	/* takes that returned without the object */
+	u32_t failures;
+	/* total and longest time spent waiting, in cycles */
+	u64_t wait_cycles;
+	u32_t max_wait_cycles;
+	/* times the owner priority was raised by priority inheritance */
+	u32_t prio_boosts;
+	/* threads with the longest total wait, longest first when read */
+	struct k_contention_waiter top_waiters[CONFIG_CONTENTION_TOP_WAITERS];
+};
+
+#define _CONTENTION_STATS struct k_contention_stats contention
+#else
+#define _CONTENTION_STATS
+#endif
+
 #ifdef CONFIG_POLL
 #define _POLL_EVENT_OBJ_INIT(obj) \
 	.poll_events = SYS_DLIST_STATIC_INIT(&obj.poll_events),
@@ -262,6 +298,10 @@ struct _timeout {
 	sys_dlist_t *wait_q;
 	s32_t delta_ticks_from_prev;
 	_timeout_func_t func;
+#ifdef CONFIG_TIMEOUT_QUEUE_WHEEL
+	/* absolute expiry, in timer wheel ticks */
+	u32_t expiry;
+#endif
 };
 
 extern s32_t _timeout_remaining_get(struct _timeout *timeout);
@@ -295,7 +335,13 @@ struct __thread_entry {
 };
 #endif
 
-/* can be used for creating 'dummy' threads, e.g. for pending on objects */
+/*
+ * Can be used for creating 'dummy' threads, e.g. for pending on objects:
+ * it must hold everything the ready and wait queues use.
+ *
+ * The fields context switches use come first, the timeout, only used when
+ * pending with a timeout, comes last.
+ */
 struct _thread_base {
 
 	/* this thread's entry in a ready/wait queue */
@@ -337,15 +383,15 @@ struct _thread_base {
 	/* data returned by APIs */
 	void *swap_data;
 
+#ifdef CONFIG_SCHED_DEADLINE
+	/* absolute deadline, in hardware cycles, for EDF among equal prios */
+	int prio_deadline;
+#endif
+
 #ifdef CONFIG_SYS_CLOCK_EXISTS
 	/* this thread's entry in a timeout queue */
 	struct _timeout timeout;
 #endif
-
-#ifdef CONFIG_USERSPACE
-	/* Bit position in kernel object permissions bitfield for this thread */
-	unsigned int perm_index;
-#endif
 };
 
 typedef struct _thread_base _thread_base_t;
@@ -362,6 +408,22 @@ struct _thread_stack_info {
 typedef struct _thread_stack_info _thread_stack_info_t;
 #endif /* CONFIG_THREAD_STACK_INFO */
 
+#if defined(CONFIG_THREAD_RUNTIME_STATS)
+/* CPU time accounting, updated on each context switch */
+struct _thread_runtime {
+	/* cycles spent running, up to the last time it was switched out */
+	u64_t running_cycles;
+	/* cycles spent ready but not running, up to the last time it ran */
+	u64_t ready_cycles;
+	/* number of times it was switched in */
+	u32_t switches;
+	/* cycle count when it was last switched in */
+	u32_t run_stamp;
+	/* cycle count when it last became ready without running */
+	u32_t ready_stamp;
+};
+#endif /* CONFIG_THREAD_RUNTIME_STATS */
+
 #if defined(CONFIG_USERSPACE)
 struct _mem_domain_info {
 	/* memory domain queue node */
@@ -370,16 +432,55 @@ struct _mem_domain_info {
 	struct k_mem_domain *mem_domain;
 };
 
+#if CONFIG_OBJECT_CACHE_ENTRIES > 0
+struct _k_object_cache {
+	/* kernel objects this thread recently passed to system calls */
+	void *obj[CONFIG_OBJECT_CACHE_ENTRIES];
+	/* and their entries in the kernel object table */
+	struct _k_object *ko[CONFIG_OBJECT_CACHE_ENTRIES];
+	/* next entry to replace */
+	unsigned int next;
+};
+#endif
+
 #endif /* CONFIG_USERSPACE */
 
+#if defined(CONFIG_THREAD_HOT_ALIGN) && (CONFIG_THREAD_HOT_ALIGN > 0)
+#define _THREAD_HOT_ALIGN __aligned(CONFIG_THREAD_HOT_ALIGN)
+#else
+#define _THREAD_HOT_ALIGN
+#endif
+
+/*
+ * The fields used by every context switch come first, and the structure is
+ * aligned on CONFIG_THREAD_HOT_ALIGN, so they share as few cache lines as
+ * possible. The fields used outside of context switches follow.
+ */
 struct k_thread {
 
+	/* hot: scheduling state, saved registers and switch bookkeeping */
+
 	struct _thread_base base;
 
 	/* defined by the architecture, but all archs need these */
 	struct _caller_saved caller_saved;
 	struct _callee_saved callee_saved;
 
+	/* defined by the architecture, may be empty */
+	struct _thread_arch_hot arch_hot;
+
+#if defined(CONFIG_USERSPACE)
+	/* memory domain info of the thread, compared on each switch */
+	struct _mem_domain_info mem_domain_info;
+#endif /* CONFIG_USERSPACE */
+
+#if defined(CONFIG_THREAD_RUNTIME_STATS)
+	/* CPU time accounting */
+	struct _thread_runtime runtime;
+#endif /* CONFIG_THREAD_RUNTIME_STATS */
+
+	/* cold: creation, debugging and userspace permissions */
+
 	/* static thread init data */
 	void *init_data;
 
@@ -410,13 +511,18 @@ struct k_thread {
 #endif /* CONFIG_THREAD_STACK_INFO */
 
 #if defined(CONFIG_USERSPACE)
-	/* memory domain info of the thread */
-	struct _mem_domain_info mem_domain_info;
+	/* Bit position in kernel object permissions bitfield for this thread */
+	unsigned int perm_index;
+
+#if CONFIG_OBJECT_CACHE_ENTRIES > 0
+	/* kernel object validation cache */
+	struct _k_object_cache obj_cache;
+#endif
 #endif /* CONFIG_USERSPACE */
 
 	/* arch-specifics: must always be at the end */
 	struct _thread_arch arch;
-};
+} _THREAD_HOT_ALIGN;
 
 typedef struct k_thread _thread_t;
 typedef struct k_thread *k_tid_t;
@@ -452,6 +558,62 @@ enum execution_context_types {
  */
 extern void k_call_stacks_analyze(void);
 
+#if defined(CONFIG_THREAD_RUNTIME_STATS) || defined(__DOXYGEN__)
+/**
+ * @brief CPU time statistics of a thread.
+ *
+ * All times are in hardware clock cycles, as counted by k_cycle_get_32().
+ * Interrupts are accounted to the thread they interrupted.
+ */
+struct k_thread_runtime_stats {
+	/** Cycles spent running. */
+	u64_t running_cycles;
+	/** Cycles spent ready to run, waiting for the CPU. */
+	u64_t ready_cycles;
+	/** Number of times the thread was switched in. */
+	u32_t switches;
+};
+
+/**
+ * @brief System-wide CPU time statistics.
+ */
+struct k_cpu_runtime_stats {
+	/** Cycles the CPU spent idle, including interrupts serviced then. */
+	u64_t idle_cycles;
+	/** Cycles elapsed since the system started. */
+	u64_t total_cycles;
+};
+
+/**
+ * @brief Get the CPU time statistics of a thread.
+ *
+ * The statistics include the time the thread has been running or ready so
+ * far, even if it has not been switched out since.
+ *
+ * @note Each period of time a thread runs, or waits to run, is measured with
+ * the 32-bit cycle counter: one longer than the counter takes to wrap around
+ * is not accounted for correctly.
+ *
+ * @param thread ID of thread.
+ * @param stats Address of the structure to fill.
+ *
+ * @return N/A
+ */
+extern void k_thread_runtime_stats_get(k_tid_t thread,
+				       struct k_thread_runtime_stats *stats);
+
+/**
+ * @brief Get the system-wide CPU time statistics.
+ *
+ * The time the CPU was busy is the total time minus the idle time.
+ *
+ * @param stats Address of the structure to fill.
+ *
+ * @return N/A
+ */
+extern void k_cpu_runtime_stats_get(struct k_cpu_runtime_stats *stats);
+#endif /* CONFIG_THREAD_RUNTIME_STATS */
+
 /**
  * @} end defgroup profiling_apis
  */
@@ -791,6 +953,42 @@ extern int  k_thread_priority_get(k_tid_t thread);
  */
 extern void k_thread_priority_set(k_tid_t thread, int prio);
 
+#ifdef CONFIG_SCHED_DEADLINE
+/**
+ * @brief Set deadline expiration time for scheduler
+ *
+ * This sets the "deadline" expiration as a time delta from the current time,
+ * in the same units used by k_cycle_get_32(). The scheduler (when deadline
+ * scheduling is enabled) will choose the next expiring thread when selecting
+ * between threads at the same static priority. Threads at different
+ * priorities will be scheduled according to their static priority.
+ *
+ * @note Deadlines that are negative (i.e. in the past) are still seen as
+ * higher priority than others, even if the thread has "finished" its work.
+ * If you don't want it scheduled anymore, you have to reset the deadline
+ * into the future, block/pend the thread, or modify its priority with
+ * k_thread_priority_set().
+ *
+ * @note Despite the API naming, the scheduler makes no guarantees that the
+ * thread WILL be scheduled within that deadline, nor does it take extra
+ * metadata (like e.g. the "runtime" and "period" parameters in Linux
+ * sched_setattr()) that allows the kernel to validate the scheduling for
+ * achievability. Such features could be implemented above this call,
+ * which is simply input to the priority selection logic.
+ *
+ * @note Threads at the same priority that never had their deadline set all
+ * share a deadline of zero, so mixing them with threads that set deadlines
+ * makes their relative order meaningless. Use dedicated priorities for
+ * deadline-scheduled threads.
+ *
+ * @param thread A thread on which to set the deadline
+ * @param deadline A time delta, in cycle units
+ *
+ * @return N/A
+ */
+extern void k_thread_deadline_set(k_tid_t thread, int deadline);
+#endif
+
 /**
  * @brief Suspend a thread.
  *
@@ -1329,6 +1527,156 @@ static inline void *k_timer_user_data_get(struct k_timer *timer)
  * @} end defgroup timer_apis
  */
 
+#if defined(CONFIG_HRTIMER) || defined(__DOXYGEN__)
+
+/**
+ * @cond INTERNAL_HIDDEN
+ */
+
+struct k_hrtimer {
+	sys_dnode_t node;
+
+	/* absolute expiry time, in k_cycle_get_32() cycles */
+	u32_t expiry;
+
+	/* timer period in cycles, 0 for a one-shot timer */
+	u32_t period;
+
+	/* runs in ISR context */
+	void (*expiry_fn)(struct k_hrtimer *);
+
+	/* user-specific data */
+	void *user_data;
+};
+
+/**
+ * INTERNAL_HIDDEN @endcond
+ */
+
+/**
+ * @defgroup hrtimer_apis High-Resolution Timer APIs
+ * @ingroup kernel_apis
+ * @{
+ */
+
+/**
+ * @typedef k_hrtimer_expiry_t
+ * @brief High-resolution timer expiry function type.
+ *
+ * A high-resolution timer's expiry function is executed by the system clock
+ * interrupt handler each time the timer expires.
+ *
+ * @param timer Address of timer.
+ *
+ * @return N/A
+ */
+typedef void (*k_hrtimer_expiry_t)(struct k_hrtimer *timer);
+
+/**
+ * @brief Initialize a high-resolution timer.
+ *
+ * This routine initializes a high-resolution timer, prior to its first use.
+ *
+ * @param timer     Address of timer.
+ * @param expiry_fn Function to invoke each time the timer expires.
+ *
+ * @return N/A
+ */
+extern void k_hrtimer_init(struct k_hrtimer *timer,
+			   k_hrtimer_expiry_t expiry_fn);
+
+/**
+ * @brief Start a high-resolution timer.
+ *
+ * This routine starts a high-resolution timer. Unlike k_timer_start(), the
+ * duration and period are given in hardware clock cycles, the unit of
+ * k_cycle_get_32(), and are not rounded to system clock ticks: the system
+ * clock driver is programmed to interrupt when the timer expires, in
+ * addition to the ticks it announces to the kernel.
+ *
+ * A periodic timer expires every @a period cycles after its first
+ * expiry, without accumulating the latency of its expiry function. If
+ * the timer is so late that it misses some of its periods, they are skipped.
+ *
+ * Attempting to start a timer that is already running is permitted.
+ * The timer's expiry time and period are simply reset to the new values.
+ *
+ * The duration is measured with a 32-bit cycle counter: it must be less
+ * than 2^31 cycles, and the timer expires at the earliest a few cycles after
+ * the call, depending on the system clock driver.
+ *
+ * @note Can be called by ISRs.
+ *
+ * @param timer    Address of timer.
+ * @param duration Cycles before the timer expires for the first time.
+ * @param period   Cycles between expiries after the first one, or 0 for a
+ *                 one-shot timer.
+ *
+ * @return N/A
+ */
+extern void k_hrtimer_start(struct k_hrtimer *timer, u32_t duration,
+			    u32_t period);
+
+/**
+ * @brief Stop a high-resolution timer.
+ *
+ * This routine stops a running high-resolution timer prematurely. It has no
+ * effect on a timer that is not running.
+ *
+ * @note Can be called by ISRs.
+ *
+ * @param timer Address of timer.
+ *
+ * @return N/A
+ */
+extern void k_hrtimer_stop(struct k_hrtimer *timer);
+
+/**
+ * @brief Convert microseconds to hardware clock cycles.
+ *
+ * Helper to compute the duration and period of a high-resolution timer.
+ *
+ * @param us Number of microseconds.
+ *
+ * @return Number of cycles, rounded down.
+ */
+static inline u32_t k_hrtimer_us_to_cycles(u32_t us)
+{
+	return (u32_t)((u64_t)us * sys_clock_hw_cycles_per_sec / USEC_PER_SEC);
+}
+
+/**
+ * @brief Associate user-specific data with a high-resolution timer.
+ *
+ * @param timer     Address of timer.
+ * @param user_data User data to associate with the timer.
+ *
+ * @return N/A
+ */
+static inline void k_hrtimer_user_data_set(struct k_hrtimer *timer,
+					   void *user_data)
+{
+	timer->user_data = user_data;
+}
+
+/**
+ * @brief Retrieve the user-specific data from a high-resolution timer.
+ *
+ * @param timer Address of timer.
+ *
+ * @return The user data.
+ */
+static inline void *k_hrtimer_user_data_get(struct k_hrtimer *timer)
+{
+	return timer->user_data;
+}
+
+/**
+ * @} end defgroup hrtimer_apis
+ */
+
+#endif /* CONFIG_HRTIMER */
+
 /**
  * @addtogroup clock_apis
  * @{
@@ -1970,7 +2318,9 @@ struct k_lifo {
 
 struct k_stack {
 	_wait_q_t wait_q;
-	u32_t *base, *next, *top;
+	u32_t *base, *top;
+	/* tagged number of values held, see stack.c */
+	atomic_t count;
 
 	_OBJECT_TRACING_NEXT_PTR(k_stack);
 };
@@ -1979,8 +2329,8 @@ struct k_stack {
 	{ \
 	.wait_q = SYS_DLIST_STATIC_INIT(&obj.wait_q), \
 	.base = stack_buffer, \
-	.next = stack_buffer, \
 	.top = stack_buffer + stack_num_entries, \
+	.count = ATOMIC_INIT(0), \
 	_OBJECT_TRACING_INIT \
 	}
 
@@ -2024,6 +2374,23 @@ extern void k_stack_init(struct k_stack *stack,
  */
 extern void k_stack_push(struct k_stack *stack, u32_t data);
 
+/**
+ * @brief Push several elements onto a stack.
+ *
+ * This routine adds the @a num 32-bit values of @a data to @a stack, as
+ * many calls to k_stack_push() would, in order, but with interrupts locked
+ * only once. The last value ends on top of the stack.
+ *
+ * @note Can be called by ISRs.
+ *
+ * @param stack Address of the stack.
+ * @param data Values to push onto the stack.
+ * @param num Number of values, for which the stack must have room.
+ *
+ * @return N/A
+ */
+extern void k_stack_push_n(struct k_stack *stack, const u32_t *data, int num);
+
 /**
  * @brief Pop an element from a stack.
  *
@@ -2043,6 +2410,29 @@ extern void k_stack_push(struct k_stack *stack, u32_t data);
  */
 extern int k_stack_pop(struct k_stack *stack, u32_t *data, s32_t timeout);
 
+/**
+ * @brief Pop several elements from a stack.
+ *
+ * This routine removes up to @a num 32-bit values from @a stack, the top
+ * of the stack first, with a single update of the stack. If the stack is
+ * empty, it waits for a value as k_stack_pop() does, and returns it alone.
+ *
+ * @note Can be called by ISRs, but @a timeout must be set to K_NO_WAIT.
+ *
+ * @param stack Address of the stack.
+ * @param data Address of an array of @a num values, to hold the values
+ *             popped from the stack.
+ * @param num Most values to pop.
+ * @param timeout Waiting period to obtain a value (in milliseconds),
+ *                or one of the special values K_NO_WAIT and K_FOREVER.
+ *
+ * @return Number of values popped, or one of the negative errors below.
+ * @retval -EBUSY Returned without waiting.
+ * @retval -EAGAIN Waiting period timed out.
+ */
+extern int k_stack_pop_n(struct k_stack *stack, u32_t *data, int num,
+			 s32_t timeout);
+
 /**
  * @brief Statically define and initialize a stack
  *
@@ -2103,6 +2493,9 @@ struct k_work {
 	void *_reserved;		/* Used by k_queue implementation. */
 	k_work_handler_t handler;
 	atomic_t flags[1];
+#ifdef CONFIG_WORK_POOL_PRIORITY
+	int prio;			/* Used by k_work_pool ordering. */
+#endif
 };
 
 struct k_delayed_work {
@@ -2113,6 +2506,36 @@ struct k_delayed_work {
 
 extern struct k_work_q k_sys_work_q;
 
+struct k_work_pool_stats {
+	u32_t depth;
+	u32_t max_depth;
+	u32_t processed;
+	u32_t max_handler_cycles;
+};
+
+struct k_work_pool {
+	sys_slist_t items;
+	_wait_q_t wait_q;
+	struct k_thread *threads;
+	k_thread_stack_t stacks;
+	size_t stack_size;
+	size_t stack_stride;
+	int num_threads;
+	struct k_work_pool_stats stats;
+};
+
+#define _K_WORK_POOL_INITIALIZER(obj, pool_threads, pool_stacks, \
+				 pool_num_threads) \
+	{ \
+	.items = SYS_SLIST_STATIC_INIT(&obj.items), \
+	.wait_q = SYS_DLIST_STATIC_INIT(&obj.wait_q), \
+	.threads = pool_threads, \
+	.stacks = pool_stacks[0], \
+	.stack_size = K_THREAD_STACK_SIZEOF(pool_stacks[0]), \
+	.stack_stride = sizeof(pool_stacks[0]), \
+	.num_threads = pool_num_threads, \
+	}
+
 /**
  * INTERNAL_HIDDEN @endcond
  */
@@ -2372,6 +2795,111 @@ static inline s32_t k_delayed_work_remaining_get(struct k_delayed_work *work)
 	return _timeout_remaining_get(&work->timeout);
 }
 
+/**
+ * @brief Statically define a workqueue pool.
+ *
+ * The workqueue pool can be accessed outside the module where it is defined
+ * using:
+ *
+ * @code extern struct k_work_pool <name>; @endcode
+ *
+ * The pool does not process work items before it is started with
+ * k_work_pool_start(): the work items submitted to it until then wait in
+ * its queue.
+ *
+ * @param name Name of the workqueue pool.
+ * @param num_threads Number of threads processing the pool's work items.
+ * @param stack_size Size of the stack of each thread (in bytes).
+ */
+#define K_WORK_POOL_DEFINE(name, num_threads, stack_size) \
+	static K_THREAD_STACK_ARRAY_DEFINE(_k_work_pool_stacks_##name, \
+					   num_threads, stack_size); \
+	static struct k_thread _k_work_pool_threads_##name[num_threads]; \
+	struct k_work_pool name = \
+		_K_WORK_POOL_INITIALIZER(name, _k_work_pool_threads_##name, \
+					 _k_work_pool_stacks_##name, \
+					 num_threads)
+
+/**
+ * @brief Start a workqueue pool.
+ *
+ * This routine starts workqueue pool @a pool. The pool spawns all its work
+ * processing threads, which run forever and take work items from one shared
+ * queue: a work item waits only until any of them is free, rather than
+ * behind a single thread busy with, or blocked in, a slow handler.
+ *
+ * @param pool Address of workqueue pool.
+ * @param prio Priority of the pool's threads.
+ *
+ * @return N/A
+ */
+extern void k_work_pool_start(struct k_work_pool *pool, int prio);
+
+/**
+ * @brief Submit a work item to a workqueue pool.
+ *
+ * This routine submits work item @a work to be processed by one of the
+ * threads of workqueue pool @a pool. If the work item is already pending in
+ * the pool's queue as a result of an earlier submission, this routine has no
+ * effect on the work item. If the work item has already been processed, or
+ * is currently being processed, its work is considered complete and the work
+ * item can be resubmitted.
+ *
+ * @warning
+ * A work item resubmitted while its handler runs may be processed by another
+ * thread of the pool before the first run completes: handlers shared between
+ * several work items, or running for a work item that is resubmitted, must
+ * protect the data they share.
+ *
+ * @note Can be called by ISRs.
+ *
+ * @param pool Address of workqueue pool.
+ * @param work Address of work item.
+ *
+ * @return N/A
+ */
+extern void k_work_pool_submit(struct k_work_pool *pool, struct k_work *work);
+
+#if defined(CONFIG_WORK_POOL_PRIORITY) || defined(__DOXYGEN__)
+/**
+ * @brief Submit a work item to a workqueue pool with a priority.
+ *
+ * This routine works like k_work_pool_submit(), except that the work item is
+ * queued ahead of the pending work items of lower priority, behind the ones
+ * of higher or equal priority. As for threads, a lower value means a higher
+ * priority: k_work_pool_submit() submits work items with priority 0.
+ *
+ * Queueing a work item behind others of the same priority is O(1), queueing
+ * it ahead of pending work items of lower priority walks the pool's queue.
+ *
+ * @note Can be called by ISRs.
+ *
+ * @param pool Address of workqueue pool.
+ * @param work Address of work item.
+ * @param prio Priority of the work item.
+ *
+ * @return N/A
+ */
+extern void k_work_pool_submit_prio(struct k_work_pool *pool,
+				    struct k_work *work, int prio);
+#endif
+
+/**
+ * @brief Get the statistics of a workqueue pool.
+ *
+ * Gives the number of work items waiting in the queue of workqueue pool
+ * @a pool and the most that ever waited in it, the number of work items
+ * processed, and the longest time a handler ran for, in hardware cycles: use
+ * SYS_CLOCK_HW_CYCLES_TO_NS() to convert it.
+ *
+ * @param pool Address of workqueue pool.
+ * @param stats Address where to store the statistics.
+ *
+ * @return N/A
+ */
+extern void k_work_pool_stats_get(struct k_work_pool *pool,
+				  struct k_work_pool_stats *stats);
+
 /**
  * @} end defgroup workqueue_apis
  */
@@ -2385,6 +2913,7 @@ struct k_mutex {
 	struct k_thread *owner;
 	u32_t lock_count;
 	int owner_orig_prio;
+	_CONTENTION_STATS;
 
 	_OBJECT_TRACING_NEXT_PTR(k_mutex);
 };
@@ -2473,10 +3002,35 @@ extern int k_mutex_lock(struct k_mutex *mutex, s32_t timeout);
  */
 extern void k_mutex_unlock(struct k_mutex *mutex);
 
+#ifdef CONFIG_CONTENTION_STATS
 /**
- * @} end defgroup mutex_apis
- */
-
+ * @brief Get the contention statistics of a mutex.
+ *
+ * The top waiters are sorted by decreasing total wait time, and unused
+ * entries have a NULL thread.
+ *
+ * @param mutex Address of the mutex.
+ * @param stats Address of the statistics, filled by this routine.
+ *
+ * @return N/A
+ */
+extern void k_mutex_contention_get(struct k_mutex *mutex,
+				   struct k_contention_stats *stats);
+
+/**
+ * @brief Reset the contention statistics of a mutex.
+ *
+ * @param mutex Address of the mutex.
+ *
+ * @return N/A
+ */
+extern void k_mutex_contention_reset(struct k_mutex *mutex);
+#endif
+
+/**
+ * @} end defgroup mutex_apis
+ */
+
 /**
  * @cond INTERNAL_HIDDEN
  */
@@ -2486,6 +3040,7 @@ struct k_sem {
 	unsigned int count;
 	unsigned int limit;
 	_POLL_EVENT;
+	_CONTENTION_STATS;
 
 	_OBJECT_TRACING_NEXT_PTR(k_sem);
 };
@@ -2594,6 +3149,32 @@ static inline unsigned int _impl_k_sem_count_get(struct k_sem *sem)
 	return sem->count;
 }
 
+#ifdef CONFIG_CONTENTION_STATS
+/**
+ * @brief Get the contention statistics of a semaphore.
+ *
+ * Semaphores have no owner, so the priority inheritance boosts are always
+ * zero. The top waiters are sorted by decreasing total wait time, and unused
+ * entries have a NULL thread.
+ *
+ * @param sem Address of the semaphore.
+ * @param stats Address of the statistics, filled by this routine.
+ *
+ * @return N/A
+ */
+extern void k_sem_contention_get(struct k_sem *sem,
+				 struct k_contention_stats *stats);
+
+/**
+ * @brief Reset the contention statistics of a semaphore.
+ *
+ * @param sem Address of the semaphore.
+ *
+ * @return N/A
+ */
+extern void k_sem_contention_reset(struct k_sem *sem);
+#endif
+
 /**
  * @brief Statically define and initialize a semaphore.
  *
@@ -2614,6 +3195,51 @@ static inline unsigned int _impl_k_sem_count_get(struct k_sem *sem)
  * @} end defgroup semaphore_apis
  */
 
+/**
+ * @defgroup futex_apis Futex APIs
+ * @ingroup kernel_apis
+ * @{
+ */
+
+/**
+ * @brief Wait on a futex.
+ *
+ * This routine causes the current thread to wait on the futex word at
+ * @a addr, as long as it holds @a expected: the comparison and the decision
+ * to wait are atomic with respect to k_futex_wake(). The futex word is a
+ * plain atomic variable: it can live in application memory, to be operated
+ * on by user threads without system calls, the kernel only keeping a wait
+ * queue for its address.
+ *
+ * @param addr Address of the futex word.
+ * @param expected Value the futex word is expected to hold.
+ * @param timeout Waiting period (in milliseconds), or one of the special
+ *                values K_NO_WAIT and K_FOREVER.
+ *
+ * @retval 0 Woken by k_futex_wake().
+ * @retval -EAGAIN The futex word did not hold @a expected.
+ * @retval -ETIMEDOUT Waiting period timed out.
+ */
+__syscall int k_futex_wait(atomic_t *addr, atomic_val_t expected,
+			   s32_t timeout);
+
+/**
+ * @brief Wake threads waiting on a futex.
+ *
+ * This routine wakes the highest priority thread waiting on the futex word
+ * at @a addr, or all of them.
+ *
+ * @param addr Address of the futex word.
+ * @param wake_all Non-zero to wake all waiting threads.
+ *
+ * @return Number of threads woken.
+ */
+__syscall int k_futex_wake(atomic_t *addr, int wake_all);
+
+/**
+ * @} end defgroup futex_apis
+ */
+
 /**
  * @defgroup alert_apis Alert APIs
  * @ingroup kernel_apis
@@ -2877,6 +3503,94 @@ extern int k_msgq_put(struct k_msgq *q, void *data, s32_t timeout);
  */
 extern int k_msgq_get(struct k_msgq *q, void *data, s32_t timeout);
 
+/**
+ * @brief Send several messages to a message queue.
+ *
+ * This routine sends up to @a num_msgs consecutive messages to message queue
+ * @a q at once: it locks interrupts only once, and causes at most one
+ * context switch, however many waiting threads receive a message.
+ *
+ * As many messages as there is room for are sent. If the queue is full,
+ * the routine waits for room for the first message only.
+ *
+ * @note Can be called by ISRs, but @a timeout must be set to K_NO_WAIT.
+ *
+ * @param q Address of the message queue.
+ * @param data Pointer to the messages.
+ * @param num_msgs Number of messages to send.
+ * @param timeout Waiting period to add the first message (in milliseconds),
+ *                or one of the special values K_NO_WAIT and K_FOREVER.
+ *
+ * @return Number of messages sent, at least 1, if successful;
+ *         -ENOMSG if returned without waiting or the queue was purged;
+ *         -EAGAIN if the waiting period timed out.
+ */
+extern int k_msgq_put_batch(struct k_msgq *q, void *data, u32_t num_msgs,
+			    s32_t timeout);
+
+/**
+ * @brief Receive several messages from a message queue.
+ *
+ * This routine receives up to @a num_msgs messages from message queue @a q
+ * at once, in a "first in, first out" manner: it locks interrupts only once,
+ * and causes at most one context switch, however many threads waiting to
+ * send a message are woken up.
+ *
+ * As many messages as available are received. If the queue is empty, the
+ * routine waits for one message only.
+ *
+ * @note Can be called by ISRs, but @a timeout must be set to K_NO_WAIT.
+ *
+ * @param q Address of the message queue.
+ * @param data Address of area to hold the received messages.
+ * @param num_msgs Maximum number of messages to receive.
+ * @param timeout Waiting period to receive the first message (in
+ *                milliseconds), or one of the special values K_NO_WAIT
+ *                and K_FOREVER.
+ *
+ * @return Number of messages received, at least 1, if successful;
+ *         -ENOMSG if returned without waiting;
+ *         -EAGAIN if the waiting period timed out.
+ */
+extern int k_msgq_get_batch(struct k_msgq *q, void *data, u32_t num_msgs,
+			    s32_t timeout);
+
+/**
+ * @brief Read the first message of a message queue in place.
+ *
+ * This routine gives access to the first message of message queue @a q
+ * directly in the queue's ring buffer, without copying it. The message stays
+ * in the queue until k_msgq_peek_finish() is called.
+ *
+ * Only one thread at a time may read a message queue this way, and it must
+ * not call k_msgq_get(), k_msgq_get_batch() or k_msgq_purge() before calling
+ * k_msgq_peek_finish().
+ *
+ * @note Can be called by ISRs.
+ *
+ * @param q Address of the message queue.
+ * @param data Address of area to hold the address of the message.
+ *
+ * @retval 0 Message claimed.
+ * @retval -ENOMSG The queue is empty.
+ */
+extern int k_msgq_peek_claim(struct k_msgq *q, void **data);
+
+/**
+ * @brief Release a message read in place.
+ *
+ * This routine removes the message claimed with k_msgq_peek_claim() from
+ * message queue @a q, and lets the first thread waiting to send a message,
+ * if any, put its message in the queue.
+ *
+ * @note Can be called by ISRs.
+ *
+ * @param q Address of the message queue.
+ *
+ * @return N/A
+ */
+extern void k_msgq_peek_finish(struct k_msgq *q);
+
 /**
  * @brief Purge a message queue.
  *
@@ -3286,6 +4000,93 @@ extern int k_pipe_get(struct k_pipe *pipe, void *data,
 extern void k_pipe_block_put(struct k_pipe *pipe, struct k_mem_block *block,
 			     size_t size, struct k_sem *sem);
 
+/**
+ * @brief Claim space in a pipe's ring buffer to write data in place.
+ *
+ * This routine gives direct access to free space in the ring buffer of
+ * @a pipe, so that the caller can produce data there instead of copying it
+ * in with k_pipe_put(). The space is contiguous: when it wraps around the
+ * end of the ring buffer, only the part up to the end is claimed, and the
+ * rest can be claimed once that part is committed.
+ *
+ * The claimed space must be handed to readers with k_pipe_put_commit()
+ * before the pipe is written to again. Only one thread at a time may claim
+ * space in a given pipe, and it must not call k_pipe_put() on the pipe
+ * before committing.
+ *
+ * @param pipe Address of the pipe. It must have a ring buffer.
+ * @param data Address of area to hold the address of the claimed space.
+ * @param size Address of the number of bytes wanted, updated to hold the
+ *             number of bytes claimed.
+ * @param timeout Waiting period to wait for free space (in milliseconds),
+ *                or one of the special values K_NO_WAIT and K_FOREVER.
+ *
+ * @retval 0 At least one byte was claimed.
+ * @retval -EIO Returned without waiting; the ring buffer is full.
+ * @retval -EAGAIN Waiting period timed out, or the free space was taken by
+ *                 another writer.
+ */
+extern int k_pipe_put_claim(struct k_pipe *pipe, void **data, size_t *size,
+			    s32_t timeout);
+
+/**
+ * @brief Commit data written in place to a pipe.
+ *
+ * This routine makes the first @a size bytes of the space claimed with
+ * k_pipe_put_claim() available to readers. The rest of the claimed space,
+ * if any, is given back to the pipe. Waiting readers are handed the data
+ * and readied.
+ *
+ * @param pipe Address of the pipe.
+ * @param size Number of data bytes written, at most the size claimed.
+ *
+ * @return N/A
+ */
+extern void k_pipe_put_commit(struct k_pipe *pipe, size_t size);
+
+/**
+ * @brief Claim data in a pipe's ring buffer to read it in place.
+ *
+ * This routine gives direct access to the data in the ring buffer of
+ * @a pipe, so that the caller can consume it there instead of copying it out
+ * with k_pipe_get(). The data is contiguous: when it wraps around the end of
+ * the ring buffer, only the part up to the end is claimed, and the rest can
+ * be claimed once that part is finished with.
+ *
+ * The claimed data must be released with k_pipe_get_finish() before the pipe
+ * is read again. Only one thread at a time may claim data in a given pipe,
+ * and it must not call k_pipe_get() on the pipe before finishing.
+ *
+ * @param pipe Address of the pipe. It must have a ring buffer.
+ * @param data Address of area to hold the address of the claimed data.
+ * @param size Address of the maximum number of bytes wanted, updated to hold
+ *             the number of bytes claimed.
+ * @param timeout Waiting period to wait for data (in milliseconds), or one
+ *                of the special values K_NO_WAIT and K_FOREVER.
+ *
+ * @retval 0 At least one byte was claimed.
+ * @retval -EIO Returned without waiting; the ring buffer is empty.
+ * @retval -EAGAIN Waiting period timed out, or the data was taken by
+ *                 another reader.
+ */
+extern int k_pipe_get_claim(struct k_pipe *pipe, void **data, size_t *size,
+			    s32_t timeout);
+
+/**
+ * @brief Release data read in place from a pipe.
+ *
+ * This routine removes the first @a size bytes of the data claimed with
+ * k_pipe_get_claim() from the pipe. The rest of the claimed data, if any,
+ * stays in the pipe. Waiting writers are given the space freed and readied
+ * once all of their data is in the pipe.
+ *
+ * @param pipe Address of the pipe.
+ * @param size Number of data bytes consumed, at most the size claimed.
+ *
+ * @return N/A
+ */
+extern void k_pipe_get_finish(struct k_pipe *pipe, size_t size);
+
 /**
  * @} end defgroup pipe_apis
  */
@@ -3299,12 +4100,27 @@ struct k_mem_slab {
 	u32_t num_blocks;
 	size_t block_size;
 	char *buffer;
-	char *free_list;
-	u32_t num_used;
+	/* tagged index of the first free block, see mem_slab.c */
+	atomic_t free_list;
+	atomic_t num_used;
+#ifdef CONFIG_MEM_SLAB_STATS
+	atomic_t max_used;
+	atomic_t alloc_failures;
+	struct k_mem_slab *next_slab;
+#endif
 
 	_OBJECT_TRACING_NEXT_PTR(k_mem_slab);
 };
 
+#ifdef CONFIG_MEM_SLAB_STATS
+#define _K_MEM_SLAB_STATS_INIT \
+	.max_used = ATOMIC_INIT(0), \
+	.alloc_failures = ATOMIC_INIT(0), \
+	.next_slab = NULL,
+#else
+#define _K_MEM_SLAB_STATS_INIT
+#endif
+
 #define _K_MEM_SLAB_INITIALIZER(obj, slab_buffer, slab_block_size, \
 			       slab_num_blocks) \
 	{ \
@@ -3312,8 +4128,9 @@ struct k_mem_slab {
 	.num_blocks = slab_num_blocks, \
 	.block_size = slab_block_size, \
 	.buffer = slab_buffer, \
-	.free_list = NULL, \
-	.num_used = 0, \
+	.free_list = ATOMIC_INIT(0), \
+	.num_used = ATOMIC_INIT(0), \
+	_K_MEM_SLAB_STATS_INIT \
 	_OBJECT_TRACING_INIT \
 	}
 
@@ -3422,7 +4239,7 @@ extern void k_mem_slab_free(struct k_mem_slab *slab, void **mem);
  */
 static inline u32_t k_mem_slab_num_used_get(struct k_mem_slab *slab)
 {
-	return slab->num_used;
+	return atomic_get(&slab->num_used);
 }
 
 /**
@@ -3437,9 +4254,62 @@ static inline u32_t k_mem_slab_num_used_get(struct k_mem_slab *slab)
  */
 static inline u32_t k_mem_slab_num_free_get(struct k_mem_slab *slab)
 {
-	return slab->num_blocks - slab->num_used;
+	return slab->num_blocks - atomic_get(&slab->num_used);
 }
 
+#ifdef CONFIG_MEM_SLAB_STATS
+/**
+ * @brief Memory slab usage statistics.
+ *
+ * Only maintained when CONFIG_MEM_SLAB_STATS is enabled.
+ */
+struct k_mem_slab_stats {
+	/* number of blocks and their size */
+	u32_t num_blocks;
+	size_t block_size;
+	/* blocks currently allocated */
+	u32_t num_used;
+	/* most blocks ever allocated at the same time */
+	u32_t max_used;
+	/* allocations that returned without a block */
+	u32_t alloc_failures;
+};
+
+/**
+ * @brief Get the usage statistics of a memory slab.
+ *
+ * @param slab Address of the memory slab.
+ * @param stats Statistics, filled by this routine.
+ *
+ * @return N/A
+ */
+extern void k_mem_slab_stats_get(struct k_mem_slab *slab,
+				 struct k_mem_slab_stats *stats);
+
+/**
+ * @typedef k_mem_slab_user_cb_t
+ * @brief Memory slab iterator callback.
+ *
+ * @param slab Address of the memory slab.
+ * @param user_data Argument passed to k_mem_slab_foreach().
+ */
+typedef void (*k_mem_slab_user_cb_t)(struct k_mem_slab *slab,
+				     void *user_data);
+
+/**
+ * @brief Iterate over all memory slabs.
+ *
+ * This routine calls @a user_cb for each memory slab, statically defined
+ * or initialized with k_mem_slab_init().
+ *
+ * @param user_cb Callback.
+ * @param user_data Argument passed to @a user_cb.
+ *
+ * @return N/A
+ */
+extern void k_mem_slab_foreach(k_mem_slab_user_cb_t user_cb, void *user_data);
+#endif /* CONFIG_MEM_SLAB_STATS */
+
 /**
  * @} end defgroup mem_slab_apis
  */
@@ -3454,8 +4324,43 @@ struct k_mem_pool_lvl {
 		u32_t bits;
 	};
 	sys_dlist_t free_list;
+#ifdef CONFIG_MEM_POOL_CACHE
+	sys_slist_t cache;
+	u8_t cache_count;
+#endif
+};
+
+/**
+ * INTERNAL_HIDDEN @endcond
+ */
+
+/**
+ * @addtogroup mem_pool_apis
+ * @{
+ */
+
+/**
+ * @brief Memory pool block cache statistics.
+ *
+ * Only maintained when CONFIG_MEM_POOL_CACHE is enabled.
+ */
+struct k_mem_pool_cache_stats {
+	/* allocations served from the cache */
+	u32_t hits;
+	/* allocations that found the cache empty */
+	u32_t misses;
+	/* times the cache was flushed back into the pool */
+	u32_t flushes;
 };
 
+/**
+ * @} end addtogroup mem_pool_apis
+ */
+
+/**
+ * @cond INTERNAL_HIDDEN
+ */
+
 struct k_mem_pool {
 	void *buf;
 	size_t max_sz;
@@ -3464,6 +4369,9 @@ struct k_mem_pool {
 	u8_t max_inline_level;
 	struct k_mem_pool_lvl *levels;
 	_wait_q_t wait_q;
+#ifdef CONFIG_MEM_POOL_CACHE
+	struct k_mem_pool_cache_stats cache_stats;
+#endif
 };
 
 #define _ALIGN4(n) ((((n)+3)/4)*4)
@@ -3606,6 +4514,22 @@ extern void k_mem_pool_free(struct k_mem_block *block);
  */
 static inline void __deprecated k_mem_pool_defrag(struct k_mem_pool *pool) {}
 
+#ifdef CONFIG_MEM_POOL_CACHE
+/**
+ * @brief Get the block cache statistics of a memory pool.
+ *
+ * @param pool Address of the memory pool.
+ * @param stats Statistics, filled by this routine.
+ *
+ * @return N/A
+ */
+static inline void k_mem_pool_cache_stats_get(struct k_mem_pool *pool,
+					      struct k_mem_pool_cache_stats *stats)
+{
+	*stats = pool->cache_stats;
+}
+#endif
+
 /**
  * @} end addtogroup mem_pool_apis
  */
@@ -3642,6 +4566,50 @@ extern void *k_malloc(size_t size);
  */
 extern void k_free(void *ptr);
 
+/**
+ * @brief Allocate memory from heap, array style
+ *
+ * This routine provides traditional calloc() semantics. Memory is
+ * allocated from the heap memory pool and zeroed.
+ *
+ * @param nmemb Number of elements in the requested array
+ * @param size Size of each array element (in bytes).
+ *
+ * @return Address of the allocated memory if successful; otherwise NULL.
+ */
+extern void *k_calloc(size_t nmemb, size_t size);
+
+#ifdef CONFIG_HEAP_MEM_TLSF
+/**
+ * @brief Heap statistics.
+ */
+struct k_heap_stats {
+	/* bytes available in free blocks, block headers excluded */
+	size_t free_bytes;
+	/* bytes in allocated blocks, block headers excluded */
+	size_t used_bytes;
+	/* largest block that can currently be allocated */
+	size_t max_free_size;
+	/* number of free blocks */
+	u32_t free_blocks;
+	/* number of allocated blocks */
+	u32_t used_blocks;
+};
+
+/**
+ * @brief Get heap statistics.
+ *
+ * This routine walks the heap and reports how much of it is used and how
+ * fragmented it is. It takes a time proportional to the number of blocks
+ * in the heap, with interrupts locked, so it is meant for diagnostics.
+ *
+ * @param stats Statistics, filled by this routine.
+ *
+ * @return N/A
+ */
+extern void k_heap_stats_get(struct k_heap_stats *stats);
+#endif
+
 /**
  * @} end defgroup heap_apis
  */
@@ -3655,8 +4623,13 @@ extern void k_free(void *ptr);
 #endif
 
 /* private - implementation data created as needed, per-type */
+struct k_poll_set;
+
 struct _poller {
 	struct k_thread *thread;
+
+	/* set the events belong to, NULL for k_poll() */
+	struct k_poll_set *set;
 };
 
 /* private - types bit positions */
@@ -3817,6 +4790,26 @@ struct k_poll_event {
 	{ .obj = event_obj }, \
 	}
 
+/**
+ * @brief Poll set
+ *
+ * A set of poll events that stay registered with their objects across
+ * waits, see k_poll_set_init().
+ */
+struct k_poll_set {
+	/* PRIVATE - events whose condition is met, not returned yet */
+	sys_dlist_t ready;
+
+	/* PRIVATE - events returned by the last wait, to register again */
+	sys_dlist_t returned;
+
+	/* PRIVATE - thread waiting for an event */
+	_wait_q_t wait_q;
+
+	/* PRIVATE - poller of all the events in the set */
+	struct _poller poller;
+};
+
 /**
  * @brief Initialize one struct k_poll_event instance
  *
@@ -3906,6 +4899,78 @@ extern void k_poll_signal_init(struct k_poll_signal *signal);
 
 extern int k_poll_signal(struct k_poll_signal *signal, int result);
 
+/**
+ * @brief Initialize a poll set.
+ *
+ * A poll set is an alternative to k_poll() for a thread that waits on the
+ * same events over and over, e.g. in an event loop. k_poll() registers each
+ * event with its object on every call and unregisters it afterwards, so a
+ * wait costs a time proportional to the number of events. The events of a
+ * poll set instead stay registered with their objects: when one of them
+ * occurs, it is queued on the set, and a wait only looks at the events that
+ * occurred.
+ *
+ * Like with k_poll(), threads pending on an object have precedence over the
+ * poll set, and so do threads polling on the object with k_poll().
+ *
+ * @param set The poll set to initialize.
+ *
+ * @return N/A
+ */
+extern void k_poll_set_init(struct k_poll_set *set);
+
+/**
+ * @brief Add an event to a poll set.
+ *
+ * The event must have been initialized with k_poll_event_init(), must not be
+ * of type K_POLL_TYPE_IGNORE, and must not be in another set or passed to
+ * k_poll() while in this set. If the event condition is already met, the
+ * event is ready right away.
+ *
+ * @param set The poll set.
+ * @param event The event to add.
+ *
+ * @return N/A
+ */
+extern void k_poll_set_add(struct k_poll_set *set, struct k_poll_event *event);
+
+/**
+ * @brief Remove an event from a poll set.
+ *
+ * @param set The poll set.
+ * @param event The event to remove, which must be in @a set.
+ *
+ * @return N/A
+ */
+extern void k_poll_set_remove(struct k_poll_set *set,
+			      struct k_poll_event *event);
+
+/**
+ * @brief Wait for events of a poll set to occur
+ *
+ * This routine waits until at least one event of the poll set @a set has
+ * occurred, and returns the events that occurred. Their state field tells
+ * which condition was met, as with k_poll().
+ *
+ * Events are level-triggered: an event returned by one call is registered
+ * again by the next one, and returned again if its condition is still met,
+ * e.g. if a poll signal has not been reset or a queue still has data.
+ *
+ * Only one thread at a time may wait on a given poll set.
+ *
+ * @param set The poll set.
+ * @param events Array to fill with pointers to the events that occurred.
+ * @param max_events Maximum number of events to return.
+ * @param timeout Waiting period for an event to occur (in milliseconds),
+ *                or one of the special values K_NO_WAIT and K_FOREVER.
+ *
+ * @return Number of events returned, if successful; -EAGAIN if the waiting
+ *         period timed out.
+ */
+extern int k_poll_set_wait(struct k_poll_set *set,
+			   struct k_poll_event **events, int max_events,
+			   s32_t timeout);
+
 /* private internal function */
 extern int _handle_obj_poll_events(sys_dlist_t *events, u32_t state);
 
@@ -3913,6 +4978,336 @@ extern int _handle_obj_poll_events(sys_dlist_t *events, u32_t state);
  * @} end defgroup poll_apis
  */
 
+/**
+ * @defgroup tasklet_apis Tasklet APIs
+ * @ingroup kernel_apis
+ * @{
+ */
+
+struct k_tasklet;
+
+/**
+ * @typedef k_tasklet_handler_t
+ * @brief Tasklet handler function type.
+ *
+ * A tasklet handler is written as sequential code between K_TASKLET_BEGIN()
+ * and K_TASKLET_END(), and waits with the K_TASKLET_xxx macros. Each wait
+ * returns from the handler, which the executor calls again once the wait
+ * is over, to resume right after the macro.
+ *
+ * Since the tasklet has no stack of its own, the values of local variables
+ * are lost across waits: the state of the tasklet must be kept in a
+ * structure embedding the struct k_tasklet, which the handler retrieves
+ * with CONTAINER_OF(). Switch statements cannot enclose a wait, and there
+ * can only be one wait per source line.
+ *
+ * @param tasklet Address of the tasklet.
+ *
+ * @return N/A
+ */
+typedef void (*k_tasklet_handler_t)(struct k_tasklet *tasklet);
+
+/**
+ * @cond INTERNAL_HIDDEN
+ */
+
+enum _tasklet_states {
+	_TASKLET_IDLE,
+	_TASKLET_RUNNABLE,
+	_TASKLET_RUNNING,
+	_TASKLET_WAITING,
+};
+
+enum _tasklet_timeouts {
+	_TASKLET_NO_WAIT,
+	_TASKLET_FOREVER,
+	_TASKLET_DEADLINE,
+};
+
+struct k_tasklet_executor {
+	/* events the waiting tasklets wait on, and the kick event */
+	struct k_poll_set set;
+
+	/* raised when a tasklet becomes runnable outside of the executor */
+	struct k_poll_signal kick;
+	struct k_poll_event kick_event;
+
+	/* tasklets to run, in order */
+	sys_slist_t runnable;
+
+	/* waiting tasklets with a timeout, earliest deadline first */
+	sys_slist_t timeouts;
+
+	struct k_thread thread;
+};
+
+struct k_tasklet {
+	/* on the runnable or the timeouts list of the executor */
+	sys_snode_t node;
+
+	k_tasklet_handler_t handler;
+	struct k_tasklet_executor *executor;
+
+	/* event waited on, registered with the poll set of the executor */
+	struct k_poll_event event;
+
+	/* end of the wait, in k_uptime_get_32() milliseconds */
+	u32_t deadline;
+
+	/* result of the last wait */
+	int result;
+
+	/* line of the wait to resume at, 0 to start over */
+	u16_t lc;
+
+	u8_t state;
+	u8_t timeout;
+};
+
+#define _K_TASKLET_INITIALIZER(handler_fn) \
+	{ \
+	.handler = handler_fn, \
+	.state = _TASKLET_IDLE, \
+	}
+
+extern void _k_tasklet_timeout_set(struct k_tasklet *tasklet,
+				   s32_t timeout);
+extern int _k_tasklet_wait(struct k_tasklet *tasklet, u32_t type, void *obj);
+extern void _k_tasklet_yield(struct k_tasklet *tasklet);
+
+/*
+ * Wait until cond is true, evaluated again each time the object becomes
+ * available, or until the timeout. The result of the tasklet is 0 if cond
+ * became true, -EBUSY or -EAGAIN otherwise.
+ */
+#define _K_TASKLET_WAIT(tasklet, cond, type, obj, timeout) \
+	do { \
+		_k_tasklet_timeout_set(tasklet, timeout); \
+		(tasklet)->lc = __LINE__; \
+	case __LINE__: \
+		if ((tasklet)->result == 0 && !(cond)) { \
+			(tasklet)->result = _k_tasklet_wait(tasklet, type, \
+							    obj); \
+			if ((tasklet)->result == 0) { \
+				return; \
+			} \
+		} \
+	} while ((0))
+
+/**
+ * INTERNAL_HIDDEN @endcond
+ */
+
+/**
+ * @brief Statically define and initialize a tasklet.
+ *
+ * The tasklet can be accessed outside the module where it is defined using:
+ *
+ * @code extern struct k_tasklet <name>; @endcode
+ *
+ * @param name Name of the tasklet.
+ * @param handler Tasklet handler function.
+ */
+#define K_TASKLET_DEFINE(name, handler) \
+	struct k_tasklet name = _K_TASKLET_INITIALIZER(handler)
+
+/**
+ * @brief Start the body of a tasklet handler.
+ *
+ * @param tasklet Address of the tasklet.
+ */
+#define K_TASKLET_BEGIN(tasklet) \
+	switch ((tasklet)->lc) { \
+	case 0:
+
+/**
+ * @brief End the body of a tasklet handler.
+ *
+ * Reaching the end of the body ends the tasklet, which can then be started
+ * again.
+ *
+ * @param tasklet Address of the tasklet.
+ */
+#define K_TASKLET_END(tasklet) \
+	} \
+	(tasklet)->lc = 0
+
+/**
+ * @brief End a tasklet from anywhere in its handler.
+ *
+ * @param tasklet Address of the tasklet.
+ */
+#define K_TASKLET_EXIT(tasklet) \
+	do { \
+		(tasklet)->lc = 0; \
+		return; \
+	} while ((0))
+
+/**
+ * @brief Let the other runnable tasklets of the executor run.
+ *
+ * @param tasklet Address of the tasklet.
+ */
+#define K_TASKLET_YIELD(tasklet) \
+	do { \
+		(tasklet)->lc = __LINE__; \
+		_k_tasklet_yield(tasklet); \
+		return; \
+	case __LINE__: \
+		; \
+	} while ((0))
+
+/**
+ * @brief Suspend a tasklet for a given time.
+ *
+ * @param tasklet Address of the tasklet.
+ * @param duration Duration of the sleep (in milliseconds).
+ */
+#define K_TASKLET_SLEEP(tasklet, duration) \
+	do { \
+		_K_TASKLET_WAIT(tasklet, 0, K_POLL_TYPE_IGNORE, NULL, \
+				duration); \
+		(tasklet)->result = 0; \
+	} while ((0))
+
+/**
+ * @brief Take a semaphore from a tasklet.
+ *
+ * This is the tasklet equivalent of k_sem_take(). Its result is read with
+ * k_tasklet_result().
+ *
+ * @param tasklet Address of the tasklet.
+ * @param sem Address of the semaphore.
+ * @param timeout Waiting period to take the semaphore (in milliseconds),
+ *                or one of the special values K_NO_WAIT and K_FOREVER.
+ */
+#define K_TASKLET_SEM_TAKE(tasklet, sem, timeout) \
+	_K_TASKLET_WAIT(tasklet, k_sem_take(sem, K_NO_WAIT) == 0, \
+			K_POLL_TYPE_SEM_AVAILABLE, sem, timeout)
+
+/**
+ * @brief Get an element from a queue in a tasklet.
+ *
+ * This is the tasklet equivalent of k_queue_get(). Its result is read with
+ * k_tasklet_result().
+ *
+ * @param tasklet Address of the tasklet.
+ * @param queue Address of the queue.
+ * @param data Lvalue set to the address of the element, or NULL if none
+ *             was obtained.
+ * @param timeout Waiting period to obtain an element (in milliseconds),
+ *                or one of the special values K_NO_WAIT and K_FOREVER.
+ */
+#define K_TASKLET_QUEUE_GET(tasklet, queue, data, timeout) \
+	do { \
+		_K_TASKLET_WAIT(tasklet, \
+				((data) = k_queue_get(queue, K_NO_WAIT)) != NULL, \
+				K_POLL_TYPE_DATA_AVAILABLE, queue, timeout); \
+		if ((tasklet)->result != 0) { \
+			(data) = NULL; \
+		} \
+	} while ((0))
+
+/**
+ * @brief Wait for a poll signal in a tasklet.
+ *
+ * The signal is not reset: as with k_poll(), the caller resets its
+ * @a signaled field before waiting for it again. The result of the wait is
+ * read with k_tasklet_result().
+ *
+ * @param tasklet Address of the tasklet.
+ * @param signal Address of the poll signal.
+ * @param timeout Waiting period for the signal (in milliseconds),
+ *                or one of the special values K_NO_WAIT and K_FOREVER.
+ */
+#define K_TASKLET_SIGNAL_WAIT(tasklet, signal, timeout) \
+	_K_TASKLET_WAIT(tasklet, (signal)->signaled, K_POLL_TYPE_SIGNAL, \
+			signal, timeout)
+
+/**
+ * @brief Initialize a tasklet.
+ *
+ * This routine initializes a tasklet, prior to its first use.
+ *
+ * @param tasklet Address of the tasklet.
+ * @param handler Tasklet handler function.
+ *
+ * @return N/A
+ */
+static inline void k_tasklet_init(struct k_tasklet *tasklet,
+				  k_tasklet_handler_t handler)
+{
+	*tasklet = (struct k_tasklet)_K_TASKLET_INITIALIZER(handler);
+}
+
+/**
+ * @brief Start a tasklet.
+ *
+ * This routine makes @a tasklet run from the start of its handler on
+ * @a executor. It can be called from an ISR.
+ *
+ * @param executor Address of the executor.
+ * @param tasklet Address of the tasklet.
+ *
+ * @retval 0 Tasklet started.
+ * @retval -EBUSY Tasklet already started and not ended yet.
+ */
+extern int k_tasklet_start(struct k_tasklet_executor *executor,
+			   struct k_tasklet *tasklet);
+
+/**
+ * @brief Get the result of the last wait of a tasklet.
+ *
+ * @param tasklet Address of the tasklet.
+ *
+ * @retval 0 Object obtained, or signal raised.
+ * @retval -EBUSY Returned without waiting.
+ * @retval -EAGAIN Waiting period timed out.
+ */
+static inline int k_tasklet_result(struct k_tasklet *tasklet)
+{
+	return tasklet->result;
+}
+
+/**
+ * @brief Check whether a tasklet has ended.
+ *
+ * @param tasklet Address of the tasklet.
+ *
+ * @return 1 if the tasklet was never started or has ended, 0 otherwise.
+ */
+static inline int k_tasklet_is_idle(struct k_tasklet *tasklet)
+{
+	return tasklet->state == _TASKLET_IDLE;
+}
+
+/**
+ * @brief Start a tasklet executor.
+ *
+ * This routine starts the thread that runs the tasklets of @a executor.
+ * The executor must be started before any tasklet is started on it.
+ *
+ * @param executor Address of the executor.
+ * @param stack Pointer to the executor thread's stack, shared by its
+ *              tasklets.
+ * @param stack_size Size of the executor thread's stack (in bytes).
+ * @param prio Priority of the executor thread.
+ *
+ * @return N/A
+ */
+extern void k_tasklet_executor_start(struct k_tasklet_executor *executor,
+				     k_thread_stack_t stack,
+				     size_t stack_size, int prio);
+
+/**
+ * @brief System tasklet executor, if CONFIG_TASKLETS is enabled.
+ */
+extern struct k_tasklet_executor k_sys_tasklet_executor;
+
+/**
+ * @} end defgroup tasklet_apis
+ */
+
 /**
  * @brief Make the CPU idle.
  *
@@ -4160,6 +5555,10 @@ struct k_mem_domain {
 	struct k_mem_partition partitions[CONFIG_MAX_DOMAIN_PARTITIONS];
 	/* domain q */
 	sys_dlist_t mem_domain_q;
+	/* changes with the partitions, telling the architecture code that
+	 * the MPU/MMU settings it made for the domain are out of date
+	 */
+	u32_t generation;
 };
 #endif /* CONFIG_USERSPACE */
 
@@ -0,0 +1,118 @@
+/*
+ * Copyright (c) 2017 Intel Corporation
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+/**
+ * @file
+ * @brief Kernel trace buffer
+ *
+ * Kernel events are recorded in a binary ring buffer, timestamped with the
+ * hardware cycle counter. Recording is lock-free: a record is reserved by
+ * atomically incrementing the buffer's head index, so that interrupts never
+ * need to be locked, and the oldest records are overwritten once the buffer
+ * is full. scripts/trace2ctf.py converts a memory dump of the buffer into
+ * Common Trace Format.
+ */
+
+#ifndef __KERNEL_TRACE_H__
+#define __KERNEL_TRACE_H__
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/* kernel events: scripts/trace2ctf.py describes them as well */
+#define SYS_TRACE_CONTEXT_SWITCH	0x0001
+#define SYS_TRACE_ISR_ENTER		0x0002
+#define SYS_TRACE_ISR_EXIT		0x0003
+#define SYS_TRACE_SEM_GIVE		0x0004
+#define SYS_TRACE_SEM_TAKE		0x0005
+#define SYS_TRACE_MUTEX_LOCK		0x0006
+#define SYS_TRACE_MUTEX_UNLOCK		0x0007
+#define SYS_TRACE_QUEUE_PUT		0x0008
+#define SYS_TRACE_QUEUE_GET		0x0009
+#define SYS_TRACE_TIMER_START		0x000a
+#define SYS_TRACE_TIMER_STOP		0x000b
+#define SYS_TRACE_TIMER_EXPIRY		0x000c
+
+/** First event ID available to applications. */
+#define SYS_TRACE_USER			0x0100
+
+#define SYS_TRACE_MAGIC			0x5a545243 /* "ZTRC" */
+#define SYS_TRACE_VERSION		1
+
+#ifndef _ASMLANGUAGE
+
+#include <zephyr/types.h>
+
+/**
+ * @brief Trace record.
+ *
+ * The meaning of @a obj and @a arg depends on the event. @a seq holds the
+ * low bits of the record's index once it is complete.
+ */
+struct sys_trace_record {
+	u32_t timestamp;
+	u16_t id;
+	u16_t seq;
+	u32_t obj;
+	u32_t arg;
+};
+
+#ifdef CONFIG_KERNEL_TRACE
+extern void _sys_trace_context_switch(void);
+extern void _sys_trace_isr_enter(void *isr);
+extern void _sys_trace_isr_exit(void);
+
+/**
+ * @brief Record an event in the trace buffer.
+ *
+ * Callable from any context, without locking interrupts.
+ *
+ * @param id Event ID, from SYS_TRACE_USER for application events.
+ * @param obj Object the event is about.
+ * @param arg Event argument.
+ */
+extern void sys_trace_event(u16_t id, const void *obj, u32_t arg);
+
+/**
+ * @brief Start or stop recording events.
+ *
+ * Events are recorded from boot on. Stopping freezes the buffer, e.g. to
+ * dump it right after a problem was detected.
+ *
+ * @param enable 1 to record events, 0 to stop.
+ */
+extern void sys_trace_enable(int enable);
+
+/**
+ * @brief Get the index the next record will have.
+ *
+ * The records still in the buffer are the last CONFIG_KERNEL_TRACE_RECORDS
+ * ones before that index.
+ */
+extern u32_t sys_trace_head(void);
+
+/**
+ * @brief Read a record from the trace buffer.
+ *
+ * @param index Index of the record.
+ * @param record Address where to copy the record.
+ *
+ * @retval 0 Record read.
+ * @retval -ENOENT Record overwritten, or not complete yet.
+ */
+extern int sys_trace_get(u32_t index, struct sys_trace_record *record);
+#else
+static inline void sys_trace_event(u16_t id, const void *obj, u32_t arg) {}
+#endif /* CONFIG_KERNEL_TRACE */
+
+#endif /* !_ASMLANGUAGE */
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* __KERNEL_TRACE_H__ */
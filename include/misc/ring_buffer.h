@@ -209,6 +209,205 @@ int sys_ring_buf_get(struct ring_buf *buf, u16_t *type, u8_t *value,
  * @}
  */
 
+/**
+ * @brief A structure to represent a byte ring buffer
+ *
+ * The producer only writes @a tail and @a put_tail, and the consumer only
+ * writes @a head and @a get_head: with a single producer and a single
+ * consumer, e.g. an ISR and a thread, no locking is needed. The indexes run
+ * freely and are masked when accessing @a buf, so the whole buffer can be
+ * filled.
+ */
+struct ring_buf_bytes {
+	u32_t head;	 /**< Index of the first byte not yet consumed */
+	u32_t get_head;  /**< Index after the last byte claimed for reading */
+	u32_t tail;	 /**< Index after the last byte produced */
+	u32_t put_tail;  /**< Index after the last byte claimed for writing */
+	u32_t size;	 /**< Size of buf in bytes, a power of 2 */
+	u8_t *buf;	 /**< Memory region for stored bytes */
+};
+
+/**
+ * @defgroup ring_buffer_bytes_apis Byte Ring Buffer APIs
+ * @ingroup kernel_apis
+ * @{
+ */
+
+/**
+ * @brief Statically define and initialize a byte ring buffer.
+ *
+ * This macro establishes a byte ring buffer of 2^pow bytes, where @a pow is
+ * the specified ring buffer size exponent.
+ *
+ * The ring buffer can be accessed outside the module where it is defined
+ * using:
+ *
+ * @code extern struct ring_buf_bytes <name>; @endcode
+ *
+ * @param name Name of the ring buffer.
+ * @param pow Ring buffer size exponent.
+ */
+#define SYS_RING_BUF_BYTES_DECLARE_POW2(name, pow) \
+	static u8_t _ring_buffer_data_##name[1 << (pow)]; \
+	struct ring_buf_bytes name = { \
+		.size = (1 << (pow)), \
+		.buf = _ring_buffer_data_##name \
+	};
+
+/**
+ * @brief Initialize a byte ring buffer.
+ *
+ * This routine initializes a byte ring buffer, prior to its first use. It is
+ * only used for ring buffers not defined using
+ * SYS_RING_BUF_BYTES_DECLARE_POW2.
+ *
+ * @param buf Address of ring buffer.
+ * @param size Ring buffer size in bytes, which must be a power of 2.
+ * @param data Ring buffer data area (typically u8_t data[size]).
+ */
+static inline void sys_ring_buf_bytes_init(struct ring_buf_bytes *buf,
+					   u32_t size, u8_t *data)
+{
+	__ASSERT(is_power_of_two(size), "size must be a power of 2");
+
+	buf->head = 0;
+	buf->get_head = 0;
+	buf->tail = 0;
+	buf->put_tail = 0;
+	buf->size = size;
+	buf->buf = data;
+}
+
+/**
+ * @brief Determine if a byte ring buffer is empty.
+ *
+ * @param buf Address of ring buffer.
+ *
+ * @return 1 if the ring buffer is empty, or 0 if not.
+ */
+static inline int sys_ring_buf_bytes_is_empty(struct ring_buf_bytes *buf)
+{
+	return (buf->head == buf->tail);
+}
+
+/**
+ * @brief Determine free space in a byte ring buffer.
+ *
+ * @param buf Address of ring buffer.
+ *
+ * @return Ring buffer free space (in bytes).
+ */
+static inline u32_t sys_ring_buf_bytes_space_get(struct ring_buf_bytes *buf)
+{
+	return buf->size - (buf->tail - buf->head);
+}
+
+/**
+ * @brief Claim contiguous space in a byte ring buffer for writing.
+ *
+ * This routine gives direct access to the free space of ring buffer @a buf,
+ * which the producer fills in place before committing it with
+ * sys_ring_buf_bytes_put_finish(). Since the space returned is contiguous,
+ * it may be less than requested when it wraps around the end of the ring
+ * buffer: a second claim then returns the space at its start. Successive
+ * claims are committed together.
+ *
+ * @warning
+ * Only one producer can write to the ring buffer, and only one consumer can
+ * read from it. Either may run in an ISR.
+ *
+ * @param buf Address of ring buffer.
+ * @param data Set to the address of the claimed space.
+ * @param size Number of bytes requested.
+ *
+ * @return Number of bytes claimed, possibly 0 if the ring buffer is full.
+ */
+u32_t sys_ring_buf_bytes_put_claim(struct ring_buf_bytes *buf, u8_t **data,
+				   u32_t size);
+
+/**
+ * @brief Commit bytes written in space claimed from a byte ring buffer.
+ *
+ * This routine makes the first @a size bytes claimed with
+ * sys_ring_buf_bytes_put_claim() available to the consumer. The remaining
+ * claimed space, if any, is released.
+ *
+ * @param buf Address of ring buffer.
+ * @param size Number of bytes written.
+ *
+ * @retval 0 Bytes were committed.
+ * @retval -EINVAL More bytes than claimed.
+ */
+int sys_ring_buf_bytes_put_finish(struct ring_buf_bytes *buf, u32_t size);
+
+/**
+ * @brief Write bytes to a byte ring buffer.
+ *
+ * This routine copies as many bytes as fit from @a data to ring buffer
+ * @a buf.
+ *
+ * @param buf Address of ring buffer.
+ * @param data Address of the bytes.
+ * @param size Number of bytes.
+ *
+ * @return Number of bytes written.
+ */
+u32_t sys_ring_buf_bytes_put(struct ring_buf_bytes *buf, const u8_t *data,
+			     u32_t size);
+
+/**
+ * @brief Claim contiguous bytes of a byte ring buffer for reading.
+ *
+ * This routine gives direct access to the bytes stored in ring buffer
+ * @a buf, which the consumer processes in place before releasing them with
+ * sys_ring_buf_bytes_get_finish(). Since the bytes returned are contiguous,
+ * they may be fewer than requested when they wrap around the end of the
+ * ring buffer: a second claim then returns the bytes at its start.
+ * Successive claims are released together.
+ *
+ * @param buf Address of ring buffer.
+ * @param data Set to the address of the claimed bytes.
+ * @param size Number of bytes requested.
+ *
+ * @return Number of bytes claimed, possibly 0 if the ring buffer is empty.
+ */
+u32_t sys_ring_buf_bytes_get_claim(struct ring_buf_bytes *buf, u8_t **data,
+				   u32_t size);
+
+/**
+ * @brief Release bytes claimed from a byte ring buffer.
+ *
+ * This routine frees the first @a size bytes claimed with
+ * sys_ring_buf_bytes_get_claim() for the producer. The remaining claimed
+ * bytes, if any, are left in the ring buffer.
+ *
+ * @param buf Address of ring buffer.
+ * @param size Number of bytes consumed.
+ *
+ * @retval 0 Bytes were released.
+ * @retval -EINVAL More bytes than claimed.
+ */
+int sys_ring_buf_bytes_get_finish(struct ring_buf_bytes *buf, u32_t size);
+
+/**
+ * @brief Read bytes from a byte ring buffer.
+ *
+ * This routine copies up to @a size bytes from ring buffer @a buf to
+ * @a data.
+ *
+ * @param buf Address of ring buffer.
+ * @param data Area to store the bytes.
+ * @param size Size of the area.
+ *
+ * @return Number of bytes read.
+ */
+u32_t sys_ring_buf_bytes_get(struct ring_buf_bytes *buf, u8_t *data,
+			     u32_t size);
+
+/**
+ * @}
+ */
+
 #ifdef __cplusplus
 }
 #endif
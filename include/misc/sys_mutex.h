@@ -0,0 +1,126 @@
+/*
+ * Copyright (c) 2017 Intel Corporation
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+/**
+ * @file
+ * @brief Futex-based mutex
+ *
+ * A sys_mutex is a mutex whose state lives in the memory of the threads
+ * using it: locking and unlocking an uncontended sys_mutex are single
+ * atomic operations, so that user threads do not make system calls unless
+ * they have to wait for the mutex, or to wake a waiting thread.
+ *
+ * Unlike k_mutex, a sys_mutex is not recursive, does not track its owner
+ * and does not implement priority inheritance.
+ */
+
+#ifndef __SYS_MUTEX_H__
+#define __SYS_MUTEX_H__
+
+#include <kernel.h>
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+#define SYS_MUTEX_UNLOCKED	0
+#define SYS_MUTEX_LOCKED	1
+#define SYS_MUTEX_CONTENDED	2 /* locked, and threads may be waiting */
+
+/**
+ * @brief Futex-based mutex.
+ *
+ * Must be in memory the threads using it can write to.
+ */
+struct sys_mutex {
+	atomic_t val;
+};
+
+/**
+ * @defgroup sys_mutex_apis Futex-based Mutex APIs
+ * @ingroup kernel_apis
+ * @{
+ */
+
+/**
+ * @brief Statically define and initialize a futex-based mutex.
+ *
+ * @param name Name of the mutex.
+ */
+#define SYS_MUTEX_DEFINE(name) \
+	struct sys_mutex name = { .val = ATOMIC_INIT(SYS_MUTEX_UNLOCKED) }
+
+/**
+ * @brief Initialize a futex-based mutex.
+ *
+ * @param mutex Address of the mutex.
+ *
+ * @return N/A
+ */
+static inline void sys_mutex_init(struct sys_mutex *mutex)
+{
+	atomic_set(&mutex->val, SYS_MUTEX_UNLOCKED);
+}
+
+extern int _sys_mutex_lock_contended(struct sys_mutex *mutex, s32_t timeout);
+extern void _sys_mutex_unlock_contended(struct sys_mutex *mutex);
+
+/**
+ * @brief Lock a futex-based mutex.
+ *
+ * This routine locks @a mutex, waiting for it to be unlocked if it is
+ * locked: the system call to wait is only made in that case. The waiting
+ * period is restarted whenever the thread is woken but another thread
+ * locked the mutex first.
+ *
+ * @param mutex Address of the mutex.
+ * @param timeout Waiting period to lock the mutex (in milliseconds),
+ *                or one of the special values K_NO_WAIT and K_FOREVER.
+ *
+ * @retval 0 Mutex locked.
+ * @retval -EBUSY Returned without waiting.
+ * @retval -EAGAIN Waiting period timed out.
+ */
+static inline int sys_mutex_lock(struct sys_mutex *mutex, s32_t timeout)
+{
+	if (likely(atomic_cas(&mutex->val, SYS_MUTEX_UNLOCKED,
+			      SYS_MUTEX_LOCKED))) {
+		return 0;
+	}
+
+	return _sys_mutex_lock_contended(mutex, timeout);
+}
+
+/**
+ * @brief Unlock a futex-based mutex.
+ *
+ * This routine unlocks @a mutex, which the calling thread must have locked.
+ * The system call to wake a waiting thread is only made if threads may be
+ * waiting.
+ *
+ * @param mutex Address of the mutex.
+ *
+ * @return N/A
+ */
+static inline void sys_mutex_unlock(struct sys_mutex *mutex)
+{
+	if (likely(atomic_cas(&mutex->val, SYS_MUTEX_LOCKED,
+			      SYS_MUTEX_UNLOCKED))) {
+		return;
+	}
+
+	_sys_mutex_unlock_contended(mutex);
+}
+
+/**
+ * @} end defgroup sys_mutex_apis
+ */
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* __SYS_MUTEX_H__ */
@@ -0,0 +1,160 @@
+/*
+ * Copyright (c) 2017 Intel Corporation
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+/**
+ * @file
+ * @brief Futex-based semaphore
+ *
+ * A sys_sem is a counting semaphore whose state lives in the memory of the
+ * threads using it: taking an available sys_sem, and giving a sys_sem no
+ * thread waits on, are atomic operations, so that user threads do not make
+ * system calls unless they have to wait for the semaphore, or to wake a
+ * waiting thread.
+ */
+
+#ifndef __SYS_SEM_H__
+#define __SYS_SEM_H__
+
+#include <kernel.h>
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/**
+ * @brief Futex-based semaphore.
+ *
+ * Must be in memory the threads using it can write to.
+ */
+struct sys_sem {
+	atomic_t count;
+	/* number of threads about to wait, or waiting, on count */
+	atomic_t waiters;
+	atomic_val_t limit;
+};
+
+/**
+ * @defgroup sys_sem_apis Futex-based Semaphore APIs
+ * @ingroup kernel_apis
+ * @{
+ */
+
+/**
+ * @brief Statically define and initialize a futex-based semaphore.
+ *
+ * @param name Name of the semaphore.
+ * @param initial_count Initial semaphore count.
+ * @param count_limit Maximum permitted semaphore count.
+ */
+#define SYS_SEM_DEFINE(name, initial_count, count_limit) \
+	struct sys_sem name = { \
+		.count = ATOMIC_INIT(initial_count), \
+		.waiters = ATOMIC_INIT(0), \
+		.limit = count_limit, \
+	}
+
+/**
+ * @brief Initialize a futex-based semaphore.
+ *
+ * @param sem Address of the semaphore.
+ * @param initial_count Initial semaphore count.
+ * @param limit Maximum permitted semaphore count.
+ *
+ * @retval 0 Semaphore initialized.
+ * @retval -EINVAL Invalid count or limit.
+ */
+static inline int sys_sem_init(struct sys_sem *sem, unsigned int initial_count,
+			       unsigned int limit)
+{
+	if (limit == 0 || limit > INT_MAX || initial_count > limit) {
+		return -EINVAL;
+	}
+
+	atomic_set(&sem->count, initial_count);
+	atomic_set(&sem->waiters, 0);
+	sem->limit = limit;
+
+	return 0;
+}
+
+extern int _sys_sem_take_contended(struct sys_sem *sem, s32_t timeout);
+
+/**
+ * @brief Take a futex-based semaphore.
+ *
+ * This routine takes @a sem, waiting for it to be given if its count is
+ * zero: the system call to wait is only made in that case. The waiting
+ * period is restarted whenever the thread is woken but another thread
+ * took the semaphore first.
+ *
+ * @param sem Address of the semaphore.
+ * @param timeout Waiting period to take the semaphore (in milliseconds),
+ *                or one of the special values K_NO_WAIT and K_FOREVER.
+ *
+ * @retval 0 Semaphore taken.
+ * @retval -EBUSY Returned without waiting.
+ * @retval -EAGAIN Waiting period timed out.
+ */
+static inline int sys_sem_take(struct sys_sem *sem, s32_t timeout)
+{
+	atomic_val_t count = atomic_get(&sem->count);
+
+	if (likely(count > 0 && atomic_cas(&sem->count, count, count - 1))) {
+		return 0;
+	}
+
+	return _sys_sem_take_contended(sem, timeout);
+}
+
+/**
+ * @brief Give a futex-based semaphore.
+ *
+ * This routine gives @a sem, unless the semaphore is already at its maximum
+ * permitted count. The system call to wake a waiting thread is only made if
+ * threads may be waiting.
+ *
+ * @param sem Address of the semaphore.
+ *
+ * @return N/A
+ */
+static inline void sys_sem_give(struct sys_sem *sem)
+{
+	atomic_val_t count;
+
+	do {
+		count = atomic_get(&sem->count);
+		if (count == sem->limit) {
+			/* nobody waits on a semaphore that is available */
+			return;
+		}
+	} while (!atomic_cas(&sem->count, count, count + 1));
+
+	if (atomic_get(&sem->waiters) != 0) {
+		k_futex_wake(&sem->count, 0);
+	}
+}
+
+/**
+ * @brief Get a futex-based semaphore's count.
+ *
+ * @param sem Address of the semaphore.
+ *
+ * @return Current semaphore count.
+ */
+static inline unsigned int sys_sem_count_get(struct sys_sem *sem)
+{
+	return atomic_get(&sem->count);
+}
+
+/**
+ * @} end defgroup sys_sem_apis
+ */
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* __SYS_SEM_H__ */
@@ -20,6 +20,9 @@ extern "C" {
 
 #define SYS_PM_NOT_HANDLED		SYS_PM_ACTIVE_STATE
 
+/* Idle governor index of the plain CPU idle, without _sys_soc_suspend() */
+#define SYS_PM_IDLE_CPU			(-1)
+
 extern unsigned char _sys_pm_idle_exit_notify;
 
 /**
@@ -115,6 +118,150 @@ extern int _sys_soc_suspend(s32_t ticks);
  * @}
  */
 
+#ifdef CONFIG_SYS_POWER_IDLE_GOVERNOR
+
+/**
+ * @brief Idle Governor Interface
+ *
+ * @defgroup power_management_idle_governor Idle Governor Interface
+ * @ingroup power_management_api
+ * @{
+ */
+
+/* Wake sources that are not identified by an interrupt handler */
+#define SYS_PM_IDLE_WAKE_TIMER		((void *)0)
+#define SYS_PM_IDLE_WAKE_UNKNOWN	((void *)-1)
+
+/**
+ * @brief Low power state the idle governor can choose
+ */
+struct sys_pm_idle_state {
+	const char *name;
+	/* time taken to resume from the state, in microseconds */
+	u32_t exit_latency_us;
+	/* shortest idle time for which the state saves power, in microseconds */
+	u32_t min_residency_us;
+};
+
+/**
+ * @brief Residency statistics of a low power state
+ */
+struct sys_pm_idle_state_stats {
+	/* number of times the state was entered */
+	u32_t entries;
+	/* total time spent idle in the state, in microseconds */
+	u64_t residency_us;
+	/* idles shorter than the minimum residency of the state */
+	u32_t too_short;
+	/* idles long enough for the next deeper state */
+	u32_t too_long;
+};
+
+/**
+ * @brief Source of the wakes from idle
+ */
+struct sys_pm_idle_wake_source {
+	/* interrupt handler, SYS_PM_IDLE_WAKE_TIMER or SYS_PM_IDLE_WAKE_UNKNOWN */
+	void *source;
+	/* number of wakes from idle */
+	u32_t wakes;
+	/* average interval between two wakes, in microseconds */
+	u32_t interval_us;
+	/* average deviation from that interval, in microseconds */
+	u32_t deviation_us;
+};
+
+/**
+ * @brief Set the low power states the idle governor chooses from
+ *
+ * The states are ordered from the shallowest to the deepest. Each time the
+ * kernel idles, the governor predicts how long the idle will last from the
+ * next timeout, the idle durations seen lately and the patterns of the
+ * interrupts waking the CPU. It then chooses the deepest state whose minimum
+ * residency fits the prediction and whose exit latency is acceptable, which
+ * _sys_soc_suspend() gets with sys_pm_idle_state_get(). If no state fits,
+ * the kernel idles the CPU without calling _sys_soc_suspend().
+ *
+ * Until this function is called, a single state with no latency is assumed,
+ * and _sys_soc_suspend() is called on every idle.
+ *
+ * @param states Array of states, which must remain valid.
+ * @param num Number of states, at most CONFIG_SYS_POWER_IDLE_GOVERNOR_STATES.
+ *
+ * @retval 0 If successful.
+ * @retval -EINVAL If there are too few or too many states.
+ */
+extern int sys_pm_idle_states_set(const struct sys_pm_idle_state *states,
+				  int num);
+
+/**
+ * @brief Get the low power states the idle governor chooses from
+ *
+ * @param states Set to the array of states.
+ *
+ * @return Number of states.
+ */
+extern int sys_pm_idle_states_get(const struct sys_pm_idle_state **states);
+
+/**
+ * @brief Limit the exit latency of the states the idle governor chooses
+ *
+ * @param latency_us Longest acceptable exit latency, in microseconds.
+ */
+extern void sys_pm_idle_latency_max_set(u32_t latency_us);
+
+/**
+ * @brief Get the low power state chosen for the upcoming idle
+ *
+ * This function is meant to be called from _sys_soc_suspend().
+ *
+ * @return Index of the state in the array of states.
+ */
+extern int sys_pm_idle_state_get(void);
+
+/**
+ * @brief Get the predicted length of the upcoming idle
+ *
+ * This function is meant to be called from _sys_soc_suspend().
+ *
+ * @return Predicted idle time, in microseconds.
+ */
+extern u32_t sys_pm_idle_prediction_get(void);
+
+/**
+ * @brief Get the residency statistics of a low power state
+ *
+ * @param state Index of the state, or SYS_PM_IDLE_CPU.
+ * @param stats Statistics, filled by this function.
+ *
+ * @retval 0 If successful.
+ * @retval -EINVAL If the state does not exist.
+ */
+extern int sys_pm_idle_stats_get(int state,
+				 struct sys_pm_idle_state_stats *stats);
+
+/**
+ * @brief Get the sources of the wakes from idle
+ *
+ * @param sources Array of at least @a max elements, filled by this function.
+ * @param max Number of elements of @a sources.
+ *
+ * @return Number of elements filled.
+ */
+extern int sys_pm_idle_wake_sources_get(struct sys_pm_idle_wake_source *sources,
+					int max);
+
+/**
+ * @brief Forget the idle history and statistics
+ */
+extern void sys_pm_idle_stats_reset(void);
+
+/**
+ * @}
+ */
+
+#endif /* CONFIG_SYS_POWER_IDLE_GOVERNOR */
+
 #endif /* CONFIG_SYS_POWER_MANAGEMENT */
 
 #ifdef __cplusplus
@@ -0,0 +1,144 @@
+/*
+ * Copyright (c) 2017 Intel Corporation
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+/**
+ * @file
+ *
+ * @brief Kernel spinlocks
+ *
+ * A spinlock protects a specific piece of kernel state, where irq_lock()
+ * protects everything at once. Code taking a spinlock states what it is
+ * serializing against, which is what a multiprocessor port needs to turn the
+ * lock into a real lock word spun on by the other CPUs.
+ *
+ * On a uniprocessor system, which is all the kernel supports for now, holding
+ * a spinlock is exactly the same as holding an interrupt lock, and costs the
+ * same. With CONFIG_SPIN_VALIDATE, the kernel also asserts that a spinlock
+ * is never taken recursively nor released by a thread that does not hold it.
+ */
+
+#ifndef _SPINLOCK_H_
+#define _SPINLOCK_H_
+
+#include <kernel.h>
+#include <misc/__assert.h>
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/**
+ * @defgroup spinlock_apis Spinlock APIs
+ * @ingroup kernel_apis
+ * @{
+ */
+
+/**
+ * @brief Kernel spinlock
+ *
+ * Must be zero-initialized, e.g. by being a static variable.
+ */
+struct k_spinlock {
+#ifdef CONFIG_SPIN_VALIDATE
+	/* thread holding the lock, NULL when the lock is free */
+	struct k_thread *thread;
+
+	/* set when the lock is held */
+	int held;
+#endif
+#if defined(__cplusplus) && !defined(CONFIG_SPIN_VALIDATE)
+	/* C++ does not allow empty structures */
+	char dummy;
+#endif
+};
+
+/**
+ * @brief Spinlock key
+ *
+ * Returned by k_spin_lock(), and given back to k_spin_unlock() to restore
+ * the interrupt state that was in effect when the lock was taken.
+ */
+typedef struct {
+	unsigned int key;
+} k_spinlock_key_t;
+
+/**
+ * @brief Take a spinlock.
+ *
+ * Locks out interrupts on the current CPU, then takes the lock. Spinlocks
+ * do not nest: a thread must not take a lock it already holds.
+ *
+ * @param l Spinlock to take.
+ *
+ * @return Key to pass to k_spin_unlock().
+ */
+static ALWAYS_INLINE k_spinlock_key_t k_spin_lock(struct k_spinlock *l)
+{
+	k_spinlock_key_t k;
+
+	ARG_UNUSED(l);
+
+	k.key = irq_lock();
+
+#ifdef CONFIG_SPIN_VALIDATE
+	__ASSERT(!l->held, "recursive spinlock %p", l);
+	l->held = 1;
+	l->thread = k_current_get();
+#endif
+
+	return k;
+}
+
+/**
+ * @brief Release a spinlock without restoring interrupts.
+ *
+ * Used when the interrupt lock is handed over to another piece of code,
+ * typically a context switch, that unlocks interrupts itself.
+ *
+ * @param l Spinlock to release.
+ *
+ * @return N/A
+ */
+static ALWAYS_INLINE void k_spin_release(struct k_spinlock *l)
+{
+	ARG_UNUSED(l);
+
+#ifdef CONFIG_SPIN_VALIDATE
+	__ASSERT(l->held, "releasing spinlock %p which is not held", l);
+	__ASSERT(l->thread == k_current_get(),
+		 "spinlock %p released by a thread not holding it", l);
+	l->held = 0;
+	l->thread = NULL;
+#endif
+}
+
+/**
+ * @brief Release a spinlock.
+ *
+ * Releases the lock, then restores the interrupt state in effect when the
+ * matching k_spin_lock() was called.
+ *
+ * @param l Spinlock to release.
+ * @param key Key returned by k_spin_lock().
+ *
+ * @return N/A
+ */
+static ALWAYS_INLINE void k_spin_unlock(struct k_spinlock *l,
+				       k_spinlock_key_t key)
+{
+	k_spin_release(l);
+	irq_unlock(key.key);
+}
+
+/**
+ * @}
+ */
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* _SPINLOCK_H_ */
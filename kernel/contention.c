@@ -0,0 +1,118 @@
+/*
+ * Copyright (c) 2017 Intel Corporation
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+/**
+ * @file
+ *
+ * @brief Contention statistics of mutexes and semaphores
+ *
+ * Takes that do not wait are counted inline by the hooks of
+ * kernel/include/contention.h. Waits are recorded here once they end, in
+ * the context of the waiting thread: besides the totals, each object keeps
+ * the threads with the longest total wait, sorted so that the longest comes
+ * first and the shortest is the one evicted by a new waiter.
+ */
+
+#include <kernel.h>
+#include <kernel_structs.h>
+#include <contention.h>
+#include <string.h>
+
+static void top_waiters_update(struct k_contention_stats *stats,
+			       u32_t cycles)
+{
+	struct k_contention_waiter *top = stats->top_waiters;
+	struct k_contention_waiter waiter;
+	int i;
+
+	for (i = 0; i < CONFIG_CONTENTION_TOP_WAITERS - 1; i++) {
+		if (top[i].thread == _current || top[i].thread == NULL) {
+			break;
+		}
+	}
+
+	if (top[i].thread != _current) {
+		/* new waiter, in a free entry or in place of the shortest */
+		if (top[i].thread != NULL && top[i].wait_cycles >= cycles) {
+			return;
+		}
+
+		top[i].thread = _current;
+		top[i].waits = 0;
+		top[i].wait_cycles = 0;
+	}
+
+	top[i].waits++;
+	top[i].wait_cycles += cycles;
+
+	for (waiter = top[i]; i > 0; i--) {
+		if (top[i - 1].wait_cycles >= waiter.wait_cycles) {
+			break;
+		}
+		top[i] = top[i - 1];
+	}
+
+	top[i] = waiter;
+}
+
+void _contention_wait_record(struct k_contention_stats *stats, u32_t start,
+			     int acquired)
+{
+	unsigned int key = irq_lock();
+	u32_t cycles = k_cycle_get_32() - start;
+
+	stats->contended++;
+	stats->wait_cycles += cycles;
+	stats->max_wait_cycles = max(stats->max_wait_cycles, cycles);
+
+	if (acquired) {
+		stats->acquisitions++;
+	} else {
+		stats->failures++;
+	}
+
+	top_waiters_update(stats, cycles);
+
+	irq_unlock(key);
+}
+
+static void contention_get(struct k_contention_stats *stats,
+			   struct k_contention_stats *out)
+{
+	unsigned int key = irq_lock();
+
+	*out = *stats;
+	irq_unlock(key);
+}
+
+static void contention_reset(struct k_contention_stats *stats)
+{
+	unsigned int key = irq_lock();
+
+	memset(stats, 0, sizeof(*stats));
+	irq_unlock(key);
+}
+
+void k_mutex_contention_get(struct k_mutex *mutex,
+			    struct k_contention_stats *stats)
+{
+	contention_get(&mutex->contention, stats);
+}
+
+void k_mutex_contention_reset(struct k_mutex *mutex)
+{
+	contention_reset(&mutex->contention);
+}
+
+void k_sem_contention_get(struct k_sem *sem, struct k_contention_stats *stats)
+{
+	contention_get(&sem->contention, stats);
+}
+
+void k_sem_contention_reset(struct k_sem *sem)
+{
+	contention_reset(&sem->contention);
+}
@@ -8,7 +8,9 @@
 #include <string.h>
 #include <device.h>
 #include <misc/util.h>
+#include <misc/printk.h>
 #include <atomic.h>
+#include <init.h>
 
 extern struct device __device_init_start[];
 extern struct device __device_PRE_KERNEL_1_start[];
@@ -32,6 +34,160 @@ extern u32_t __device_busy_end[];
 #define DEVICE_BUSY_SIZE (__device_busy_end - __device_busy_start)
 #endif
 
+#ifdef CONFIG_DEVICE_INIT_PROFILING
+static struct device_init_record
+	init_records[CONFIG_DEVICE_INIT_PROFILING_RECORDS];
+static atomic_t init_records_count;
+
+static int device_level(struct device *info)
+{
+	int level = _SYS_INIT_LEVEL_PRE_KERNEL_1;
+
+	while (info >= config_levels[level + 1]) {
+		level++;
+	}
+
+	return level;
+}
+#endif
+
+static void device_init(struct device *info, int parallel)
+{
+#ifdef CONFIG_DEVICE_INIT_PROFILING
+	u32_t start = k_cycle_get_32();
+	struct device_init_record *record;
+	int index;
+#endif
+
+	info->config->init(info);
+	_k_object_init(info);
+
+#ifdef CONFIG_DEVICE_INIT_PROFILING
+	index = atomic_inc(&init_records_count);
+	if (index < ARRAY_SIZE(init_records)) {
+		record = &init_records[index];
+		record->dev = info;
+		record->start = start;
+		record->end = k_cycle_get_32();
+		record->level = device_level(info);
+		record->parallel = parallel;
+	}
+#endif
+}
+
+#ifdef CONFIG_DEVICE_INIT_PARALLEL
+extern struct device_init_parallel __device_init_parallel_start[];
+extern struct device_init_parallel __device_init_parallel_end[];
+
+/* devices to initialize, in initialization order */
+static K_FIFO_DEFINE(init_fifo);
+
+static K_THREAD_STACK_ARRAY_DEFINE(init_stacks,
+				   CONFIG_DEVICE_INIT_PARALLEL_THREADS,
+				   CONFIG_DEVICE_INIT_PARALLEL_STACK_SIZE);
+static struct k_thread init_threads[CONFIG_DEVICE_INIT_PARALLEL_THREADS];
+
+static struct device_init_parallel *parallel_init_get(struct device *info)
+{
+	struct device_init_parallel *entry;
+
+	for (entry = __device_init_parallel_start;
+	     entry < __device_init_parallel_end; entry++) {
+		if (entry->dev == info) {
+			return entry;
+		}
+	}
+
+	return NULL;
+}
+
+static void parallel_init_wait(struct device_init_parallel *entry)
+{
+	/* done stays given, for any other waiter */
+	k_sem_take(&entry->done, K_FOREVER);
+	k_sem_give(&entry->done);
+}
+
+static void parallel_init_thread(void *p1, void *p2, void *p3)
+{
+	struct device_init_parallel *entry, *dep;
+	int i;
+
+	ARG_UNUSED(p1);
+	ARG_UNUSED(p2);
+	ARG_UNUSED(p3);
+
+	while (1) {
+		entry = k_fifo_get(&init_fifo, K_FOREVER);
+
+		/*
+		 * Dependencies precede the device in initialization order,
+		 * so were taken by threads before it: waiting on them cannot
+		 * deadlock. Unmarked ones were initialized already.
+		 */
+		for (i = 0; i < entry->num_deps; i++) {
+			__ASSERT(entry->deps[i] < entry->dev,
+				 "dependency initialized after device");
+			dep = parallel_init_get(entry->deps[i]);
+			if (dep) {
+				parallel_init_wait(dep);
+			}
+		}
+
+		device_init(entry->dev, 1);
+		k_sem_give(&entry->done);
+	}
+}
+
+/*
+ * Queue the marked devices of the given levels to the initialization
+ * threads, and initialize the unmarked ones. Must be called from a thread.
+ */
+static void parallel_init_levels(int first, int last)
+{
+	struct device *info;
+	struct device_init_parallel *entry;
+	int i;
+
+	if (first == _SYS_INIT_LEVEL_POST_KERNEL) {
+		for (i = 0; i < ARRAY_SIZE(init_threads); i++) {
+			k_thread_create(&init_threads[i], init_stacks[i],
+					K_THREAD_STACK_SIZEOF(init_stacks[i]),
+					parallel_init_thread, NULL, NULL, NULL,
+					k_thread_priority_get(k_current_get()),
+					0, K_NO_WAIT);
+		}
+	}
+
+	for (info = config_levels[first]; info < config_levels[last + 1];
+	     info++) {
+		entry = parallel_init_get(info);
+		if (entry) {
+			k_fifo_put(&init_fifo, entry);
+		} else if (info >= config_levels[last]) {
+			/* not deferred from a previous level */
+			device_init(info, 0);
+		}
+	}
+
+	/* all devices of the level are initialized at its end */
+	for (info = config_levels[first]; info < config_levels[last + 1];
+	     info++) {
+		entry = parallel_init_get(info);
+		if (entry) {
+			parallel_init_wait(entry);
+		}
+	}
+
+	if (last == _SYS_INIT_LEVEL_APPLICATION) {
+		/* they are waiting for devices to initialize */
+		for (i = 0; i < ARRAY_SIZE(init_threads); i++) {
+			k_thread_abort(&init_threads[i]);
+		}
+	}
+}
+#endif /* CONFIG_DEVICE_INIT_PARALLEL */
+
 /**
  * @brief Execute all the device initialization functions at a given level
  *
@@ -41,20 +197,94 @@ extern u32_t __device_busy_end[];
  * they need to be invoked, with symbols indicating where one level leaves
  * off and the next one begins.
  *
+ * With CONFIG_DEVICE_INIT_PARALLEL, the devices marked with
+ * DEVICE_INIT_PARALLEL() are initialized by helper threads: at the POST_KERNEL
+ * level, along with the marked devices of the PRE_KERNEL levels, which
+ * are deferred until then, or at the APPLICATION level.
+ *
  * @param level init level to run.
  */
 void _sys_device_do_config_level(int level)
 {
 	struct device *info;
 
+#ifdef CONFIG_DEVICE_INIT_PARALLEL
+	if (level == _SYS_INIT_LEVEL_POST_KERNEL) {
+		parallel_init_levels(_SYS_INIT_LEVEL_PRE_KERNEL_1, level);
+		return;
+	}
+	if (level == _SYS_INIT_LEVEL_APPLICATION) {
+		parallel_init_levels(level, level);
+		return;
+	}
+#endif
+
 	for (info = config_levels[level]; info < config_levels[level+1];
 								info++) {
-		struct device_config *device = info->config;
+#ifdef CONFIG_DEVICE_INIT_PARALLEL
+		if (parallel_init_get(info)) {
+			/* deferred until POST_KERNEL */
+			continue;
+		}
+#endif
+		device_init(info, 0);
+	}
+}
+
+#ifdef CONFIG_DEVICE_INIT_PROFILING
+int device_init_profile_get(const struct device_init_record **records)
+{
+	*records = init_records;
+
+	return atomic_get(&init_records_count);
+}
+
+void device_init_profile_show(void)
+{
+	const struct device_init_record *records;
+	int count = device_init_profile_get(&records);
+	int recorded = min(count, ARRAY_SIZE(init_records));
+	u32_t first_start;
+	int i;
+
+	if (recorded == 0) {
+		return;
+	}
+
+	/* records are in completion order, not start order */
+	first_start = records[0].start;
+	for (i = 1; i < recorded; i++) {
+		if ((s32_t)(records[i].start - first_start) < 0) {
+			first_start = records[i].start;
+		}
+	}
+
+	printk("level  start (us)  time (us)  device\n");
 
-		device->init(info);
-		_k_object_init(info);
+	for (i = 0; i < recorded; i++) {
+		const struct device_init_record *record = &records[i];
+		char *name = record->dev->config->name;
+
+		printk("%5u  %10u  %9u  %c ", record->level,
+		       SYS_CLOCK_HW_CYCLES_TO_NS(record->start -
+						 first_start) / 1000,
+		       SYS_CLOCK_HW_CYCLES_TO_NS(record->end -
+						 record->start) / 1000,
+		       record->parallel ? 'P' : ' ');
+		if (name && name[0]) {
+			printk("%s\n", name);
+		} else {
+			/* system initialization function */
+			printk("init function %p\n", record->dev->config->init);
+		}
+	}
+
+	if (count > ARRAY_SIZE(init_records)) {
+		printk("%d more not profiled\n",
+		       count - (int)ARRAY_SIZE(init_records));
 	}
 }
+#endif
 
 struct device *device_get_binding(const char *name)
 {
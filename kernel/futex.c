@@ -0,0 +1,138 @@
+/*
+ * Copyright (c) 2017 Intel Corporation
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+/**
+ * @file
+ *
+ * @brief Kernel futex support.
+ *
+ * A futex is a word of memory, owned by the application, on which threads
+ * can wait for a change of value. The kernel keeps no per-futex state: the
+ * waiting threads are kept in a small table of wait queues, hashed by the
+ * address of the futex word, each thread remembering the address it waits
+ * on. Synchronization primitives built on top of futexes only make system
+ * calls when they have to wait, or to wake a waiting thread.
+ */
+
+#include <kernel.h>
+#include <kernel_structs.h>
+#include <wait_q.h>
+#include <misc/dlist.h>
+#include <ksched.h>
+#include <init.h>
+#include <syscall_handler.h>
+
+/* must be a power of two */
+#define FUTEX_WAIT_QUEUES 16
+
+static _wait_q_t futex_wait_q[FUTEX_WAIT_QUEUES];
+
+static inline _wait_q_t *futex_wait_q_get(atomic_t *addr)
+{
+	return &futex_wait_q[((u32_t)addr / sizeof(atomic_t)) &
+			     (FUTEX_WAIT_QUEUES - 1)];
+}
+
+int _impl_k_futex_wait(atomic_t *addr, atomic_val_t expected, s32_t timeout)
+{
+	unsigned int key;
+	int ret;
+
+	__ASSERT(!_is_in_isr(), "");
+
+	key = irq_lock();
+
+	if (atomic_get(addr) != expected) {
+		irq_unlock(key);
+		return -EAGAIN;
+	}
+
+	if (timeout == K_NO_WAIT) {
+		irq_unlock(key);
+		return -ETIMEDOUT;
+	}
+
+	_current->base.swap_data = addr;
+	_pend_current_thread(futex_wait_q_get(addr), timeout);
+
+	ret = _Swap(key);
+
+	return ret == -EAGAIN ? -ETIMEDOUT : ret;
+}
+
+int _impl_k_futex_wake(atomic_t *addr, int wake_all)
+{
+	_wait_q_t *wait_q = futex_wait_q_get(addr);
+	struct k_thread *thread, *next;
+	unsigned int key;
+	int woken = 0;
+
+	key = irq_lock();
+
+	/* threads waiting on other futexes share the wait queue */
+	SYS_DLIST_FOR_EACH_CONTAINER_SAFE(wait_q, thread, next, base.k_q_node) {
+		if (thread->base.swap_data != addr) {
+			continue;
+		}
+
+		_unpend_thread(thread);
+		(void)_abort_thread_timeout(thread);
+		_ready_thread(thread);
+		_set_thread_return_value(thread, 0);
+		woken++;
+
+		if (!wake_all) {
+			break;
+		}
+	}
+
+	if (woken && !_is_in_isr()) {
+		_reschedule_threads(key);
+	} else {
+		irq_unlock(key);
+	}
+
+	return woken;
+}
+
+#ifdef CONFIG_USERSPACE
+u32_t _handler_k_futex_wait(u32_t addr, u32_t expected, u32_t timeout,
+			    u32_t arg4, u32_t arg5, u32_t arg6, void *ssf)
+{
+	_SYSCALL_ARG3;
+
+	_SYSCALL_VERIFY(!(addr & (sizeof(atomic_t) - 1)), ssf);
+	_SYSCALL_MEMORY(addr, sizeof(atomic_t), 1, ssf);
+
+	return _impl_k_futex_wait((atomic_t *)addr, expected, timeout);
+}
+
+u32_t _handler_k_futex_wake(u32_t addr, u32_t wake_all, u32_t arg3,
+			    u32_t arg4, u32_t arg5, u32_t arg6, void *ssf)
+{
+	_SYSCALL_ARG2;
+
+	_SYSCALL_VERIFY(!(addr & (sizeof(atomic_t) - 1)), ssf);
+	_SYSCALL_MEMORY(addr, sizeof(atomic_t), 1, ssf);
+
+	return _impl_k_futex_wake((atomic_t *)addr, wake_all);
+}
+#endif /* CONFIG_USERSPACE */
+
+static int init_futex_module(struct device *dev)
+{
+	int i;
+
+	ARG_UNUSED(dev);
+
+	for (i = 0; i < FUTEX_WAIT_QUEUES; i++) {
+		sys_dlist_init(&futex_wait_q[i]);
+	}
+
+	return 0;
+}
+
+SYS_INIT(init_futex_module, PRE_KERNEL_1, CONFIG_KERNEL_INIT_PRIORITY_OBJECTS);
@@ -0,0 +1,366 @@
+/*
+ * Copyright (c) 2017 Intel Corporation
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+/**
+ * @file
+ *
+ * @brief Two-level segregated fit (TLSF) heap backend for k_malloc().
+ *
+ * Free blocks are kept in segregated lists, indexed by a first level, the
+ * power of two of their size, and a second level that splits each power of
+ * two range linearly in TLSF_SL_COUNT lists. One bitmap tells which first
+ * level ranges have free blocks, and one bitmap per first level tells which
+ * of its lists are not empty, so that finding a free block large enough
+ * takes two find-first-set operations: allocating and freeing are O(1).
+ *
+ * An allocation only rounds the request up to the size class of its second
+ * level list, splits the block it gets and gives the remainder back to the
+ * free lists. A freed block is merged with its free physical neighbours
+ * right away. Each block is preceded by a two-word header.
+ */
+
+#include <kernel.h>
+#include <init.h>
+#include <misc/__assert.h>
+#include <string.h>
+
+#if (CONFIG_HEAP_MEM_POOL_SIZE > 0)
+
+#define TLSF_ALIGN 8
+#define TLSF_ALIGN_LOG2 3
+
+/* number of second level lists per first level, as a power of two */
+#define TLSF_SL_LOG2 4
+#define TLSF_SL_COUNT (1 << TLSF_SL_LOG2)
+
+/* blocks smaller than that are all in first level 0, in linear lists */
+#define TLSF_FL_SHIFT (TLSF_SL_LOG2 + TLSF_ALIGN_LOG2)
+#define TLSF_SMALL_BLOCK (1 << TLSF_FL_SHIFT)
+
+#define TLSF_LOG2(x) (31 - __builtin_clz(x))
+
+/* enough first levels for a block as large as the whole heap */
+#define TLSF_FL_COUNT \
+	(CONFIG_HEAP_MEM_POOL_SIZE < TLSF_SMALL_BLOCK ? 1 : \
+	 TLSF_LOG2(CONFIG_HEAP_MEM_POOL_SIZE) - TLSF_FL_SHIFT + 2)
+
+struct tlsf_block {
+	/* block right before this one in memory, NULL for the first one */
+	struct tlsf_block *prev_phys;
+
+	/* size of the payload in bytes, TLSF_FREE set if the block is free */
+	size_t size;
+
+	/* payload; free list links while the block is free */
+	struct tlsf_block *next_free;
+	struct tlsf_block *prev_free;
+};
+
+#define TLSF_FREE 1
+#define TLSF_HDR_SIZE offsetof(struct tlsf_block, next_free)
+#define TLSF_MIN_SIZE (sizeof(struct tlsf_block) - TLSF_HDR_SIZE)
+
+static char __aligned(TLSF_ALIGN) heap_buf[CONFIG_HEAP_MEM_POOL_SIZE];
+
+static struct {
+	u32_t fl_bitmap;
+	u32_t sl_bitmap[TLSF_FL_COUNT];
+	struct tlsf_block *free[TLSF_FL_COUNT][TLSF_SL_COUNT];
+} tlsf;
+
+static size_t block_size(struct tlsf_block *block)
+{
+	return block->size & ~TLSF_FREE;
+}
+
+static bool block_is_free(struct tlsf_block *block)
+{
+	return block->size & TLSF_FREE;
+}
+
+static void *block_payload(struct tlsf_block *block)
+{
+	return (char *)block + TLSF_HDR_SIZE;
+}
+
+static struct tlsf_block *payload_block(void *ptr)
+{
+	return (struct tlsf_block *)((char *)ptr - TLSF_HDR_SIZE);
+}
+
+/* the last block is a used, zero-sized sentinel: never called on it */
+static struct tlsf_block *block_next_phys(struct tlsf_block *block)
+{
+	return (struct tlsf_block *)((char *)block_payload(block) +
+				     block_size(block));
+}
+
+/* list a free block of that size belongs to */
+static void mapping_insert(size_t size, int *fl, int *sl)
+{
+	if (size < TLSF_SMALL_BLOCK) {
+		*fl = 0;
+		*sl = size / (TLSF_SMALL_BLOCK / TLSF_SL_COUNT);
+	} else {
+		int log2 = TLSF_LOG2(size);
+
+		*sl = (size >> (log2 - TLSF_SL_LOG2)) ^ TLSF_SL_COUNT;
+		*fl = log2 - TLSF_FL_SHIFT + 1;
+	}
+}
+
+/*
+ * First list whose blocks are all large enough for that size: round the
+ * size up to the next list boundary, so that any block found fits.
+ */
+static void mapping_search(size_t size, int *fl, int *sl)
+{
+	if (size >= TLSF_SMALL_BLOCK) {
+		size += (1 << (TLSF_LOG2(size) - TLSF_SL_LOG2)) - 1;
+	}
+
+	mapping_insert(size, fl, sl);
+}
+
+static struct tlsf_block *find_suitable_block(int *fl, int *sl)
+{
+	u32_t sl_map, fl_map;
+
+	if (*fl >= TLSF_FL_COUNT) {
+		return NULL;
+	}
+
+	sl_map = tlsf.sl_bitmap[*fl] & (~0U << *sl);
+	if (!sl_map) {
+		/* none in this range: take the next larger range */
+		fl_map = *fl + 1 < 32 ? tlsf.fl_bitmap & (~0U << (*fl + 1)) : 0;
+		if (!fl_map) {
+			return NULL;
+		}
+
+		*fl = find_lsb_set(fl_map) - 1;
+		sl_map = tlsf.sl_bitmap[*fl];
+	}
+
+	*sl = find_lsb_set(sl_map) - 1;
+
+	return tlsf.free[*fl][*sl];
+}
+
+/*
+ * Fallback when no list holds only blocks large enough: the list the size
+ * itself maps to may still have one, e.g. the block covering the whole heap.
+ * Only its head is checked, to stay O(1).
+ */
+static struct tlsf_block *find_block_in_size_list(size_t size)
+{
+	struct tlsf_block *block;
+	int fl, sl;
+
+	mapping_insert(size, &fl, &sl);
+	if (fl >= TLSF_FL_COUNT) {
+		return NULL;
+	}
+
+	block = tlsf.free[fl][sl];
+
+	return block && block_size(block) >= size ? block : NULL;
+}
+
+static void insert_free_block(struct tlsf_block *block)
+{
+	int fl, sl;
+	struct tlsf_block *head;
+
+	mapping_insert(block_size(block), &fl, &sl);
+
+	head = tlsf.free[fl][sl];
+	block->next_free = head;
+	block->prev_free = NULL;
+	if (head) {
+		head->prev_free = block;
+	}
+	tlsf.free[fl][sl] = block;
+
+	tlsf.fl_bitmap |= BIT(fl);
+	tlsf.sl_bitmap[fl] |= BIT(sl);
+}
+
+static void remove_free_block(struct tlsf_block *block)
+{
+	int fl, sl;
+
+	mapping_insert(block_size(block), &fl, &sl);
+
+	if (block->prev_free) {
+		block->prev_free->next_free = block->next_free;
+	} else {
+		tlsf.free[fl][sl] = block->next_free;
+	}
+
+	if (block->next_free) {
+		block->next_free->prev_free = block->prev_free;
+	}
+
+	if (!tlsf.free[fl][sl]) {
+		tlsf.sl_bitmap[fl] &= ~BIT(sl);
+		if (!tlsf.sl_bitmap[fl]) {
+			tlsf.fl_bitmap &= ~BIT(fl);
+		}
+	}
+}
+
+static int init_heap_tlsf(struct device *unused)
+{
+	ARG_UNUSED(unused);
+
+	struct tlsf_block *first = (struct tlsf_block *)heap_buf;
+	struct tlsf_block *last;
+
+	/*
+	 * The sentinel is only a header, but it is accessed as a whole
+	 * struct tlsf_block: leave room for one at the end of the heap.
+	 */
+	first->prev_phys = NULL;
+	first->size = ((sizeof(heap_buf) - TLSF_HDR_SIZE -
+			sizeof(struct tlsf_block)) &
+		       ~(TLSF_ALIGN - 1)) | TLSF_FREE;
+
+	last = block_next_phys(first);
+	last->prev_phys = first;
+	last->size = 0;
+
+	insert_free_block(first);
+
+	return 0;
+}
+
+SYS_INIT(init_heap_tlsf, PRE_KERNEL_1, CONFIG_KERNEL_INIT_PRIORITY_OBJECTS);
+
+void *k_malloc(size_t size)
+{
+	struct tlsf_block *block, *rem;
+	size_t bsize;
+	int fl, sl;
+	int key;
+
+	if (size > sizeof(heap_buf)) {
+		return NULL;
+	}
+
+	size = (size + TLSF_ALIGN - 1) & ~(TLSF_ALIGN - 1);
+	if (size < TLSF_MIN_SIZE) {
+		size = TLSF_MIN_SIZE;
+	}
+
+	mapping_search(size, &fl, &sl);
+
+	key = irq_lock();
+
+	block = find_suitable_block(&fl, &sl);
+	if (!block) {
+		block = find_block_in_size_list(size);
+	}
+	if (!block) {
+		irq_unlock(key);
+		return NULL;
+	}
+
+	remove_free_block(block);
+	bsize = block_size(block);
+
+	/* give back what is left, if it can make a block of its own */
+	if (bsize >= size + TLSF_HDR_SIZE + TLSF_MIN_SIZE) {
+		rem = (struct tlsf_block *)((char *)block_payload(block) + size);
+		rem->prev_phys = block;
+		rem->size = (bsize - size - TLSF_HDR_SIZE) | TLSF_FREE;
+		block_next_phys(rem)->prev_phys = rem;
+		insert_free_block(rem);
+
+		bsize = size;
+	}
+
+	block->size = bsize;
+
+	irq_unlock(key);
+
+	return block_payload(block);
+}
+
+void k_free(void *ptr)
+{
+	struct tlsf_block *block, *neighbor;
+	int key;
+
+	if (ptr == NULL) {
+		return;
+	}
+
+	block = payload_block(ptr);
+
+	__ASSERT((char *)ptr > heap_buf &&
+		 (char *)ptr < heap_buf + sizeof(heap_buf),
+		 "%p not allocated from the heap", ptr);
+
+	key = irq_lock();
+
+	__ASSERT(!block_is_free(block), "double free of %p", ptr);
+
+	/* merge with the free neighbors, so that no two free blocks touch */
+	neighbor = block->prev_phys;
+	if (neighbor && block_is_free(neighbor)) {
+		remove_free_block(neighbor);
+		neighbor->size += TLSF_HDR_SIZE + block_size(block);
+		block = neighbor;
+	}
+
+	neighbor = block_next_phys(block);
+	if (block_is_free(neighbor)) {
+		remove_free_block(neighbor);
+		block->size += TLSF_HDR_SIZE + block_size(neighbor);
+	}
+
+	block->size |= TLSF_FREE;
+	block_next_phys(block)->prev_phys = block;
+	insert_free_block(block);
+
+	irq_unlock(key);
+}
+
+void k_heap_stats_get(struct k_heap_stats *stats)
+{
+	struct tlsf_block *block = (struct tlsf_block *)heap_buf;
+	int key;
+
+	memset(stats, 0, sizeof(*stats));
+
+	/*
+	 * Blocks may be merged under our feet otherwise: interrupts stay
+	 * locked for the whole walk, which is O(number of blocks).
+	 */
+	key = irq_lock();
+
+	while (block_size(block)) {
+		size_t size = block_size(block);
+
+		if (block_is_free(block)) {
+			stats->free_bytes += size;
+			stats->free_blocks++;
+			if (size > stats->max_free_size) {
+				stats->max_free_size = size;
+			}
+		} else {
+			stats->used_bytes += size;
+			stats->used_blocks++;
+		}
+
+		block = block_next_phys(block);
+	}
+
+	irq_unlock(key);
+}
+
+#endif /* CONFIG_HEAP_MEM_POOL_SIZE > 0 */
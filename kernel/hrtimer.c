@@ -0,0 +1,152 @@
+/*
+ * Copyright (c) 2017 Intel Corporation
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+/**
+ * @file
+ *
+ * @brief High-resolution timers
+ *
+ * Running timers are kept in a list sorted by absolute expiry time, in
+ * k_cycle_get_32() cycles, apart from the tick-based timeout queue. Only the
+ * first one is programmed into the system clock driver, which calls back
+ * _hrtimer_announce() from its interrupt handler when that time has come.
+ *
+ * Expiry times are compared as signed differences, so that they can wrap
+ * around with the 32-bit cycle counter.
+ */
+
+#include <kernel.h>
+#include <drivers/system_timer.h>
+
+static sys_dlist_t hrtimers = SYS_DLIST_STATIC_INIT(&hrtimers);
+
+static inline int hrtimer_is_running(struct k_hrtimer *timer)
+{
+	return timer->node.next != NULL;
+}
+
+static void hrtimer_remove(struct k_hrtimer *timer)
+{
+	sys_dlist_remove(&timer->node);
+	timer->node.next = NULL;
+	timer->node.prev = NULL;
+}
+
+/* in expiry order; behind the timers expiring at the same time */
+static void hrtimer_insert(struct k_hrtimer *timer)
+{
+	struct k_hrtimer *in_q;
+
+	SYS_DLIST_FOR_EACH_CONTAINER(&hrtimers, in_q, node) {
+		if ((s32_t)(in_q->expiry - timer->expiry) > 0) {
+			sys_dlist_insert_before(&hrtimers, &in_q->node,
+						&timer->node);
+			return;
+		}
+	}
+
+	sys_dlist_append(&hrtimers, &timer->node);
+}
+
+static void program_first(void)
+{
+	struct k_hrtimer *first;
+	s32_t left;
+
+	first = (struct k_hrtimer *)sys_dlist_peek_head(&hrtimers);
+	if (!first) {
+		return;
+	}
+
+	left = first->expiry - k_cycle_get_32();
+
+	_timer_hr_program(left > 0 ? left : 0);
+}
+
+void k_hrtimer_init(struct k_hrtimer *timer, k_hrtimer_expiry_t expiry_fn)
+{
+	timer->node.next = NULL;
+	timer->node.prev = NULL;
+	timer->expiry_fn = expiry_fn;
+	timer->period = 0;
+	timer->user_data = NULL;
+}
+
+void k_hrtimer_start(struct k_hrtimer *timer, u32_t duration, u32_t period)
+{
+	__ASSERT(duration < 0x80000000, "duration too long");
+
+	unsigned int key = irq_lock();
+
+	if (hrtimer_is_running(timer)) {
+		hrtimer_remove(timer);
+	}
+
+	timer->expiry = k_cycle_get_32() + duration;
+	timer->period = period;
+
+	hrtimer_insert(timer);
+
+	if (sys_dlist_is_head(&hrtimers, &timer->node)) {
+		program_first();
+	}
+
+	irq_unlock(key);
+}
+
+void k_hrtimer_stop(struct k_hrtimer *timer)
+{
+	unsigned int key = irq_lock();
+
+	/*
+	 * The driver is not reprogrammed if it was the first timer: it will
+	 * interrupt for nothing, and program the next one then.
+	 */
+	if (hrtimer_is_running(timer)) {
+		hrtimer_remove(timer);
+	}
+
+	irq_unlock(key);
+}
+
+void _hrtimer_announce(void)
+{
+	struct k_hrtimer *timer;
+	unsigned int key;
+	u32_t now;
+
+	key = irq_lock();
+
+	now = k_cycle_get_32();
+
+	while ((timer = (struct k_hrtimer *)sys_dlist_peek_head(&hrtimers))) {
+		if ((s32_t)(timer->expiry - now) > 0) {
+			break;
+		}
+
+		hrtimer_remove(timer);
+
+		if (timer->period) {
+			timer->expiry += timer->period;
+			if ((s32_t)(timer->expiry - now) <= 0) {
+				/* periods missed: skip them */
+				timer->expiry = now + timer->period;
+			}
+			hrtimer_insert(timer);
+		}
+
+		/* the expiry function may start or stop timers, this one too */
+		irq_unlock(key);
+		timer->expiry_fn(timer);
+		key = irq_lock();
+
+		now = k_cycle_get_32();
+	}
+
+	program_first();
+
+	irq_unlock(key);
+}
@@ -63,6 +63,16 @@ static void set_kernel_idle_time_in_ticks(s32_t ticks)
 #define set_kernel_idle_time_in_ticks(x) do { } while (0)
 #endif
 
+#ifdef CONFIG_SYS_POWER_IDLE_GOVERNOR
+#define idle_governor_enter(ticks) _sys_pm_idle_governor_enter(ticks)
+#define idle_governor_wake() _sys_pm_idle_governor_wake()
+#define idle_governor_exit(state) _sys_pm_idle_governor_exit(state)
+#else
+#define idle_governor_enter(ticks) ((void)(ticks), 0)
+#define idle_governor_wake() do { } while (0)
+#define idle_governor_exit(state) ((void)(state))
+#endif
+
 static void _sys_power_save_idle(s32_t ticks)
 {
 #ifdef CONFIG_TICKLESS_KERNEL
@@ -99,6 +109,23 @@ static void _sys_power_save_idle(s32_t ticks)
 #if (defined(CONFIG_SYS_POWER_LOW_POWER_STATE) || \
 	defined(CONFIG_SYS_POWER_DEEP_SLEEP))
 
+	/*
+	 * Without tickless idle, the next tick ends the idle: that is what
+	 * the idle governor predicts from.
+	 */
+	int state = idle_governor_enter(_must_enter_tickless_idle(ticks) ?
+					ticks : 1);
+
+	if (state < 0) {
+		/*
+		 * The idle is predicted too short for any low power state
+		 * to pay off its exit latency.
+		 */
+		k_cpu_idle();
+		idle_governor_exit(state);
+		return;
+	}
+
 	_sys_pm_idle_exit_notify = 1;
 
 	/*
@@ -116,8 +143,11 @@ static void _sys_power_save_idle(s32_t ticks)
 	 */
 	if (_sys_soc_suspend(ticks) == SYS_PM_NOT_HANDLED) {
 		_sys_pm_idle_exit_notify = 0;
+		state = SYS_PM_IDLE_CPU;
 		k_cpu_idle();
 	}
+
+	idle_governor_exit(state);
 #else
 	k_cpu_idle();
 #endif
@@ -125,6 +155,8 @@ static void _sys_power_save_idle(s32_t ticks)
 
 void _sys_power_save_idle_exit(s32_t ticks)
 {
+	idle_governor_wake();
+
 #if defined(CONFIG_SYS_POWER_LOW_POWER_STATE)
 	/* Some CPU low power states require notification at the ISR
 	 * to allow any operations that needs to be done before kernel
@@ -150,6 +182,23 @@ void _sys_power_save_idle_exit(s32_t ticks)
 #define IDLE_YIELD_IF_COOP() do { } while ((0))
 #endif
 
+#ifdef CONFIG_THREAD_RUNTIME_STATS
+/*
+ * The CPU is idle whenever the idle thread runs: that includes the
+ * interrupts serviced while idle, which are accounted to it.
+ */
+void k_cpu_runtime_stats_get(struct k_cpu_runtime_stats *stats)
+{
+	struct k_thread_runtime_stats idle_stats;
+
+	k_thread_runtime_stats_get(_idle_thread, &idle_stats);
+
+	stats->idle_cycles = idle_stats.running_cycles;
+	stats->total_cycles = k_uptime_get() *
+			      (sys_clock_hw_cycles_per_sec / MSEC_PER_SEC);
+}
+#endif
+
 void idle(void *unused1, void *unused2, void *unused3)
 {
 	ARG_UNUSED(unused1);
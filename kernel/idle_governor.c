@@ -0,0 +1,427 @@
+/*
+ * Copyright (c) 2017 Intel Corporation
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+/**
+ * @file
+ * @brief Predictive idle governor
+ *
+ * Each time the kernel idles, the governor predicts how long the idle will
+ * last and picks the deepest low power state that pays off for that long.
+ * The prediction is the earliest of:
+ *
+ * - the next timeout, which bounds the idle;
+ * - the next wake expected from an interrupt that has been waking the CPU
+ *   periodically;
+ * - the typical duration of the recent idles, when they are steady enough,
+ *   once outliers are discarded.
+ */
+
+#include <kernel.h>
+#include <kernel_structs.h>
+#include <sys_clock.h>
+#include <power.h>
+#include <string.h>
+#include <errno.h>
+
+/* number of recent idle durations kept */
+#define HISTORY_SIZE 8
+
+/* idle durations and intervals are capped, to keep their squares in 64 bits */
+#define DURATION_MAX_US 0x00FFFFFF
+
+/* averages weigh the last sample by 1/8 */
+#define AVG_SHIFT 3
+
+/* number of wakes before a source is trusted to be periodic */
+#define PERIODIC_MIN_WAKES 4
+
+struct wake_source {
+	void *source;
+	u32_t wakes;
+	u32_t last_wake;	/* cycle count */
+	u32_t interval_us;
+	u32_t deviation_us;
+};
+
+/* until the SOC describes its states, _sys_soc_suspend() decides alone */
+static const struct sys_pm_idle_state default_state = { "soc", 0, 0 };
+
+static const struct sys_pm_idle_state *states = &default_state;
+static int num_states = 1;
+static u32_t latency_max_us = DURATION_MAX_US;
+
+/* residency statistics, CPU idle first */
+static struct sys_pm_idle_state_stats
+	state_stats[CONFIG_SYS_POWER_IDLE_GOVERNOR_STATES + 1];
+
+static struct wake_source sources[CONFIG_SYS_POWER_IDLE_GOVERNOR_WAKE_SOURCES];
+
+static u32_t history[HISTORY_SIZE];
+static int history_next;
+static int history_count;
+
+/* ongoing idle */
+static int idle_state;
+static u32_t idle_start;
+static u32_t idle_timer_us;
+static u32_t idle_predicted_us;
+static u32_t idle_wake;
+static void *idle_wake_isr;
+static int idle_woken;
+
+/*
+ * Handler of the interrupt that ended the idle, set by the architecture
+ * interrupt entry code when it knows it, before _sys_power_save_idle_exit().
+ */
+void *_sys_pm_idle_wake_source;
+
+static u32_t cycles_to_us(u32_t cycles)
+{
+	u64_t us = SYS_CLOCK_HW_CYCLES_TO_NS64(cycles) / NSEC_PER_USEC;
+
+	return us > DURATION_MAX_US ? DURATION_MAX_US : (u32_t)us;
+}
+
+/*
+ * Typical idle duration, in the manner of the Linux menu governor: the
+ * recent durations are averaged, and accepted if their standard deviation
+ * is within a sixth of the average. Otherwise the largest durations are
+ * discarded as outliers and the rest tried again, as long as at least
+ * three quarters of the history remain.
+ */
+static u32_t typical_idle_us(void)
+{
+	u32_t limit = DURATION_MAX_US + 1;
+	u64_t sum, variance;
+	u32_t avg, largest;
+	int i, n;
+
+	if (history_count < HISTORY_SIZE) {
+		return DURATION_MAX_US;
+	}
+
+	for (;;) {
+		sum = 0;
+		largest = 0;
+		n = 0;
+
+		for (i = 0; i < HISTORY_SIZE; i++) {
+			if (history[i] < limit) {
+				sum += history[i];
+				largest = max(largest, history[i]);
+				n++;
+			}
+		}
+
+		if (n < HISTORY_SIZE * 3 / 4) {
+			return DURATION_MAX_US;
+		}
+
+		avg = sum / n;
+
+		variance = 0;
+		for (i = 0; i < HISTORY_SIZE; i++) {
+			if (history[i] < limit) {
+				s64_t diff = (s64_t)history[i] - avg;
+
+				variance += diff * diff;
+			}
+		}
+		variance /= n;
+
+		if ((u64_t)avg * avg > 36 * variance) {
+			return avg;
+		}
+
+		limit = largest;
+	}
+}
+
+/*
+ * Time until the next wake expected from a periodic interrupt. A source is
+ * periodic when its intervals deviate by less than a quarter on average,
+ * and is no longer expected once it is late by more than that.
+ */
+static u32_t next_periodic_wake_us(u32_t now)
+{
+	u32_t next = DURATION_MAX_US;
+	u32_t since;
+	int i;
+
+	for (i = 0; i < ARRAY_SIZE(sources); i++) {
+		struct wake_source *s = &sources[i];
+
+		if (s->source == SYS_PM_IDLE_WAKE_TIMER ||
+		    s->wakes < PERIODIC_MIN_WAKES ||
+		    s->deviation_us > s->interval_us / 4) {
+			continue;
+		}
+
+		since = cycles_to_us(now - s->last_wake);
+		if (since > s->interval_us + s->deviation_us) {
+			continue;
+		}
+
+		next = min(next, since < s->interval_us ?
+				 s->interval_us - since : 0);
+	}
+
+	return next;
+}
+
+static void wake_source_update(void *source, u32_t now)
+{
+	struct wake_source *s = NULL;
+	u32_t interval;
+	s32_t diff;
+	int i;
+
+	for (i = 0; i < ARRAY_SIZE(sources); i++) {
+		if (sources[i].wakes != 0 && sources[i].source == source) {
+			s = &sources[i];
+			break;
+		}
+		if (s == NULL || sources[i].wakes < s->wakes) {
+			s = &sources[i];
+		}
+	}
+
+	if (s->wakes == 0 || s->source != source) {
+		/* new source, replacing a free or the least active one */
+		s->source = source;
+		s->wakes = 0;
+	} else {
+		interval = cycles_to_us(now - s->last_wake);
+
+		if (s->wakes == 1) {
+			s->interval_us = interval;
+			s->deviation_us = 0;
+		} else {
+			diff = interval - s->interval_us;
+			s->interval_us += diff >> AVG_SHIFT;
+			diff = (diff < 0 ? -diff : diff) - s->deviation_us;
+			s->deviation_us += diff >> AVG_SHIFT;
+		}
+	}
+
+	s->last_wake = now;
+	s->wakes++;
+}
+
+static int state_allowed(int state)
+{
+	return states[state].exit_latency_us <= latency_max_us;
+}
+
+static int state_select(u32_t predicted_us)
+{
+	int state;
+
+	for (state = num_states - 1; state >= 0; state--) {
+		if (state_allowed(state) &&
+		    states[state].min_residency_us <= predicted_us &&
+		    states[state].exit_latency_us <= predicted_us) {
+			break;
+		}
+	}
+
+	return state;
+}
+
+/* next deeper state the governor may choose, or -1 */
+static int state_deeper(int state)
+{
+	for (state++; state < num_states; state++) {
+		if (state_allowed(state)) {
+			return state;
+		}
+	}
+
+	return -1;
+}
+
+/**
+ * @brief Predict the idle time and choose a low power state
+ *
+ * Called with interrupts locked, when the kernel is about to idle.
+ *
+ * @param ticks Ticks until the next timeout, or K_FOREVER.
+ *
+ * @return Index of the state, or SYS_PM_IDLE_CPU.
+ */
+int _sys_pm_idle_governor_enter(s32_t ticks)
+{
+	u32_t predicted;
+
+	idle_start = k_cycle_get_32();
+	idle_woken = 0;
+
+	if (ticks == K_FOREVER ||
+	    ticks > DURATION_MAX_US / sys_clock_us_per_tick) {
+		idle_timer_us = DURATION_MAX_US;
+	} else {
+		idle_timer_us = ticks * sys_clock_us_per_tick;
+	}
+
+	predicted = min(idle_timer_us, next_periodic_wake_us(idle_start));
+	predicted = min(predicted, typical_idle_us());
+
+	idle_predicted_us = predicted;
+	idle_state = state_select(predicted);
+
+	return idle_state;
+}
+
+/**
+ * @brief Note the wake from idle
+ *
+ * Called from the interrupt that ended the idle, with interrupts locked.
+ */
+void _sys_pm_idle_governor_wake(void)
+{
+	if (!idle_woken) {
+		idle_wake = k_cycle_get_32();
+		idle_wake_isr = _sys_pm_idle_wake_source;
+		idle_woken = 1;
+	}
+
+	_sys_pm_idle_wake_source = NULL;
+}
+
+/**
+ * @brief Account for the idle that just ended
+ *
+ * @param state State actually entered, or SYS_PM_IDLE_CPU.
+ */
+void _sys_pm_idle_governor_exit(int state)
+{
+	struct sys_pm_idle_state_stats *stats = &state_stats[state + 1];
+	unsigned int key = irq_lock();
+	u32_t end = idle_woken ? idle_wake : k_cycle_get_32();
+	u32_t idle_us = cycles_to_us(end - idle_start);
+	void *source;
+	int deeper;
+
+	/* waking within a tick of the timeout means the timer woke us */
+	if (idle_timer_us != DURATION_MAX_US &&
+	    idle_us + sys_clock_us_per_tick >= idle_timer_us) {
+		source = SYS_PM_IDLE_WAKE_TIMER;
+	} else if (idle_woken && idle_wake_isr) {
+		source = idle_wake_isr;
+	} else {
+		source = SYS_PM_IDLE_WAKE_UNKNOWN;
+	}
+
+	wake_source_update(source, end);
+
+	history[history_next] = idle_us;
+	history_next = (history_next + 1) % HISTORY_SIZE;
+	if (history_count < HISTORY_SIZE) {
+		history_count++;
+	}
+
+	stats->entries++;
+	stats->residency_us += idle_us;
+
+	if (state >= 0 && idle_us < states[state].min_residency_us) {
+		stats->too_short++;
+	}
+
+	deeper = state_deeper(state);
+	if (deeper >= 0 && idle_us >= states[deeper].min_residency_us) {
+		stats->too_long++;
+	}
+
+	irq_unlock(key);
+}
+
+int sys_pm_idle_states_set(const struct sys_pm_idle_state *new_states,
+			   int num)
+{
+	unsigned int key;
+
+	if (num < 1 || num > CONFIG_SYS_POWER_IDLE_GOVERNOR_STATES) {
+		return -EINVAL;
+	}
+
+	key = irq_lock();
+	states = new_states;
+	num_states = num;
+	memset(state_stats, 0, sizeof(state_stats));
+	irq_unlock(key);
+
+	return 0;
+}
+
+int sys_pm_idle_states_get(const struct sys_pm_idle_state **states_ptr)
+{
+	*states_ptr = states;
+	return num_states;
+}
+
+void sys_pm_idle_latency_max_set(u32_t latency_us)
+{
+	latency_max_us = latency_us;
+}
+
+int sys_pm_idle_state_get(void)
+{
+	return idle_state;
+}
+
+u32_t sys_pm_idle_prediction_get(void)
+{
+	return idle_predicted_us;
+}
+
+int sys_pm_idle_stats_get(int state, struct sys_pm_idle_state_stats *stats)
+{
+	unsigned int key;
+
+	if (state < SYS_PM_IDLE_CPU || state >= num_states) {
+		return -EINVAL;
+	}
+
+	key = irq_lock();
+	*stats = state_stats[state + 1];
+	irq_unlock(key);
+
+	return 0;
+}
+
+int sys_pm_idle_wake_sources_get(struct sys_pm_idle_wake_source *out, int max)
+{
+	unsigned int key = irq_lock();
+	int i, n = 0;
+
+	for (i = 0; i < ARRAY_SIZE(sources) && n < max; i++) {
+		if (sources[i].wakes == 0) {
+			continue;
+		}
+
+		out[n].source = sources[i].source;
+		out[n].wakes = sources[i].wakes;
+		out[n].interval_us = sources[i].interval_us;
+		out[n].deviation_us = sources[i].deviation_us;
+		n++;
+	}
+
+	irq_unlock(key);
+
+	return n;
+}
+
+void sys_pm_idle_stats_reset(void)
+{
+	unsigned int key = irq_lock();
+
+	memset(state_stats, 0, sizeof(state_stats));
+	memset(sources, 0, sizeof(sources));
+	history_count = 0;
+	history_next = 0;
+
+	irq_unlock(key);
+}
@@ -0,0 +1,68 @@
+/*
+ * Copyright (c) 2017 Intel Corporation
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+#ifndef _kernel_include_contention__h_
+#define _kernel_include_contention__h_
+
+/**
+ * @file
+ * @brief contention statistics hooks of mutexes and semaphores
+ *
+ * The hooks take the object, whose statistics are in its 'contention' field,
+ * and compile to nothing when CONFIG_CONTENTION_STATS is disabled. They must
+ * be called with the object protected, i.e. with interrupts locked for
+ * semaphores and the scheduler locked for mutexes.
+ */
+
+#include <kernel.h>
+#include <string.h>
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+#ifdef CONFIG_CONTENTION_STATS
+
+extern void _contention_wait_record(struct k_contention_stats *stats,
+				    u32_t start, int acquired);
+
+/* the object is initialized, possibly again after being used */
+#define _contention_init(obj) \
+	memset(&(obj)->contention, 0, sizeof((obj)->contention))
+
+/* the object was taken without waiting */
+#define _contention_acquired(obj) ((obj)->contention.acquisitions++)
+
+/* the object was unavailable and the caller did not wait */
+#define _contention_failed(obj) ((obj)->contention.failures++)
+
+/* the priority of the owner was raised for a waiter */
+#define _contention_boost(obj) ((obj)->contention.prio_boosts++)
+
+/* the caller is about to wait, returns the start of the wait */
+#define _contention_wait_start() k_cycle_get_32()
+
+/* the wait that began at 'start' ended, with or without the object */
+#define _contention_wait_end(obj, start, acquired) \
+	_contention_wait_record(&(obj)->contention, start, acquired)
+
+#else
+
+#define _contention_init(obj) do { } while ((0))
+#define _contention_acquired(obj) do { } while ((0))
+#define _contention_failed(obj) do { } while ((0))
+#define _contention_boost(obj) do { } while ((0))
+#define _contention_wait_start() 0
+#define _contention_wait_end(obj, start, acquired) \
+	do { (void)(start); (void)(acquired); } while ((0))
+
+#endif /* CONFIG_CONTENTION_STATS */
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* _kernel_include_contention__h_ */
@@ -50,6 +50,7 @@ GEN_OFFSET_SYM(_thread_base_t, swap_data);
 GEN_OFFSET_SYM(_thread_t, base);
 GEN_OFFSET_SYM(_thread_t, caller_saved);
 GEN_OFFSET_SYM(_thread_t, callee_saved);
+GEN_OFFSET_SYM(_thread_t, arch_hot);
 GEN_OFFSET_SYM(_thread_t, arch);
 
 #ifdef CONFIG_THREAD_STACK_INFO
@@ -85,7 +85,7 @@ struct _kernel {
 	/* currently scheduled thread */
 	struct k_thread *current;
 
-#ifdef CONFIG_SYS_CLOCK_EXISTS
+#if defined(CONFIG_SYS_CLOCK_EXISTS) && !defined(CONFIG_TIMEOUT_QUEUE_WHEEL)
 	/* queue of timeouts */
 	sys_dlist_t timeout_q;
 #endif
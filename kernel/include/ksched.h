@@ -12,6 +12,7 @@
 #ifdef CONFIG_KERNEL_EVENT_LOGGER
 #include <logging/kernel_event_logger.h>
 #endif /* CONFIG_KERNEL_EVENT_LOGGER */
+#include <logging/kernel_trace.h>
 
 extern k_tid_t const _main_thread;
 extern k_tid_t const _idle_thread;
@@ -31,6 +32,15 @@ extern void _update_time_slice_before_swap(void);
 extern s32_t _ms_to_ticks(s32_t ms);
 #endif
 extern void idle(void *, void *, void *);
+#ifdef CONFIG_THREAD_RUNTIME_STATS
+extern void _thread_runtime_stats_switch(void);
+extern void _thread_runtime_stats_ready(struct k_thread *thread);
+extern void _thread_runtime_stats_unready(struct k_thread *thread);
+#endif
+#ifdef CONFIG_INT_LATENCY_BENCHMARK
+extern void _int_latency_thread_ready(struct k_thread *thread);
+extern void _int_latency_context_switch(void);
+#endif
 
 /* find which one is the next thread to run */
 /* must be called with interrupts locked */
@@ -118,9 +128,20 @@ static inline int _is_prio_lower(int prio1, int prio2)
 	return _is_prio1_lower_than_prio2(prio1, prio2);
 }
 
+/*
+ * With CONFIG_SCHED_DEADLINE, threads of equal priority are further ordered
+ * by deadline. Deadlines are compared as a signed difference so that the
+ * comparison still holds when the cycle counter wraps around.
+ */
 static inline int _is_t1_higher_prio_than_t2(struct k_thread *t1,
 					     struct k_thread *t2)
 {
+#ifdef CONFIG_SCHED_DEADLINE
+	if (t1->base.prio == t2->base.prio) {
+		return (s32_t)((u32_t)t1->base.prio_deadline -
+			       (u32_t)t2->base.prio_deadline) < 0;
+	}
+#endif
 	return _is_prio1_higher_than_prio2(t1->base.prio, t2->base.prio);
 }
 
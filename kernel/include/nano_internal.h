@@ -168,6 +168,12 @@ extern void _thread_monitor_exit(struct k_thread *thread);
 	} while (0)
 #endif /* CONFIG_THREAD_MONITOR */
 
+#ifdef CONFIG_SYS_POWER_IDLE_GOVERNOR
+extern int _sys_pm_idle_governor_enter(s32_t ticks);
+extern void _sys_pm_idle_governor_wake(void);
+extern void _sys_pm_idle_governor_exit(int state);
+#endif
+
 #ifdef __cplusplus
 }
 #endif
@@ -27,6 +27,7 @@
 #include <version.h>
 #include <string.h>
 #include <misc/dlist.h>
+#include <wait_q.h>
 
 /* kernel build timestamp items */
 
@@ -74,6 +75,10 @@ u64_t __noinit __start_intr_time;
 u64_t __noinit __end_intr_time;
 u64_t __noinit __start_tick_time;
 u64_t __noinit __end_tick_time;
+#ifdef CONFIG_USERSPACE
+u64_t __noinit __start_syscall_time;
+u64_t __noinit __end_syscall_time;
+#endif
 #endif
 /* init/main and idle threads */
 
@@ -111,7 +116,9 @@ k_tid_t const _idle_thread = (k_tid_t)&_idle_thread_s;
 #endif
 K_THREAD_STACK_DEFINE(_interrupt_stack, CONFIG_ISR_STACK_SIZE);
 
-#ifdef CONFIG_SYS_CLOCK_EXISTS
+#if defined(CONFIG_TIMEOUT_QUEUE_WHEEL)
+	#define initialize_timeouts() _timeout_wheel_init()
+#elif defined(CONFIG_SYS_CLOCK_EXISTS)
 	#define initialize_timeouts() do { \
 		sys_dlist_init(&_timeout_q); \
 	} while ((0))
@@ -268,7 +275,7 @@ static void prepare_multithreading(struct k_thread *dummy_thread)
 	dummy_thread->stack_info.size = 0;
 #endif
 #ifdef CONFIG_USERSPACE
-	dummy_thread->base.perm_index = 0;
+	dummy_thread->perm_index = 0;
 #endif
 #endif
 
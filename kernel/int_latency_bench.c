@@ -7,15 +7,28 @@
  */
 
 #include "toolchain.h"
-#include "sections.h"
+#include <linker/sections.h>
 #include <zephyr/types.h>	    /* u32_t */
 #include <limits.h>	    /* ULONG_MAX */
+#include <string.h>	    /* memset */
 #include <misc/printk.h> /* printk */
 #include <sys_clock.h>
 #include <drivers/system_timer.h>
+#include <kernel.h>
+#include <kernel_structs.h>
+#include <debug/int_latency.h>
 
 #define NB_CACHE_WARMING_DRY_RUN 7
 
+/*
+ * Histogram buckets: values below 4 have a bucket each, larger values
+ * four buckets per power of two, i.e. for 2^n <= value < 2^(n+1) the
+ * bucket is picked by the two bits following the most significant one.
+ */
+#define HIST_SUB_BITS 2
+#define HIST_SUB_BUCKETS (1 << HIST_SUB_BITS)
+#define HIST_BUCKETS ((32 - HIST_SUB_BITS + 1) * HIST_SUB_BUCKETS)
+
 /*
  * Timestamp corresponding to when interrupt were turned off.
  * A value of zero indicated interrupt are not currently locked.
@@ -40,6 +53,145 @@ static u32_t int_latency_bench_ready;
 /* min amount of time it takes from HW interrupt generation to 'C' handler */
 u32_t _hw_irq_to_c_handler_latency = ULONG_MAX;
 
+/* latency histograms */
+static u32_t hist[INT_LATENCY_TYPES][HIST_BUCKETS];
+static u32_t hist_count[INT_LATENCY_TYPES];
+static u32_t hist_min[INT_LATENCY_TYPES];
+static u32_t hist_max[INT_LATENCY_TYPES];
+
+/* call site of the lock of the current section with interrupt locked */
+static void *int_locked_site;
+
+/* longest sections with interrupt locked, one per call site */
+static struct int_latency_site sites[CONFIG_INT_LATENCY_SITES];
+/* length of the shortest of them, shorter sections are not considered */
+static u32_t sites_min_cycles;
+
+/* last thread woken by an interrupt handler, and when */
+static struct k_thread *woken_thread;
+static u32_t woken_timestamp;
+
+static const char * const type_names[INT_LATENCY_TYPES] = {
+	"interrupts locked",
+	"hw interrupt to 'C' handler",
+	"interrupt handler to woken thread",
+};
+
+static inline int hist_bucket(u32_t value)
+{
+	int msb;
+
+	if (value < HIST_SUB_BUCKETS) {
+		return value;
+	}
+
+	msb = 31 - __builtin_clz(value);
+
+	return (msb - HIST_SUB_BITS + 1) * HIST_SUB_BUCKETS +
+	       ((value >> (msb - HIST_SUB_BITS)) & (HIST_SUB_BUCKETS - 1));
+}
+
+/* largest value falling in a bucket */
+static u32_t hist_bucket_max(int bucket)
+{
+	int msb = bucket / HIST_SUB_BUCKETS + HIST_SUB_BITS - 1;
+	u32_t sub = bucket % HIST_SUB_BUCKETS;
+
+	if (bucket < HIST_SUB_BUCKETS) {
+		return bucket;
+	}
+
+	if (bucket == HIST_BUCKETS - 1) {
+		return ULONG_MAX;
+	}
+
+	return ((HIST_SUB_BUCKETS + sub + 1) << (msb - HIST_SUB_BITS)) - 1;
+}
+
+/* must be called with interrupts locked */
+static void hist_add(enum int_latency_type type, u32_t value)
+{
+	hist[type][hist_bucket(value)]++;
+	hist_count[type]++;
+
+	if (value < hist_min[type]) {
+		hist_min[type] = value;
+	}
+	if (value > hist_max[type]) {
+		hist_max[type] = value;
+	}
+}
+
+/* must be called with interrupts locked */
+static void site_add(void *site, u32_t cycles)
+{
+	int i, shortest = 0;
+
+	if (cycles <= sites_min_cycles) {
+		return;
+	}
+
+	for (i = 0; i < ARRAY_SIZE(sites); i++) {
+		if (sites[i].site == site) {
+			break;
+		}
+		if (sites[i].cycles < sites[shortest].cycles) {
+			shortest = i;
+		}
+	}
+
+	if (i == ARRAY_SIZE(sites)) {
+		/* new call site: replaces the shortest section */
+		i = shortest;
+		sites[i].site = site;
+		sites[i].cycles = 0;
+	}
+
+	if (cycles > sites[i].cycles) {
+		sites[i].cycles = cycles;
+	}
+
+	sites_min_cycles = sites[0].cycles;
+	for (i = 1; i < ARRAY_SIZE(sites); i++) {
+		if (sites[i].cycles < sites_min_cycles) {
+			sites_min_cycles = sites[i].cycles;
+		}
+	}
+}
+
+/* must be called with interrupts locked */
+static void hist_reset(void)
+{
+	int type;
+
+	memset(hist, 0, sizeof(hist));
+	memset(sites, 0, sizeof(sites));
+	sites_min_cycles = 0;
+	woken_thread = NULL;
+
+	for (type = 0; type < INT_LATENCY_TYPES; type++) {
+		hist_count[type] = 0;
+		hist_min[type] = ULONG_MAX;
+		hist_max[type] = 0;
+	}
+}
+
+static u32_t hist_percentile(enum int_latency_type type, u32_t permille)
+{
+	u32_t target = ((u64_t)hist_count[type] * permille + 999) / 1000;
+	u32_t total = 0;
+	int bucket;
+
+	for (bucket = 0; bucket < HIST_BUCKETS; bucket++) {
+		total += hist[type][bucket];
+		if (total >= target) {
+			break;
+		}
+	}
+
+	return min(hist_bucket_max(bucket), hist_max[type]);
+}
+
 /**
  *
  * @brief Start tracking time spent with interrupts locked
@@ -55,6 +207,7 @@ void _int_latency_start(void)
 	/* when interrupts are not already locked, take time stamp */
 	if (!int_locked_timestamp && int_latency_bench_ready) {
 		int_locked_timestamp = k_cycle_get_32();
+		int_locked_site = __builtin_return_address(0);
 		int_lock_unlock_nest = 0;
 	}
 	int_lock_unlock_nest++;
@@ -106,6 +259,9 @@ void _int_latency_stop(void)
 		if (delta < int_locked_latency_min)
 			int_locked_latency_min = delta;
 
+		hist_add(INT_LATENCY_IRQ_LOCKED, delta);
+		site_add(int_locked_site, delta);
+
 		/* interrupts are now enabled, get ready for next interrupt lock
 		 */
 		int_locked_timestamp = 0;
@@ -158,11 +314,168 @@ void int_latency_init(void)
 		/* re-initialize globals to default values */
 		int_locked_latency_min = ULONG_MAX;
 		int_locked_latency_max = 0;
+		hist_reset();
 
 		cacheWarming--;
 	}
 }
 
+/**
+ *
+ * @brief Note that a thread is made ready to run
+ *
+ * Called by the scheduler with interrupts locked. Only the last thread woken
+ * by an interrupt handler is tracked.
+ *
+ * @return N/A
+ *
+ */
+void _int_latency_thread_ready(struct k_thread *thread)
+{
+	if (int_latency_bench_ready && _is_in_isr()) {
+		woken_thread = thread;
+		woken_timestamp = k_cycle_get_32();
+	}
+}
+
+/**
+ *
+ * @brief Note that a thread is about to be switched in
+ *
+ * Called by the architecture's context switch code with interrupts locked,
+ * right before it switches to the thread in the ready queue cache.
+ *
+ * @return N/A
+ *
+ */
+void _int_latency_context_switch(void)
+{
+	if (woken_thread && woken_thread == _ready_q.cache) {
+		hist_add(INT_LATENCY_ISR_TO_THREAD,
+			 k_cycle_get_32() - woken_timestamp);
+		woken_thread = NULL;
+	}
+}
+
+void int_latency_record(enum int_latency_type type, u32_t cycles)
+{
+	unsigned int key;
+
+	if (!int_latency_bench_ready || type >= INT_LATENCY_TYPES) {
+		return;
+	}
+
+	key = irq_lock();
+	hist_add(type, cycles);
+	irq_unlock(key);
+}
+
+void int_latency_stats_get(enum int_latency_type type,
+			   struct int_latency_stats *stats)
+{
+	unsigned int key = irq_lock();
+
+	stats->count = hist_count[type];
+	if (stats->count == 0) {
+		stats->min = 0;
+		stats->max = 0;
+		stats->p50 = 0;
+		stats->p99 = 0;
+		stats->p999 = 0;
+	} else {
+		stats->min = hist_min[type];
+		stats->max = hist_max[type];
+		stats->p50 = hist_percentile(type, 500);
+		stats->p99 = hist_percentile(type, 990);
+		stats->p999 = hist_percentile(type, 999);
+	}
+
+	irq_unlock(key);
+}
+
+int int_latency_sites_get(struct int_latency_site *out, int max)
+{
+	struct int_latency_site site;
+	unsigned int key;
+	int i, j, n = 0;
+
+	if (max <= 0) {
+		return 0;
+	}
+
+	key = irq_lock();
+
+	/* insertion sort, from the longest section to the shortest */
+	for (i = 0; i < ARRAY_SIZE(sites); i++) {
+		if (sites[i].cycles == 0) {
+			continue;
+		}
+
+		site = sites[i];
+		if (n == max && out[n - 1].cycles >= site.cycles) {
+			continue;
+		}
+		for (j = min(n, max - 1); j > 0; j--) {
+			if (out[j - 1].cycles >= site.cycles) {
+				break;
+			}
+			out[j] = out[j - 1];
+		}
+		out[j] = site;
+		n = min(n + 1, max);
+	}
+
+	irq_unlock(key);
+
+	return n;
+}
+
+void int_latency_reset(void)
+{
+	unsigned int key = irq_lock();
+
+	hist_reset();
+	int_locked_latency_min = ULONG_MAX;
+	int_locked_latency_max = 0;
+
+	/* also forget the current section, which includes the reset */
+	int_locked_timestamp = 0;
+
+	irq_unlock(key);
+}
+
+static void int_latency_show_histograms(void)
+{
+	struct int_latency_site top[CONFIG_INT_LATENCY_SITES];
+	struct int_latency_stats stats;
+	int type, i, n;
+
+	for (type = 0; type < INT_LATENCY_TYPES; type++) {
+		int_latency_stats_get(type, &stats);
+		if (stats.count == 0) {
+			printk(" %s: not measured\n", type_names[type]);
+			continue;
+		}
+
+		printk(" %s: %u samples, min %u max %u tcs\n"
+		       "  p50 <= %u tcs = %u nsec, p99 <= %u tcs = %u nsec,"
+		       " p99.9 <= %u tcs = %u nsec\n",
+		       type_names[type], stats.count, stats.min, stats.max,
+		       stats.p50, SYS_CLOCK_HW_CYCLES_TO_NS(stats.p50),
+		       stats.p99, SYS_CLOCK_HW_CYCLES_TO_NS(stats.p99),
+		       stats.p999, SYS_CLOCK_HW_CYCLES_TO_NS(stats.p999));
+	}
+
+	n = int_latency_sites_get(top, ARRAY_SIZE(top));
+	if (n) {
+		printk(" Longest sections with interrupts locked:\n");
+	}
+	for (i = 0; i < n; i++) {
+		printk("  locked at %p: %u tcs = %u nsec\n", top[i].site,
+		       top[i].cycles, SYS_CLOCK_HW_CYCLES_TO_NS(top[i].cycles));
+	}
+}
+
 /**
  *
  * @brief Dumps interrupt latency values
@@ -215,11 +528,13 @@ void int_latency_show(void)
 	} else {
 		printk("interrupts were not locked and unlocked yet\n");
 	}
+
+	int_latency_show_histograms();
+
 	/*
 	 * Lets start with new values so that one extra long path executed
 	 * with interrupt disabled hide smaller paths with interrupt
 	 * disabled.
 	 */
-	int_locked_latency_min = ULONG_MAX;
-	int_locked_latency_max = 0;
+	int_latency_reset();
 }
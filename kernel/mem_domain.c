@@ -12,6 +12,14 @@
 
 static u8_t max_partitions;
 
+/* last generation given to a domain, unique among all domains */
+static u32_t generation;
+
+/* must be called with interrupts locked */
+static void domain_changed(struct k_mem_domain *domain)
+{
+	domain->generation = ++generation;
+}
 
 void k_mem_domain_init(struct k_mem_domain *domain, u32_t num_parts,
 		struct k_mem_partition *parts[])
@@ -36,6 +44,7 @@ void k_mem_domain_init(struct k_mem_domain *domain, u32_t num_parts,
 	}
 
 	sys_dlist_init(&domain->mem_domain_q);
+	domain_changed(domain);
 
 	irq_unlock(key);
 }
@@ -57,6 +66,8 @@ void k_mem_domain_destroy(struct k_mem_domain *domain)
 		thread->mem_domain_info.mem_domain = NULL;
 	}
 
+	domain_changed(domain);
+
 	irq_unlock(key);
 }
 
@@ -86,6 +97,7 @@ void k_mem_domain_add_partition(struct k_mem_domain *domain,
 	domain->partitions[p_idx].attr = part->attr;
 
 	domain->num_partitions++;
+	domain_changed(domain);
 
 	irq_unlock(key);
 }
@@ -116,6 +128,7 @@ void k_mem_domain_remove_partition(struct k_mem_domain *domain,
 	domain->partitions[p_idx].attr = 0;
 
 	domain->num_partitions--;
+	domain_changed(domain);
 
 	irq_unlock(key);
 }
@@ -21,6 +21,59 @@ extern struct k_mem_slab _k_mem_slab_list_end[];
 struct k_mem_slab *_trace_list_k_mem_slab;
 #endif	/* CONFIG_OBJECT_TRACING */
 
+#ifdef CONFIG_MEM_SLAB_STATS
+static struct k_mem_slab *slab_list;
+#endif
+
+/*
+ * The free list is kept in a single atomic word, so that blocks can be
+ * allocated and freed with a compare-and-swap instead of locking interrupts.
+ * Its low half holds the index plus one of the first free block, zero when
+ * there is none, and each free block starts with the index plus one of the
+ * next. Its high half is a tag, incremented on every update: without it a
+ * thread preempted between reading the first free block and swapping in the
+ * next one could install a stale link, should the block have been allocated
+ * and freed again meanwhile.
+ */
+#define FREE_LIST_INDEX_MASK	0xffff
+#define FREE_LIST_TAG_INC	0x10000
+
+static inline char *block_at(struct k_mem_slab *slab, u32_t index)
+{
+	return slab->buffer + (index - 1) * slab->block_size;
+}
+
+static char *free_list_pop(struct k_mem_slab *slab)
+{
+	atomic_val_t old, new;
+	char *block;
+
+	do {
+		old = atomic_get(&slab->free_list);
+		if ((old & FREE_LIST_INDEX_MASK) == 0) {
+			return NULL;
+		}
+		block = block_at(slab, old & FREE_LIST_INDEX_MASK);
+		/* only meaningful if the CAS below succeeds */
+		new = ((old + FREE_LIST_TAG_INC) & ~FREE_LIST_INDEX_MASK) |
+		      (*(u32_t *)block & FREE_LIST_INDEX_MASK);
+	} while (!atomic_cas(&slab->free_list, old, new));
+
+	return block;
+}
+
+static void free_list_push(struct k_mem_slab *slab, char *block)
+{
+	u32_t index = (block - slab->buffer) / slab->block_size + 1;
+	atomic_val_t old, new;
+
+	do {
+		old = atomic_get(&slab->free_list);
+		*(u32_t *)block = old & FREE_LIST_INDEX_MASK;
+		new = ((old + FREE_LIST_TAG_INC) & ~FREE_LIST_INDEX_MASK) | index;
+	} while (!atomic_cas(&slab->free_list, old, new));
+}
+
 /**
  * @brief Initialize kernel memory slab subsystem.
  *
@@ -34,16 +87,82 @@ static void create_free_list(struct k_mem_slab *slab)
 	u32_t j;
 	char *p;
 
-	slab->free_list = NULL;
+	__ASSERT(slab->num_blocks <= FREE_LIST_INDEX_MASK,
+		 "too many blocks in memory slab");
+
+	atomic_set(&slab->free_list, 0);
 	p = slab->buffer;
 
 	for (j = 0; j < slab->num_blocks; j++) {
-		*(char **)p = slab->free_list;
-		slab->free_list = p;
+		*(u32_t *)p = atomic_get(&slab->free_list);
+		atomic_set(&slab->free_list, j + 1);
 		p += slab->block_size;
 	}
 }
 
+#ifdef CONFIG_MEM_SLAB_STATS
+static void slab_list_add(struct k_mem_slab *slab)
+{
+	struct k_mem_slab *s;
+	unsigned int key = irq_lock();
+
+	/* a slab may be initialized again */
+	for (s = slab_list; s != NULL; s = s->next_slab) {
+		if (s == slab) {
+			irq_unlock(key);
+			return;
+		}
+	}
+
+	slab->next_slab = slab_list;
+	slab_list = slab;
+
+	irq_unlock(key);
+}
+
+static inline void count_alloc(struct k_mem_slab *slab)
+{
+	atomic_val_t used = atomic_inc(&slab->num_used) + 1;
+	atomic_val_t max;
+
+	do {
+		max = atomic_get(&slab->max_used);
+		if (used <= max) {
+			break;
+		}
+	} while (!atomic_cas(&slab->max_used, max, used));
+}
+
+static inline void count_failure(struct k_mem_slab *slab)
+{
+	atomic_inc(&slab->alloc_failures);
+}
+
+void k_mem_slab_stats_get(struct k_mem_slab *slab,
+			  struct k_mem_slab_stats *stats)
+{
+	stats->num_blocks = slab->num_blocks;
+	stats->block_size = slab->block_size;
+	stats->num_used = atomic_get(&slab->num_used);
+	stats->max_used = atomic_get(&slab->max_used);
+	stats->alloc_failures = atomic_get(&slab->alloc_failures);
+}
+
+void k_mem_slab_foreach(k_mem_slab_user_cb_t user_cb, void *user_data)
+{
+	struct k_mem_slab *slab;
+
+	/* slabs are only ever added, at the head of the list */
+	for (slab = slab_list; slab != NULL; slab = slab->next_slab) {
+		user_cb(slab, user_data);
+	}
+}
+#else
+#define slab_list_add(slab) do { } while ((0))
+#define count_alloc(slab) atomic_inc(&(slab)->num_used)
+#define count_failure(slab) do { } while ((0))
+#endif /* CONFIG_MEM_SLAB_STATS */
+
 /**
  * @brief Complete initialization of statically defined memory slabs.
  *
@@ -61,6 +180,7 @@ static int init_mem_slab_module(struct device *dev)
 	     slab < _k_mem_slab_list_end;
 	     slab++) {
 		create_free_list(slab);
+		slab_list_add(slab);
 		SYS_TRACING_OBJ_INIT(k_mem_slab, slab);
 	}
 	return 0;
@@ -75,9 +195,14 @@ void k_mem_slab_init(struct k_mem_slab *slab, void *buffer,
 	slab->num_blocks = num_blocks;
 	slab->block_size = block_size;
 	slab->buffer = buffer;
-	slab->num_used = 0;
+	atomic_set(&slab->num_used, 0);
+#ifdef CONFIG_MEM_SLAB_STATS
+	atomic_set(&slab->max_used, 0);
+	atomic_set(&slab->alloc_failures, 0);
+#endif
 	create_free_list(slab);
 	sys_dlist_init(&slab->wait_q);
+	slab_list_add(slab);
 	SYS_TRACING_OBJ_INIT(k_mem_slab, slab);
 
 	_k_object_init(slab);
@@ -85,41 +210,51 @@ void k_mem_slab_init(struct k_mem_slab *slab, void *buffer,
 
 int k_mem_slab_alloc(struct k_mem_slab *slab, void **mem, s32_t timeout)
 {
-	unsigned int key = irq_lock();
+	unsigned int key;
 	int result;
 
-	if (slab->free_list != NULL) {
-		/* take a free block */
-		*mem = slab->free_list;
-		slab->free_list = *(char **)(slab->free_list);
-		slab->num_used++;
-		result = 0;
-	} else if (timeout == K_NO_WAIT) {
+	/* take a free block, without locking interrupts */
+	*mem = free_list_pop(slab);
+	if (*mem != NULL) {
+		count_alloc(slab);
+		return 0;
+	}
+
+	if (timeout == K_NO_WAIT) {
 		/* don't wait for a free block to become available */
-		*mem = NULL;
-		result = -ENOMEM;
-	} else {
-		/* wait for a free block or timeout */
-		_pend_current_thread(&slab->wait_q, timeout);
-		result = _Swap(key);
-		if (result == 0) {
-			*mem = _current->base.swap_data;
-		}
-		return result;
+		count_failure(slab);
+		return -ENOMEM;
 	}
 
-	irq_unlock(key);
+	key = irq_lock();
+
+	/* a block may have been freed before interrupts were locked */
+	*mem = free_list_pop(slab);
+	if (*mem != NULL) {
+		count_alloc(slab);
+		irq_unlock(key);
+		return 0;
+	}
 
+	/* wait for a free block or timeout */
+	_pend_current_thread(&slab->wait_q, timeout);
+	result = _Swap(key);
+	if (result == 0) {
+		*mem = _current->base.swap_data;
+	} else {
+		count_failure(slab);
+	}
 	return result;
 }
 
-void k_mem_slab_free(struct k_mem_slab *slab, void **mem)
+/* hand a freed block to the first waiting thread, if any, else free it */
+static void give_block(struct k_mem_slab *slab, char *block)
 {
-	int key = irq_lock();
+	unsigned int key = irq_lock();
 	struct k_thread *pending_thread = _unpend_first_thread(&slab->wait_q);
 
 	if (pending_thread) {
-		_set_thread_return_value_with_data(pending_thread, 0, *mem);
+		_set_thread_return_value_with_data(pending_thread, 0, block);
 		_abort_thread_timeout(pending_thread);
 		_ready_thread(pending_thread);
 		if (_must_switch_threads()) {
@@ -127,10 +262,39 @@ void k_mem_slab_free(struct k_mem_slab *slab, void **mem)
 			return;
 		}
 	} else {
-		**(char ***)mem = slab->free_list;
-		slab->free_list = *(char **)mem;
-		slab->num_used--;
+		atomic_dec(&slab->num_used);
+		free_list_push(slab, block);
 	}
 
 	irq_unlock(key);
 }
+
+void k_mem_slab_free(struct k_mem_slab *slab, void **mem)
+{
+	char *block;
+
+	if (!sys_dlist_is_empty(&slab->wait_q)) {
+		give_block(slab, *mem);
+		return;
+	}
+
+	/*
+	 * nobody waits: free the block without locking interrupts. It stops
+	 * being counted before it is published, else whoever takes it at once
+	 * would count it as used twice.
+	 */
+	atomic_dec(&slab->num_used);
+	free_list_push(slab, *mem);
+
+	/*
+	 * A thread may have started waiting after the check above, having
+	 * found no free block before the push: the block is then its own.
+	 */
+	if (unlikely(!sys_dlist_is_empty(&slab->wait_q))) {
+		block = free_list_pop(slab);
+		if (block != NULL) {
+			atomic_inc(&slab->num_used);
+			give_block(slab, block);
+		}
+	}
+}
@@ -103,6 +103,10 @@ static void init_mem_pool(struct k_mem_pool *p)
 		int nblocks = buflen / sz;
 
 		sys_dlist_init(&p->levels[i].free_list);
+#ifdef CONFIG_MEM_POOL_CACHE
+		sys_slist_init(&p->levels[i].cache);
+		p->levels[i].cache_count = 0;
+#endif
 
 		if (nblocks < 32) {
 			p->max_inline_level = i;
@@ -195,6 +199,90 @@ static void free_block(struct k_mem_pool *p, int level, size_t *lsizes, int bn)
 	irq_unlock(key);
 }
 
+#ifdef CONFIG_MEM_POOL_CACHE
+/* Freed blocks are kept in a small cache per level, still marked as
+ * used in the bitmaps, so that an allocation of the same level takes
+ * one back in constant time without splitting, and freeing it does not
+ * merge it. Since a cached block cannot merge with its partners, the
+ * caches are flushed whenever an allocation would fail otherwise.
+ */
+static void *cache_get(struct k_mem_pool *p, int l)
+{
+	struct k_mem_pool_lvl *lvl = &p->levels[l];
+	void *block;
+	int key = irq_lock();
+
+	block = sys_slist_get(&lvl->cache);
+	if (block) {
+		lvl->cache_count--;
+		p->cache_stats.hits++;
+	} else {
+		p->cache_stats.misses++;
+	}
+	irq_unlock(key);
+
+	return block;
+}
+
+static bool cache_put(struct k_mem_pool *p, int l, void *block)
+{
+	struct k_mem_pool_lvl *lvl = &p->levels[l];
+	bool cached = false;
+	int key = irq_lock();
+
+	if (lvl->cache_count < CONFIG_MEM_POOL_CACHE_DEPTH) {
+		/* most recently freed first: it is the likeliest in the
+		 * CPU cache
+		 */
+		sys_slist_prepend(&lvl->cache, block);
+		lvl->cache_count++;
+		cached = true;
+	}
+	irq_unlock(key);
+
+	return cached;
+}
+
+/* Returns the number of blocks given back to the pool */
+static int cache_flush(struct k_mem_pool *p)
+{
+	size_t lsizes[p->n_levels];
+	int i, key, flushed = 0;
+	void *block;
+
+	lsizes[0] = _ALIGN4(p->max_sz);
+	for (i = 1; i < p->n_levels; i++) {
+		lsizes[i] = _ALIGN4(lsizes[i-1] / 4);
+	}
+
+	for (i = 0; i < p->n_levels; i++) {
+		while (1) {
+			key = irq_lock();
+			block = sys_slist_get(&p->levels[i].cache);
+			if (block) {
+				p->levels[i].cache_count--;
+			}
+			irq_unlock(key);
+
+			if (!block) {
+				break;
+			}
+
+			free_block(p, i, lsizes, block_num(p, block, lsizes[i]));
+			flushed++;
+		}
+	}
+
+	if (flushed) {
+		key = irq_lock();
+		p->cache_stats.flushes++;
+		irq_unlock(key);
+	}
+
+	return flushed;
+}
+#endif /* CONFIG_MEM_POOL_CACHE */
+
 /* Takes a block of a given level, splits it into four blocks of the
  * next smaller level, puts three into the free list as in
  * free_block() but without the need to check adjacent bits or
@@ -254,13 +342,30 @@ static int pool_alloc(struct k_mem_pool *p, struct k_mem_block *block,
 		}
 	}
 
+#ifdef CONFIG_MEM_POOL_CACHE
+	if (alloc_l >= 0) {
+		blk = cache_get(p, alloc_l);
+		if (blk) {
+			/* nothing to break */
+			free_l = alloc_l;
+		} else if (free_l < 0 && cache_flush(p)) {
+			/* the flushed blocks may have merged into a block
+			 * large enough, start over
+			 */
+			return pool_alloc(p, block, size);
+		}
+	}
+#endif
+
 	if (alloc_l < 0 || free_l < 0) {
 		block->data = NULL;
 		return -ENOMEM;
 	}
 
 	/* Iteratively break the smallest enclosing block... */
-	blk = alloc_block(p, free_l, lsizes[free_l]);
+	if (!blk) {
+		blk = alloc_block(p, free_l, lsizes[free_l]);
+	}
 
 	if (!blk) {
 		/* This can happen if we race with another allocator.
@@ -325,6 +430,8 @@ void k_mem_pool_free(struct k_mem_block *block)
 {
 	int i, key, need_sched = 0;
 	struct k_mem_pool *p = get_pool(block->id.pool);
+	int level = block->id.level, bn = block->id.block;
+	bool cached = false;
 	size_t lsizes[p->n_levels];
 
 	/* As in k_mem_pool_alloc(), we build a table of level sizes
@@ -334,12 +441,20 @@ void k_mem_pool_free(struct k_mem_block *block)
 	 * sublevels.
 	 */
 	lsizes[0] = _ALIGN4(p->max_sz);
-	for (i = 1; i <= block->id.level; i++) {
+	for (i = 1; i <= level; i++) {
 		lsizes[i] = _ALIGN4(lsizes[i-1] / 4);
 	}
 
-	free_block(get_pool(block->id.pool), block->id.level,
-		   lsizes, block->id.block);
+	/* The descriptor may live in the block itself (see k_free()), so
+	 * it must not be used past this point: caching or freeing the block
+	 * overwrites it.
+	 */
+#ifdef CONFIG_MEM_POOL_CACHE
+	cached = cache_put(p, level, block_ptr(p, lsizes[level], bn));
+#endif
+	if (!cached) {
+		free_block(p, level, lsizes, bn);
+	}
 
 	/* Wake up anyone blocked on this pool and let them repeat
 	 * their allocation attempts
@@ -364,6 +479,27 @@ void k_mem_pool_free(struct k_mem_block *block)
 
 #if (CONFIG_HEAP_MEM_POOL_SIZE > 0)
 
+void *k_calloc(size_t nmemb, size_t size)
+{
+	void *ret;
+	size_t bounds;
+
+	if (__builtin_mul_overflow(nmemb, size, &bounds)) {
+		return NULL;
+	}
+
+	ret = k_malloc(bounds);
+	if (ret) {
+		memset(ret, 0, bounds);
+	}
+
+	return ret;
+}
+
+#endif
+
+#if (CONFIG_HEAP_MEM_POOL_SIZE > 0) && defined(CONFIG_HEAP_MEM_POOL_BUDDY)
+
 /*
  * Heap is defined using HEAP_MEM_POOL_SIZE configuration option.
  *
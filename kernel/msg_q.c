@@ -181,3 +181,212 @@ void k_msgq_purge(struct k_msgq *q)
 
 	_reschedule_threads(key);
 }
+
+/* Copy @a num_msgs messages from @a data to the tail of the ring buffer */
+static void _msgq_ring_put(struct k_msgq *q, char *data, u32_t num_msgs)
+{
+	size_t bytes = num_msgs * q->msg_size;
+	size_t run = min(bytes, (size_t)(q->buffer_end - q->write_ptr));
+
+	memcpy(q->write_ptr, data, run);
+	if (run < bytes) {
+		/* wrap around the end of the ring buffer */
+		memcpy(q->buffer_start, data + run, bytes - run);
+		q->write_ptr = q->buffer_start + (bytes - run);
+	} else {
+		q->write_ptr += run;
+		if (q->write_ptr == q->buffer_end) {
+			q->write_ptr = q->buffer_start;
+		}
+	}
+	q->used_msgs += num_msgs;
+}
+
+/* Copy @a num_msgs messages from the head of the ring buffer to @a data */
+static void _msgq_ring_get(struct k_msgq *q, char *data, u32_t num_msgs)
+{
+	size_t bytes = num_msgs * q->msg_size;
+	size_t run = min(bytes, (size_t)(q->buffer_end - q->read_ptr));
+
+	memcpy(data, q->read_ptr, run);
+	if (run < bytes) {
+		/* wrap around the end of the ring buffer */
+		memcpy(data + run, q->buffer_start, bytes - run);
+		q->read_ptr = q->buffer_start + (bytes - run);
+	} else {
+		q->read_ptr += run;
+		if (q->read_ptr == q->buffer_end) {
+			q->read_ptr = q->buffer_start;
+		}
+	}
+	q->used_msgs -= num_msgs;
+}
+
+/*
+ * Refill the ring buffer from the threads waiting to write, once messages
+ * have been taken out of it. Returns the number of threads readied.
+ */
+static u32_t _msgq_unpend_writers(struct k_msgq *q)
+{
+	struct k_thread *pending_thread;
+	u32_t num_woken = 0;
+
+	while (q->used_msgs < q->max_msgs) {
+		pending_thread = _unpend_first_thread(&q->wait_q);
+		if (!pending_thread) {
+			break;
+		}
+
+		/* add thread's message to queue */
+		_msgq_ring_put(q, pending_thread->base.swap_data, 1);
+
+		/* wake up waiting thread */
+		_set_thread_return_value(pending_thread, 0);
+		_abort_thread_timeout(pending_thread);
+		_ready_thread(pending_thread);
+		num_woken++;
+	}
+
+	return num_woken;
+}
+
+int k_msgq_put_batch(struct k_msgq *q, void *data, u32_t num_msgs,
+		     s32_t timeout)
+{
+	__ASSERT(!_is_in_isr() || timeout == K_NO_WAIT, "");
+	__ASSERT(num_msgs > 0, "");
+
+	unsigned int key = irq_lock();
+	struct k_thread *pending_thread;
+	char *msg = data;
+	u32_t num_put = 0;
+	u32_t num_free;
+	int result;
+
+	if (q->used_msgs == q->max_msgs) {
+		if (timeout == K_NO_WAIT) {
+			/* don't wait for message space to become available */
+			irq_unlock(key);
+			return -ENOMSG;
+		}
+
+		/* wait for the first message to be put, like k_msgq_put() */
+		_pend_current_thread(&q->wait_q, timeout);
+		_current->base.swap_data = data;
+		result = _Swap(key);
+
+		return result ? result : 1;
+	}
+
+	/* give messages to waiting threads, they only wait on an empty queue */
+	while (num_put < num_msgs) {
+		pending_thread = _unpend_first_thread(&q->wait_q);
+		if (!pending_thread) {
+			break;
+		}
+
+		memcpy(pending_thread->base.swap_data, msg, q->msg_size);
+		msg += q->msg_size;
+		num_put++;
+
+		_set_thread_return_value(pending_thread, 0);
+		_abort_thread_timeout(pending_thread);
+		_ready_thread(pending_thread);
+	}
+
+	/* put as many of the others as there is space for in queue */
+	num_free = q->max_msgs - q->used_msgs;
+	if (num_free > num_msgs - num_put) {
+		num_free = num_msgs - num_put;
+	}
+	_msgq_ring_put(q, msg, num_free);
+
+	/* one context switch at most, whatever the number of threads woken */
+	if (num_put && !_is_in_isr() && _must_switch_threads()) {
+		_Swap(key);
+	} else {
+		irq_unlock(key);
+	}
+
+	return num_put + num_free;
+}
+
+int k_msgq_get_batch(struct k_msgq *q, void *data, u32_t num_msgs,
+		     s32_t timeout)
+{
+	__ASSERT(!_is_in_isr() || timeout == K_NO_WAIT, "");
+	__ASSERT(num_msgs > 0, "");
+
+	unsigned int key = irq_lock();
+	int result;
+
+	if (q->used_msgs == 0) {
+		if (timeout == K_NO_WAIT) {
+			/* don't wait for a message to become available */
+			irq_unlock(key);
+			return -ENOMSG;
+		}
+
+		/* wait for the first message, like k_msgq_get() */
+		_pend_current_thread(&q->wait_q, timeout);
+		_current->base.swap_data = data;
+		result = _Swap(key);
+
+		return result ? result : 1;
+	}
+
+	/* take as many messages as available from queue */
+	if (num_msgs > q->used_msgs) {
+		num_msgs = q->used_msgs;
+	}
+	_msgq_ring_get(q, data, num_msgs);
+
+	/* one context switch at most, whatever the number of threads woken */
+	if (_msgq_unpend_writers(q) && !_is_in_isr() &&
+	    _must_switch_threads()) {
+		_Swap(key);
+	} else {
+		irq_unlock(key);
+	}
+
+	return num_msgs;
+}
+
+int k_msgq_peek_claim(struct k_msgq *q, void **data)
+{
+	unsigned int key = irq_lock();
+	int result;
+
+	if (q->used_msgs > 0) {
+		*data = q->read_ptr;
+		result = 0;
+	} else {
+		result = -ENOMSG;
+	}
+
+	irq_unlock(key);
+
+	return result;
+}
+
+void k_msgq_peek_finish(struct k_msgq *q)
+{
+	unsigned int key = irq_lock();
+
+	__ASSERT(q->used_msgs > 0, "no message claimed");
+
+	/* drop the first message, it was read in place */
+	q->read_ptr += q->msg_size;
+	if (q->read_ptr == q->buffer_end) {
+		q->read_ptr = q->buffer_start;
+	}
+	q->used_msgs--;
+
+	if (_msgq_unpend_writers(q) && !_is_in_isr() &&
+	    _must_switch_threads()) {
+		_Swap(key);
+		return;
+	}
+
+	irq_unlock(key);
+}
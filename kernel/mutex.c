@@ -33,6 +33,7 @@
 #include <wait_q.h>
 #include <misc/dlist.h>
 #include <debug/object_tracing_common.h>
+#include <contention.h>
 #include <errno.h>
 #include <init.h>
 
@@ -75,6 +76,7 @@ void k_mutex_init(struct k_mutex *mutex)
 	/* mutex->owner_orig_prio = 0; */
 
 	sys_dlist_init(&mutex->wait_q);
+	_contention_init(mutex);
 
 	SYS_TRACING_OBJ_INIT(k_mutex, mutex);
 	_k_object_init(mutex);
@@ -106,6 +108,8 @@ int k_mutex_lock(struct k_mutex *mutex, s32_t timeout)
 {
 	int new_prio, key;
 
+	sys_trace_event(SYS_TRACE_MUTEX_LOCK, mutex, timeout);
+
 	_sched_lock();
 
 	if (likely(mutex->lock_count == 0 || mutex->owner == _current)) {
@@ -119,6 +123,8 @@ int k_mutex_lock(struct k_mutex *mutex, s32_t timeout)
 		mutex->lock_count++;
 		mutex->owner = _current;
 
+		_contention_acquired(mutex);
+
 		K_DEBUG("%p took mutex %p, count: %d, orig prio: %d\n",
 			_current, mutex, mutex->lock_count,
 			mutex->owner_orig_prio);
@@ -131,6 +137,7 @@ int k_mutex_lock(struct k_mutex *mutex, s32_t timeout)
 	RECORD_CONFLICT();
 
 	if (unlikely(timeout == K_NO_WAIT)) {
+		_contention_failed(mutex);
 		k_sched_unlock();
 		return -EBUSY;
 	}
@@ -149,13 +156,18 @@ int k_mutex_lock(struct k_mutex *mutex, s32_t timeout)
 	K_DEBUG("adjusting prio up on mutex %p\n", mutex);
 
 	if (_is_prio_higher(new_prio, mutex->owner->base.prio)) {
+		_contention_boost(mutex);
 		adjust_owner_prio(mutex, new_prio);
 	}
 
+	u32_t wait_start = _contention_wait_start();
+
 	_pend_current_thread(&mutex->wait_q, timeout);
 
 	int got_mutex = _Swap(key);
 
+	_contention_wait_end(mutex, wait_start, got_mutex == 0);
+
 	K_DEBUG("on mutex %p got_mutex value: %d\n", mutex, got_mutex);
 
 	K_DEBUG("%p got mutex %p (y/n): %c\n", _current, mutex,
@@ -195,6 +207,8 @@ void k_mutex_unlock(struct k_mutex *mutex)
 	__ASSERT(mutex->lock_count > 0, "");
 	__ASSERT(mutex->owner == _current, "");
 
+	sys_trace_event(SYS_TRACE_MUTEX_UNLOCK, mutex, mutex->lock_count);
+
 	_sched_lock();
 
 	RECORD_STATE_CHANGE();
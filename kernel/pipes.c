@@ -681,6 +681,230 @@ int k_pipe_put(struct k_pipe *pipe, void *data, size_t bytes_to_write,
 				    min_xfer, timeout);
 }
 
+/* Contiguous free space at the write index of the pipe's circular buffer */
+static size_t _pipe_put_run(struct k_pipe *pipe)
+{
+	return min(pipe->size - pipe->bytes_used,
+		   pipe->size - pipe->write_index);
+}
+
+/* Contiguous data at the read index of the pipe's circular buffer */
+static size_t _pipe_get_run(struct k_pipe *pipe)
+{
+	return min(pipe->bytes_used, pipe->size - pipe->read_index);
+}
+
+/**
+ * @brief Wait for the other end of the pipe to move data
+ *
+ * Pends the current thread on @a wait_q with a request of zero bytes, which
+ * any reader (or writer) processing the wait queue fully satisfies, and so
+ * readies. Must be called with interrupts locked.
+ *
+ * @return N/A
+ */
+static void _pipe_claim_wait(_wait_q_t *wait_q, s32_t timeout,
+			     unsigned int key)
+{
+	struct k_pipe_desc  pipe_desc;
+
+	pipe_desc.buffer        = NULL;
+	pipe_desc.bytes_to_xfer = 0;
+
+	_current->base.swap_data = &pipe_desc;
+	_pend_current_thread(wait_q, timeout);
+	_Swap(key);
+}
+
+int k_pipe_put_claim(struct k_pipe *pipe, void **data, size_t *size,
+		     s32_t timeout)
+{
+	unsigned int key;
+	size_t       run_length;
+
+	__ASSERT(pipe->size > 0, "pipe has no ring buffer");
+	__ASSERT((data != NULL) && (size != NULL), "");
+
+	key = irq_lock();
+
+	run_length = _pipe_put_run(pipe);
+	if (run_length == 0) {
+		if (timeout == K_NO_WAIT) {
+			irq_unlock(key);
+			*size = 0;
+			return -EIO;
+		}
+
+		/* The buffer is full: wait for a reader to empty some of it */
+		_pipe_claim_wait(&pipe->wait_q.writers, timeout, key);
+
+		key = irq_lock();
+		run_length = _pipe_put_run(pipe);
+		if (run_length == 0) {
+			irq_unlock(key);
+			*size = 0;
+			return -EAGAIN;
+		}
+	}
+
+	*data = pipe->buffer + pipe->write_index;
+	*size = min(*size, run_length);
+
+	irq_unlock(key);
+
+	return 0;
+}
+
+void k_pipe_put_commit(struct k_pipe *pipe, size_t size)
+{
+	struct k_thread    *reader;
+	struct k_thread    *thread;
+	struct k_pipe_desc *desc;
+	sys_dlist_t    xfer_list;
+	unsigned int   key;
+	size_t         bytes_copied;
+
+	key = irq_lock();
+
+	__ASSERT(size <= _pipe_put_run(pipe), "more than the space claimed");
+
+	pipe->bytes_used  += size;
+	pipe->write_index += size;
+	if (pipe->write_index == pipe->size) {
+		pipe->write_index = 0;
+	}
+
+	/*
+	 * Readers only wait on an empty pipe: hand the new data over to
+	 * them as k_pipe_put() would, and ready those that are satisfied.
+	 */
+	(void)_pipe_xfer_prepare(&xfer_list, &reader, &pipe->wait_q.readers,
+				 0, pipe->bytes_used, 0, K_FOREVER);
+
+	_sched_lock();
+	irq_unlock(key);
+
+	thread = (struct k_thread *)sys_dlist_get(&xfer_list);
+	while (thread) {
+		desc = (struct k_pipe_desc *)thread->base.swap_data;
+		bytes_copied = _pipe_buffer_get(pipe, desc->buffer,
+						desc->bytes_to_xfer);
+
+		desc->buffer        += bytes_copied;
+		desc->bytes_to_xfer -= bytes_copied;
+
+		_pipe_thread_ready(thread);
+
+		thread = (struct k_thread *)sys_dlist_get(&xfer_list);
+	}
+
+	if (reader) {
+		desc = (struct k_pipe_desc *)reader->base.swap_data;
+		bytes_copied = _pipe_buffer_get(pipe, desc->buffer,
+						desc->bytes_to_xfer);
+
+		desc->buffer        += bytes_copied;
+		desc->bytes_to_xfer -= bytes_copied;
+	}
+
+	k_sched_unlock();
+}
+
+int k_pipe_get_claim(struct k_pipe *pipe, void **data, size_t *size,
+		     s32_t timeout)
+{
+	unsigned int key;
+	size_t       run_length;
+
+	__ASSERT(pipe->size > 0, "pipe has no ring buffer");
+	__ASSERT((data != NULL) && (size != NULL), "");
+
+	key = irq_lock();
+
+	run_length = _pipe_get_run(pipe);
+	if (run_length == 0) {
+		if (timeout == K_NO_WAIT) {
+			irq_unlock(key);
+			*size = 0;
+			return -EIO;
+		}
+
+		/* The buffer is empty: wait for a writer to fill some of it */
+		_pipe_claim_wait(&pipe->wait_q.readers, timeout, key);
+
+		key = irq_lock();
+		run_length = _pipe_get_run(pipe);
+		if (run_length == 0) {
+			irq_unlock(key);
+			*size = 0;
+			return -EAGAIN;
+		}
+	}
+
+	*data = pipe->buffer + pipe->read_index;
+	*size = min(*size, run_length);
+
+	irq_unlock(key);
+
+	return 0;
+}
+
+void k_pipe_get_finish(struct k_pipe *pipe, size_t size)
+{
+	struct k_thread    *writer;
+	struct k_thread    *thread;
+	struct k_pipe_desc *desc;
+	sys_dlist_t    xfer_list;
+	unsigned int   key;
+	size_t         bytes_copied;
+
+	key = irq_lock();
+
+	__ASSERT(size <= _pipe_get_run(pipe), "more than the data claimed");
+
+	pipe->bytes_used -= size;
+	pipe->read_index += size;
+	if (pipe->read_index == pipe->size) {
+		pipe->read_index = 0;
+	}
+
+	/*
+	 * Writers only wait on a full pipe: move their data into the space
+	 * just freed as k_pipe_get() would, and ready those that are done.
+	 */
+	(void)_pipe_xfer_prepare(&xfer_list, &writer, &pipe->wait_q.writers,
+				 0, pipe->size - pipe->bytes_used, 0,
+				 K_FOREVER);
+
+	_sched_lock();
+	irq_unlock(key);
+
+	thread = (struct k_thread *)sys_dlist_get(&xfer_list);
+	while (thread) {
+		desc = (struct k_pipe_desc *)thread->base.swap_data;
+		bytes_copied = _pipe_buffer_put(pipe, desc->buffer,
+						desc->bytes_to_xfer);
+
+		desc->buffer        += bytes_copied;
+		desc->bytes_to_xfer -= bytes_copied;
+
+		_pipe_thread_ready(thread);
+
+		thread = (struct k_thread *)sys_dlist_get(&xfer_list);
+	}
+
+	if (writer) {
+		desc = (struct k_pipe_desc *)writer->base.swap_data;
+		bytes_copied = _pipe_buffer_put(pipe, desc->buffer,
+						desc->bytes_to_xfer);
+
+		desc->buffer        += bytes_copied;
+		desc->bytes_to_xfer -= bytes_copied;
+	}
+
+	k_sched_unlock();
+}
+
 #if (CONFIG_NUM_PIPE_ASYNC_MSGS > 0)
 void k_pipe_block_put(struct k_pipe *pipe, struct k_mem_block *block,
 		      size_t bytes_to_write, struct k_sem *sem)
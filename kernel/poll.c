@@ -94,15 +94,19 @@ static inline void add_event(sys_dlist_t *events, struct k_poll_event *event,
 {
 	struct k_poll_event *pending;
 
+	/* poll sets have no thread: they come after all k_poll() callers */
 	pending = (struct k_poll_event *)sys_dlist_peek_tail(events);
-	if (!pending || _is_t1_higher_prio_than_t2(pending->poller->thread,
-						   poller->thread)) {
+	if (!pending || !poller->thread ||
+	    (pending->poller->thread &&
+	     _is_t1_higher_prio_than_t2(pending->poller->thread,
+					poller->thread))) {
 		sys_dlist_append(events, &event->_node);
 		return;
 	}
 
 	SYS_DLIST_FOR_EACH_CONTAINER(events, pending, _node) {
-		if (_is_t1_higher_prio_than_t2(poller->thread,
+		if (!pending->poller->thread ||
+		    _is_t1_higher_prio_than_t2(poller->thread,
 					       pending->poller->thread)) {
 			sys_dlist_insert_before(events, &pending->_node,
 						&event->_node);
@@ -266,6 +270,147 @@ int k_poll(struct k_poll_event *events, int num_events, s32_t timeout)
 	return swap_rc;
 }
 
+/*
+ * Queue an event of a poll set as ready, and wake up the thread waiting on
+ * the set, if any. Returns 1 if a reschedule must take place, 0 otherwise.
+ *
+ * Must be called with interrupts locked.
+ */
+static int set_event_ready_in_set(struct k_poll_set *set,
+				  struct k_poll_event *event, u32_t state)
+{
+	struct k_thread *thread;
+
+	event->state |= state;
+	sys_dlist_append(&set->ready, &event->_node);
+
+	thread = _unpend_first_thread(&set->wait_q);
+	if (!thread) {
+		return 0;
+	}
+
+	_abort_thread_timeout(thread);
+	_set_thread_return_value(thread, 0);
+	_ready_thread(thread);
+
+	return !_is_in_isr() && _must_switch_threads();
+}
+
+/*
+ * Register an event of a poll set with its object, or queue it as ready if
+ * its condition is already met. Returns 1 if a reschedule must take place,
+ * 0 otherwise.
+ *
+ * Must be called with interrupts locked.
+ */
+static int arm_set_event(struct k_poll_set *set, struct k_poll_event *event)
+{
+	u32_t state;
+
+	event->state = K_POLL_STATE_NOT_READY;
+
+	if (is_condition_met(event, &state)) {
+		event->poller = &set->poller;
+		return set_event_ready_in_set(set, event, state);
+	}
+
+	(void)register_event(event, &set->poller);
+
+	return 0;
+}
+
+void k_poll_set_init(struct k_poll_set *set)
+{
+	sys_dlist_init(&set->ready);
+	sys_dlist_init(&set->returned);
+	sys_dlist_init(&set->wait_q);
+	set->poller.thread = NULL;
+	set->poller.set = set;
+}
+
+void k_poll_set_add(struct k_poll_set *set, struct k_poll_event *event)
+{
+	__ASSERT(event->type != K_POLL_TYPE_IGNORE, "cannot add ignored event\n");
+	__ASSERT(!event->poller, "event already registered\n");
+
+	unsigned int key = irq_lock();
+
+	if (arm_set_event(set, event)) {
+		(void)_Swap(key);
+	} else {
+		irq_unlock(key);
+	}
+}
+
+void k_poll_set_remove(struct k_poll_set *set, struct k_poll_event *event)
+{
+	__ASSERT(event->poller == &set->poller, "event not in set\n");
+
+	unsigned int key = irq_lock();
+
+	/* on exactly one list: its object's, or the ready or returned one */
+	sys_dlist_remove(&event->_node);
+	event->poller = NULL;
+
+	irq_unlock(key);
+}
+
+int k_poll_set_wait(struct k_poll_set *set, struct k_poll_event **events,
+		    int max_events, s32_t timeout)
+{
+	__ASSERT(!_is_in_isr(), "");
+	__ASSERT(events, "NULL events\n");
+	__ASSERT(max_events > 0, "zero events\n");
+
+	struct k_poll_event *event;
+	int num_events = 0;
+	unsigned int key;
+
+	/*
+	 * The events returned last time were taken off their objects: register
+	 * them again, which is the only per-event work done by a wait.
+	 */
+	for (;;) {
+		key = irq_lock();
+		event = (struct k_poll_event *)sys_dlist_get(&set->returned);
+		if (!event) {
+			break;
+		}
+		(void)arm_set_event(set, event);
+		irq_unlock(key);
+	}
+
+	if (sys_dlist_is_empty(&set->ready)) {
+		if (timeout == K_NO_WAIT) {
+			irq_unlock(key);
+			return -EAGAIN;
+		}
+
+		_pend_current_thread(&set->wait_q, timeout);
+
+		int swap_rc = _Swap(key);
+
+		if (swap_rc != 0) {
+			return swap_rc;
+		}
+
+		key = irq_lock();
+	}
+
+	while (num_events < max_events) {
+		event = (struct k_poll_event *)sys_dlist_get(&set->ready);
+		if (!event) {
+			break;
+		}
+		sys_dlist_append(&set->returned, &event->_node);
+		events[num_events++] = event;
+	}
+
+	irq_unlock(key);
+
+	return num_events;
+}
+
 /* must be called with interrupts locked */
 static int _signal_poll_event(struct k_poll_event *event, u32_t state,
 			      int *must_reschedule)
@@ -276,6 +421,12 @@ static int _signal_poll_event(struct k_poll_event *event, u32_t state,
 		goto ready_event;
 	}
 
+	if (event->poller->set) {
+		*must_reschedule = set_event_ready_in_set(event->poller->set,
+							  event, state);
+		return 0;
+	}
+
 	struct k_thread *thread = event->poller->thread;
 
 	__ASSERT(event->poller->thread, "poller should have a thread\n");
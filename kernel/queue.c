@@ -79,6 +79,20 @@ static inline int handle_poll_events(struct k_queue *queue)
 #endif
 }
 
+/*
+ * Returns 1 if a thread waits on the queue, either pending on it or polling
+ * it. When none does, inserting data only has to link it in: the common case
+ * of a consumer busy processing the previous items.
+ */
+static inline int has_waiters(struct k_queue *queue)
+{
+#ifdef CONFIG_POLL
+	return !sys_dlist_is_empty(&queue->poll_events);
+#else
+	return !sys_dlist_is_empty(&queue->wait_q);
+#endif
+}
+
 void k_queue_cancel_wait(struct k_queue *queue)
 {
 	unsigned int key = irq_lock();
@@ -104,9 +118,18 @@ void k_queue_cancel_wait(struct k_queue *queue)
 	irq_unlock(key);
 }
 
-void k_queue_insert(struct k_queue *queue, void *prev, void *data)
+/* must be called with interrupts locked, unlocks them */
+static void queue_insert(struct k_queue *queue, void *prev, void *data,
+			 unsigned int key)
 {
-	unsigned int key = irq_lock();
+	sys_trace_event(SYS_TRACE_QUEUE_PUT, queue, (u32_t)data);
+
+	if (likely(!has_waiters(queue))) {
+		sys_slist_insert(&queue->data_q, prev, data);
+		irq_unlock(key);
+		return;
+	}
+
 #if !defined(CONFIG_POLL)
 	struct k_thread *first_pending_thread;
 
@@ -135,21 +158,38 @@ void k_queue_insert(struct k_queue *queue, void *prev, void *data)
 	irq_unlock(key);
 }
 
+void k_queue_insert(struct k_queue *queue, void *prev, void *data)
+{
+	queue_insert(queue, prev, data, irq_lock());
+}
+
 void k_queue_append(struct k_queue *queue, void *data)
 {
-	return k_queue_insert(queue, queue->data_q.tail, data);
+	unsigned int key = irq_lock();
+
+	/* read the tail with interrupts locked: an ISR may append too */
+	queue_insert(queue, queue->data_q.tail, data, key);
 }
 
 void k_queue_prepend(struct k_queue *queue, void *data)
 {
-	return k_queue_insert(queue, NULL, data);
+	queue_insert(queue, NULL, data, irq_lock());
 }
 
 void k_queue_append_list(struct k_queue *queue, void *head, void *tail)
 {
 	__ASSERT(head && tail, "invalid head or tail");
 
+	sys_trace_event(SYS_TRACE_QUEUE_PUT, queue, (u32_t)head);
+
 	unsigned int key = irq_lock();
+
+	if (likely(!has_waiters(queue))) {
+		sys_slist_append_list(&queue->data_q, head, tail);
+		irq_unlock(key);
+		return;
+	}
+
 #if !defined(CONFIG_POLL)
 	struct k_thread *first_thread, *thread;
 
@@ -221,6 +261,8 @@ void *k_queue_get(struct k_queue *queue, s32_t timeout)
 	unsigned int key;
 	void *data;
 
+	sys_trace_event(SYS_TRACE_QUEUE_GET, queue, timeout);
+
 	key = irq_lock();
 
 	if (likely(!sys_slist_is_empty(&queue->data_q))) {
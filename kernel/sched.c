@@ -10,10 +10,20 @@
 #include <ksched.h>
 #include <wait_q.h>
 #include <misc/util.h>
+#include <spinlock.h>
 
 /* the only struct _kernel instance */
 struct _kernel _kernel = {0};
 
+/*
+ * Taken by the scheduler APIs of this file only: k_sched_unlock(),
+ * k_thread_priority_set(), k_thread_deadline_set(), k_yield(), k_sleep()
+ * and k_wakeup(). The kernel objects still make threads ready or pending
+ * under a plain irq_lock(), so this lock does not serialize them and is
+ * not sufficient on its own for SMP.
+ */
+static struct k_spinlock sched_lock;
+
 /* set the bit corresponding to prio in ready q bitmap */
 #ifdef CONFIG_MULTITHREADING
 static void _set_ready_q_prio_bit(int prio)
@@ -36,6 +46,28 @@ static void _clear_ready_q_prio_bit(int prio)
 }
 #endif
 
+#ifdef CONFIG_SCHED_DEADLINE
+/*
+ * Insert thread in its priority queue, after all threads with an earlier or
+ * equal deadline, so the head of each queue is always the thread with the
+ * earliest deadline and equal deadlines are served first-in first-out.
+ */
+static void _insert_by_deadline(sys_dlist_t *q, struct k_thread *thread)
+{
+	struct k_thread *t;
+
+	SYS_DLIST_FOR_EACH_CONTAINER(q, t, base.k_q_node) {
+		if (_is_t1_higher_prio_than_t2(thread, t)) {
+			sys_dlist_insert_before(q, &t->base.k_q_node,
+						&thread->base.k_q_node);
+			return;
+		}
+	}
+
+	sys_dlist_append(q, &thread->base.k_q_node);
+}
+#endif
+
 #ifdef CONFIG_MULTITHREADING
 /*
  * Find the next thread to run when there is no thread in the cache and update
@@ -75,7 +107,11 @@ void _add_thread_to_ready_q(struct k_thread *thread)
 	sys_dlist_t *q = &_ready_q.q[q_index];
 
 	_set_ready_q_prio_bit(thread->base.prio);
+#ifdef CONFIG_SCHED_DEADLINE
+	_insert_by_deadline(q, thread);
+#else
 	sys_dlist_append(q, &thread->base.k_q_node);
+#endif
 
 	struct k_thread **cache = &_ready_q.cache;
 
@@ -85,6 +121,13 @@ void _add_thread_to_ready_q(struct k_thread *thread)
 	_ready_q.prio_bmap[0] = 1;
 	_ready_q.cache = thread;
 #endif
+
+#ifdef CONFIG_THREAD_RUNTIME_STATS
+	_thread_runtime_stats_ready(thread);
+#endif
+#ifdef CONFIG_INT_LATENCY_BENCHMARK
+	_int_latency_thread_ready(thread);
+#endif
 }
 
 /*
@@ -113,6 +156,10 @@ void _remove_thread_from_ready_q(struct k_thread *thread)
 	_ready_q.cache = NULL;
 	sys_dlist_remove(&thread->base.k_q_node);
 #endif
+
+#ifdef CONFIG_THREAD_RUNTIME_STATS
+	_thread_runtime_stats_unready(thread);
+#endif
 }
 
 /* reschedule threads if the scheduler is not locked */
@@ -134,6 +181,16 @@ void _reschedule_threads(int key)
 #endif
 }
 
+/*
+ * Release the scheduler lock and reschedule: the interrupt lock is handed
+ * over to the context switch, if any.
+ */
+static void _sched_unlock_reschedule(k_spinlock_key_t key)
+{
+	k_spin_release(&sched_lock);
+	_reschedule_threads(key.key);
+}
+
 void k_sched_lock(void)
 {
 #ifdef CONFIG_PREEMPT_ENABLED
@@ -158,16 +215,16 @@ void k_sched_unlock(void)
 	__ASSERT(_current->base.sched_locked != 0, "");
 	__ASSERT(!_is_in_isr(), "");
 
-	int key = irq_lock();
+	k_spinlock_key_t key = k_spin_lock(&sched_lock);
 
-	/* compiler_barrier() not needed, comes from irq_lock() */
+	/* compiler_barrier() not needed, comes from k_spin_lock() */
 
 	++_current->base.sched_locked;
 
 	K_DEBUG("scheduler unlocked (%p:%d)\n",
 		_current, _current->base.sched_locked);
 
-	_reschedule_threads(key);
+	_sched_unlock_reschedule(key);
 #endif
 }
 
@@ -251,7 +308,12 @@ int __must_switch_threads(void)
 	_dump_ready_q();
 #endif  /* CONFIG_KERNEL_DEBUG */
 
+#ifdef CONFIG_SCHED_DEADLINE
+	/* the cache also accounts for deadlines within the same priority */
+	return _is_t1_higher_prio_than_t2(_get_next_ready_thread(), _current);
+#else
 	return _is_prio_higher(_get_highest_ready_prio(), _current->base.prio);
+#endif
 #else
 	return 0;
 #endif
@@ -272,11 +334,34 @@ void k_thread_priority_set(k_tid_t tid, int prio)
 	__ASSERT(!_is_in_isr(), "");
 
 	struct k_thread *thread = (struct k_thread *)tid;
-	int key = irq_lock();
+	k_spinlock_key_t key = k_spin_lock(&sched_lock);
 
 	_thread_priority_set(thread, prio);
-	_reschedule_threads(key);
+	_sched_unlock_reschedule(key);
+}
+
+#ifdef CONFIG_SCHED_DEADLINE
+void k_thread_deadline_set(k_tid_t tid, int deadline)
+{
+	struct k_thread *thread = (struct k_thread *)tid;
+	k_spinlock_key_t key = k_spin_lock(&sched_lock);
+
+	/* re-sort the thread in its priority queue if it is ready */
+	if (_is_thread_ready(thread)) {
+		_remove_thread_from_ready_q(thread);
+		thread->base.prio_deadline = k_cycle_get_32() + deadline;
+		_add_thread_to_ready_q(thread);
+	} else {
+		thread->base.prio_deadline = k_cycle_get_32() + deadline;
+	}
+
+	if (_is_in_isr()) {
+		k_spin_unlock(&sched_lock, key);
+	} else {
+		_sched_unlock_reschedule(key);
+	}
 }
+#endif
 
 /*
  * Interrupts must be locked when calling this function.
@@ -296,7 +381,12 @@ void _move_thread_to_end_of_prio_q(struct k_thread *thread)
 	}
 
 	sys_dlist_remove(&thread->base.k_q_node);
+#ifdef CONFIG_SCHED_DEADLINE
+	/* only move behind the threads that do not have a later deadline */
+	_insert_by_deadline(q, thread);
+#else
 	sys_dlist_append(q, &thread->base.k_q_node);
+#endif
 
 	struct k_thread **cache = &_ready_q.cache;
 
@@ -308,28 +398,29 @@ void k_yield(void)
 {
 	__ASSERT(!_is_in_isr(), "");
 
-	int key = irq_lock();
+	k_spinlock_key_t key = k_spin_lock(&sched_lock);
 
 	_move_thread_to_end_of_prio_q(_current);
 
 	if (_current == _get_next_ready_thread()) {
-		irq_unlock(key);
+		k_spin_unlock(&sched_lock, key);
 #ifdef CONFIG_STACK_SENTINEL
 		_check_stack_sentinel();
 #endif
 	} else {
-		_Swap(key);
+		k_spin_release(&sched_lock);
+		_Swap(key.key);
 	}
 }
 
 void k_sleep(s32_t duration)
 {
 #ifdef CONFIG_MULTITHREADING
-	/* volatile to guarantee that irq_lock() is executed after ticks is
+	/* volatile to guarantee that k_spin_lock() is executed after ticks is
 	 * populated
 	 */
 	volatile s32_t ticks;
-	unsigned int key;
+	k_spinlock_key_t key;
 
 	__ASSERT(!_is_in_isr(), "");
 	__ASSERT(duration != K_FOREVER, "");
@@ -343,36 +434,37 @@ void k_sleep(s32_t duration)
 	}
 
 	ticks = _TICK_ALIGN + _ms_to_ticks(duration);
-	key = irq_lock();
+	key = k_spin_lock(&sched_lock);
 
 	_remove_thread_from_ready_q(_current);
 	_add_thread_timeout(_current, NULL, ticks);
 
-	_Swap(key);
+	k_spin_release(&sched_lock);
+	_Swap(key.key);
 #endif
 }
 
 void k_wakeup(k_tid_t thread)
 {
-	int key = irq_lock();
+	k_spinlock_key_t key = k_spin_lock(&sched_lock);
 
 	/* verify first if thread is not waiting on an object */
 	if (_is_thread_pending(thread)) {
-		irq_unlock(key);
+		k_spin_unlock(&sched_lock, key);
 		return;
 	}
 
 	if (_abort_thread_timeout(thread) == _INACTIVE) {
-		irq_unlock(key);
+		k_spin_unlock(&sched_lock, key);
 		return;
 	}
 
 	_ready_thread(thread);
 
 	if (_is_in_isr()) {
-		irq_unlock(key);
+		k_spin_unlock(&sched_lock, key);
 	} else {
-		_reschedule_threads(key);
+		_sched_unlock_reschedule(key);
 	}
 }
 
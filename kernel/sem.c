@@ -24,6 +24,7 @@
 #include <wait_q.h>
 #include <misc/dlist.h>
 #include <ksched.h>
+#include <contention.h>
 #include <init.h>
 #include <syscall_handler.h>
 
@@ -64,6 +65,7 @@ void _impl_k_sem_init(struct k_sem *sem, unsigned int initial_count,
 #if defined(CONFIG_POLL)
 	sys_dlist_init(&sem->poll_events);
 #endif
+	_contention_init(sem);
 
 	SYS_TRACING_OBJ_INIT(k_sem, sem);
 
@@ -146,6 +148,8 @@ void _impl_k_sem_give(struct k_sem *sem)
 {
 	unsigned int key;
 
+	sys_trace_event(SYS_TRACE_SEM_GIVE, sem, sem->count);
+
 	key = irq_lock();
 
 	if (do_sem_give(sem)) {
@@ -172,22 +176,32 @@ int _impl_k_sem_take(struct k_sem *sem, s32_t timeout)
 {
 	__ASSERT(!_is_in_isr() || timeout == K_NO_WAIT, "");
 
+	sys_trace_event(SYS_TRACE_SEM_TAKE, sem, timeout);
+
 	unsigned int key = irq_lock();
 
 	if (likely(sem->count > 0)) {
 		sem->count--;
+		_contention_acquired(sem);
 		irq_unlock(key);
 		return 0;
 	}
 
 	if (timeout == K_NO_WAIT) {
+		_contention_failed(sem);
 		irq_unlock(key);
 		return -EBUSY;
 	}
 
+	u32_t wait_start = _contention_wait_start();
+
 	_pend_current_thread(&sem->wait_q, timeout);
 
-	return _Swap(key);
+	int ret = _Swap(key);
+
+	_contention_wait_end(sem, wait_start, ret == 0);
+
+	return ret;
 }
 
 #ifdef CONFIG_USERSPACE
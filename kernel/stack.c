@@ -44,44 +44,139 @@ SYS_INIT(init_stack_module, PRE_KERNEL_1, CONFIG_KERNEL_INIT_PRIORITY_OBJECTS);
 
 #endif /* CONFIG_OBJECT_TRACING */
 
+/*
+ * The number of values held is kept in a single atomic word, so that values
+ * can be popped with a compare-and-swap instead of locking interrupts. Its
+ * low half is the count, and its high half a tag, incremented on every
+ * update: without it a pop preempted between reading the top values and
+ * swapping in the lower count could succeed after these values were popped
+ * and others pushed in their place.
+ *
+ * Pushes still lock interrupts. A value is written above the top before the
+ * count covers it, and a push preempting another would write to the same
+ * entry; a freed memory slab block, by contrast, belongs to the thread that
+ * frees it until the compare-and-swap publishes it.
+ */
+#define STACK_COUNT_MASK	0xffff
+#define STACK_TAG_INC		0x10000
+
 void k_stack_init(struct k_stack *stack, u32_t *buffer, int num_entries)
 {
+	__ASSERT(num_entries <= STACK_COUNT_MASK, "too many stack entries");
+
 	sys_dlist_init(&stack->wait_q);
-	stack->next = stack->base = buffer;
+	stack->base = buffer;
 	stack->top = stack->base + num_entries;
+	atomic_set(&stack->count, 0);
 
 	SYS_TRACING_OBJ_INIT(k_stack, stack);
 	_k_object_init(stack);
 }
 
+/*
+ * Hand a value to the first thread waiting on the stack, if any. Must be
+ * called with interrupts locked.
+ */
+static struct k_thread *stack_hand_over(struct k_stack *stack, u32_t data)
+{
+	struct k_thread *thread = _unpend_first_thread(&stack->wait_q);
+
+	if (thread) {
+		_abort_thread_timeout(thread);
+		_ready_thread(thread);
+
+		_set_thread_return_value_with_data(thread, 0, (void *)data);
+	}
+
+	return thread;
+}
+
+/* push values on top of the stack; must be called with interrupts locked */
+static ALWAYS_INLINE void stack_store(struct k_stack *stack,
+				      const u32_t *data, int num)
+{
+	atomic_val_t old = atomic_get(&stack->count);
+	int count = old & STACK_COUNT_MASK;
+	int i;
+
+	__ASSERT(stack->top - stack->base >= count + num, "stack is full");
+
+	for (i = 0; i < num; i++) {
+		stack->base[count + i] = data[i];
+	}
+
+	atomic_set(&stack->count,
+		   ((old + STACK_TAG_INC) & ~STACK_COUNT_MASK) | (count + num));
+}
+
+/* pop up to num values without locking interrupts, return how many */
+static ALWAYS_INLINE int stack_take(struct k_stack *stack, u32_t *data,
+				    int num)
+{
+	atomic_val_t old, new;
+	int count, i;
+
+	do {
+		old = atomic_get(&stack->count);
+		count = old & STACK_COUNT_MASK;
+		/* only meaningful if the CAS below succeeds */
+		for (i = 0; i < num && i < count; i++) {
+			data[i] = stack->base[count - 1 - i];
+		}
+		new = ((old + STACK_TAG_INC) & ~STACK_COUNT_MASK) | (count - i);
+	} while (i > 0 && !atomic_cas(&stack->count, old, new));
+
+	return i;
+}
+
 void k_stack_push(struct k_stack *stack, u32_t data)
 {
-	struct k_thread *first_pending_thread;
 	unsigned int key;
 
-	__ASSERT(stack->next != stack->top, "stack is full");
-
 	key = irq_lock();
 
-	first_pending_thread = _unpend_first_thread(&stack->wait_q);
+	/* nobody waits, which is the common case */
+	if (likely(sys_dlist_is_empty(&stack->wait_q)) ||
+	    !stack_hand_over(stack, data)) {
+		stack_store(stack, &data, 1);
+		irq_unlock(key);
+		return;
+	}
+
+	if (!_is_in_isr() && _must_switch_threads()) {
+		(void)_Swap(key);
+		return;
+	}
 
-	if (first_pending_thread) {
-		_abort_thread_timeout(first_pending_thread);
-		_ready_thread(first_pending_thread);
+	irq_unlock(key);
+}
 
-		_set_thread_return_value_with_data(first_pending_thread,
-						   0, (void *)data);
+void k_stack_push_n(struct k_stack *stack, const u32_t *data, int num)
+{
+	unsigned int key;
+	int woken = 0;
 
-		if (!_is_in_isr() && _must_switch_threads()) {
-			(void)_Swap(key);
-			return;
+	__ASSERT(num > 0, "nothing to push");
+
+	key = irq_lock();
+
+	/* the first values go to the waiters, as with one push per value */
+	if (unlikely(!sys_dlist_is_empty(&stack->wait_q))) {
+		while (woken < num && stack_hand_over(stack, data[woken])) {
+			woken++;
 		}
-	} else {
-		*(stack->next) = data;
-		stack->next++;
 	}
 
-	irq_unlock(key);
+	if (woken < num) {
+		stack_store(stack, &data[woken], num - woken);
+	}
+
+	if (likely(!woken) || _is_in_isr() || !_must_switch_threads()) {
+		irq_unlock(key);
+		return;
+	}
+
+	(void)_Swap(key);
 }
 
 int k_stack_pop(struct k_stack *stack, u32_t *data, s32_t timeout)
@@ -89,25 +184,68 @@ int k_stack_pop(struct k_stack *stack, u32_t *data, s32_t timeout)
 	unsigned int key;
 	int result;
 
+	/* take the top value, without locking interrupts */
+	if (likely(stack_take(stack, data, 1))) {
+		return 0;
+	}
+
+	if (timeout == K_NO_WAIT) {
+		return -EBUSY;
+	}
+
 	key = irq_lock();
 
-	if (likely(stack->next > stack->base)) {
-		stack->next--;
-		*data = *(stack->next);
+	/*
+	 * A value may have been pushed before interrupts were locked. Once
+	 * they are, a push sees this thread waiting and hands the value over.
+	 */
+	if (stack_take(stack, data, 1)) {
 		irq_unlock(key);
 		return 0;
 	}
 
+	_pend_current_thread(&stack->wait_q, timeout);
+
+	result = _Swap(key);
+	if (result == 0) {
+		*data = (u32_t)_current->base.swap_data;
+	}
+	return result;
+}
+
+int k_stack_pop_n(struct k_stack *stack, u32_t *data, int num,
+		  s32_t timeout)
+{
+	unsigned int key;
+	int result, count;
+
+	__ASSERT(num > 0, "nothing to pop");
+
+	count = stack_take(stack, data, num);
+	if (likely(count)) {
+		return count;
+	}
+
 	if (timeout == K_NO_WAIT) {
-		irq_unlock(key);
 		return -EBUSY;
 	}
 
+	key = irq_lock();
+
+	/* a value may have been pushed before interrupts were locked */
+	count = stack_take(stack, data, num);
+	if (count) {
+		irq_unlock(key);
+		return count;
+	}
+
+	/* a pusher hands over a single value to a waiting thread */
 	_pend_current_thread(&stack->wait_q, timeout);
 
 	result = _Swap(key);
 	if (result == 0) {
-		*data = (u32_t)_current->base.swap_data;
+		data[0] = (u32_t)_current->base.swap_data;
+		return 1;
 	}
 	return result;
 }
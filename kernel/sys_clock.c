@@ -217,6 +217,27 @@ u32_t k_uptime_delta_32(s64_t *reftime)
 
 volatile int _handling_timeouts;
 
+#ifdef CONFIG_TIMEOUT_QUEUE_WHEEL
+static inline void handle_timeouts(s32_t ticks)
+{
+	sys_dlist_t expired;
+
+	sys_dlist_init(&expired);
+
+	_handling_timeouts = 1;
+
+	/*
+	 * The wheel marks each expired timeout as _EXPIRED and moves it to the
+	 * local queue, relieving the irq lock between each of them, in the
+	 * same order they were added.
+	 */
+	_timeout_wheel_expire(ticks, &expired);
+
+	_handle_expired_timeouts(&expired);
+
+	_handling_timeouts = 0;
+}
+#else
 static inline void handle_timeouts(s32_t ticks)
 {
 	sys_dlist_t expired;
@@ -282,6 +303,7 @@ static inline void handle_timeouts(s32_t ticks)
 
 	_handling_timeouts = 0;
 }
+#endif /* CONFIG_TIMEOUT_QUEUE_WHEEL */
 #else
 	#define handle_timeouts(ticks) do { } while ((0))
 #endif
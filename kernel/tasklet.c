@@ -0,0 +1,291 @@
+/*
+ * Copyright (c) 2017 Intel Corporation
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+/**
+ * @file
+ *
+ * @brief Stackless tasklets
+ *
+ * A tasklet is a handler that the executor thread calls until it ends,
+ * resuming each time where it last returned, as recorded by the
+ * K_TASKLET_xxx macros. Instead of pending, a waiting tasklet registers
+ * its poll event with the poll set of the executor and returns: the
+ * executor thread waits on that set for all its tasklets at once, with the
+ * earliest of their deadlines as timeout, and makes the tasklets whose
+ * event was signaled or whose deadline passed runnable again.
+ *
+ * Only the executor thread touches the poll set and the timeouts list. The
+ * runnable list is also appended to by k_tasklet_start(), from any context,
+ * which then raises the kick signal of the executor.
+ */
+
+#include <kernel.h>
+#include <kernel_structs.h>
+#include <init.h>
+
+/* most events handled per wait of the executor */
+#define EVENTS_PER_WAIT 8
+
+/* must be called with interrupts locked */
+static void runnable_add(struct k_tasklet_executor *executor,
+			 struct k_tasklet *tasklet)
+{
+	tasklet->state = _TASKLET_RUNNABLE;
+	sys_slist_append(&executor->runnable, &tasklet->node);
+}
+
+static void timeout_add(struct k_tasklet_executor *executor,
+			struct k_tasklet *tasklet)
+{
+	struct k_tasklet *prev = NULL, *next;
+
+	SYS_SLIST_FOR_EACH_CONTAINER(&executor->timeouts, next, node) {
+		if ((s32_t)(tasklet->deadline - next->deadline) < 0) {
+			break;
+		}
+		prev = next;
+	}
+
+	sys_slist_insert(&executor->timeouts, prev ? &prev->node : NULL,
+			 &tasklet->node);
+}
+
+void _k_tasklet_timeout_set(struct k_tasklet *tasklet, s32_t timeout)
+{
+	tasklet->result = 0;
+
+	if (timeout == K_NO_WAIT) {
+		tasklet->timeout = _TASKLET_NO_WAIT;
+	} else if (timeout == K_FOREVER) {
+		tasklet->timeout = _TASKLET_FOREVER;
+	} else {
+		tasklet->timeout = _TASKLET_DEADLINE;
+		tasklet->deadline = k_uptime_get_32() + timeout;
+	}
+}
+
+int _k_tasklet_wait(struct k_tasklet *tasklet, u32_t type, void *obj)
+{
+	struct k_tasklet_executor *executor = tasklet->executor;
+
+	if (tasklet->timeout == _TASKLET_NO_WAIT) {
+		return -EBUSY;
+	}
+
+	tasklet->state = _TASKLET_WAITING;
+
+	if (type != K_POLL_TYPE_IGNORE) {
+		k_poll_event_init(&tasklet->event, type,
+				  K_POLL_MODE_NOTIFY_ONLY, obj);
+		k_poll_set_add(&executor->set, &tasklet->event);
+	}
+
+	if (tasklet->timeout == _TASKLET_DEADLINE) {
+		timeout_add(executor, tasklet);
+	}
+
+	return 0;
+}
+
+void _k_tasklet_yield(struct k_tasklet *tasklet)
+{
+	unsigned int key = irq_lock();
+
+	runnable_add(tasklet->executor, tasklet);
+	irq_unlock(key);
+}
+
+int k_tasklet_start(struct k_tasklet_executor *executor,
+		    struct k_tasklet *tasklet)
+{
+	unsigned int key = irq_lock();
+
+	if (tasklet->state != _TASKLET_IDLE) {
+		irq_unlock(key);
+		return -EBUSY;
+	}
+
+	tasklet->executor = executor;
+	tasklet->lc = 0;
+	runnable_add(executor, tasklet);
+
+	irq_unlock(key);
+
+	k_poll_signal(&executor->kick, 0);
+
+	return 0;
+}
+
+/*
+ * Run the tasklets that are runnable now: those made runnable meanwhile,
+ * e.g. by yielding, wait until the events have been checked.
+ */
+static void run_runnable(struct k_tasklet_executor *executor)
+{
+	struct k_tasklet *tasklet;
+	sys_slist_t batch;
+	unsigned int key;
+
+	key = irq_lock();
+	batch = executor->runnable;
+	sys_slist_init(&executor->runnable);
+	irq_unlock(key);
+
+	for (;;) {
+		tasklet = (struct k_tasklet *)sys_slist_get(&batch);
+		if (!tasklet) {
+			break;
+		}
+
+		tasklet->state = _TASKLET_RUNNING;
+		tasklet->handler(tasklet);
+
+		/* returning without waiting or yielding ends the tasklet */
+		key = irq_lock();
+		if (tasklet->state == _TASKLET_RUNNING) {
+			tasklet->state = _TASKLET_IDLE;
+			tasklet->lc = 0;
+		}
+		irq_unlock(key);
+	}
+}
+
+/* the event of a waiting tasklet was signaled */
+static void wake(struct k_tasklet_executor *executor,
+		 struct k_poll_event *event)
+{
+	struct k_tasklet *tasklet;
+	unsigned int key;
+
+	if (event == &executor->kick_event) {
+		executor->kick.signaled = 0;
+		return;
+	}
+
+	tasklet = CONTAINER_OF(event, struct k_tasklet, event);
+
+	k_poll_set_remove(&executor->set, event);
+
+	if (tasklet->timeout == _TASKLET_DEADLINE) {
+		sys_slist_find_and_remove(&executor->timeouts, &tasklet->node);
+	}
+
+	tasklet->result = 0;
+
+	key = irq_lock();
+	runnable_add(executor, tasklet);
+	irq_unlock(key);
+}
+
+/* the deadlines that passed end the waits with -EAGAIN */
+static void expire(struct k_tasklet_executor *executor)
+{
+	u32_t now = k_uptime_get_32();
+	struct k_tasklet *tasklet;
+	unsigned int key;
+
+	for (;;) {
+		tasklet = SYS_SLIST_PEEK_HEAD_CONTAINER(&executor->timeouts,
+							tasklet, node);
+		if (!tasklet || (s32_t)(tasklet->deadline - now) > 0) {
+			break;
+		}
+
+		sys_slist_remove(&executor->timeouts, NULL, &tasklet->node);
+
+		if (tasklet->event.poller) {
+			k_poll_set_remove(&executor->set, &tasklet->event);
+		}
+
+		tasklet->result = -EAGAIN;
+
+		key = irq_lock();
+		runnable_add(executor, tasklet);
+		irq_unlock(key);
+	}
+}
+
+static s32_t next_timeout(struct k_tasklet_executor *executor)
+{
+	struct k_tasklet *tasklet;
+	s32_t remaining;
+
+	if (!sys_slist_is_empty(&executor->runnable)) {
+		return K_NO_WAIT;
+	}
+
+	tasklet = SYS_SLIST_PEEK_HEAD_CONTAINER(&executor->timeouts, tasklet,
+						node);
+	if (!tasklet) {
+		return K_FOREVER;
+	}
+
+	remaining = tasklet->deadline - k_uptime_get_32();
+
+	return remaining > 0 ? remaining : K_NO_WAIT;
+}
+
+static void executor_thread_main(void *p1, void *p2, void *p3)
+{
+	struct k_tasklet_executor *executor = p1;
+	struct k_poll_event *events[EVENTS_PER_WAIT];
+	int num_events, i;
+
+	ARG_UNUSED(p2);
+	ARG_UNUSED(p3);
+
+	for (;;) {
+		run_runnable(executor);
+
+		num_events = k_poll_set_wait(&executor->set, events,
+					     ARRAY_SIZE(events),
+					     next_timeout(executor));
+
+		for (i = 0; i < num_events; i++) {
+			wake(executor, events[i]);
+		}
+
+		expire(executor);
+	}
+}
+
+void k_tasklet_executor_start(struct k_tasklet_executor *executor,
+			      k_thread_stack_t stack,
+			      size_t stack_size, int prio)
+{
+	sys_slist_init(&executor->runnable);
+	sys_slist_init(&executor->timeouts);
+
+	k_poll_set_init(&executor->set);
+	k_poll_signal_init(&executor->kick);
+	k_poll_event_init(&executor->kick_event, K_POLL_TYPE_SIGNAL,
+			  K_POLL_MODE_NOTIFY_ONLY, &executor->kick);
+	k_poll_set_add(&executor->set, &executor->kick_event);
+
+	k_thread_create(&executor->thread, stack, stack_size,
+			executor_thread_main, executor, NULL, NULL,
+			prio, 0, 0);
+}
+
+K_THREAD_STACK_DEFINE(sys_tasklet_executor_stack,
+		      CONFIG_SYSTEM_TASKLET_EXECUTOR_STACK_SIZE);
+
+struct k_tasklet_executor k_sys_tasklet_executor;
+
+static int k_sys_tasklet_executor_init(struct device *dev)
+{
+	ARG_UNUSED(dev);
+
+	k_tasklet_executor_start(&k_sys_tasklet_executor,
+				 sys_tasklet_executor_stack,
+				 K_THREAD_STACK_SIZEOF(sys_tasklet_executor_stack),
+				 CONFIG_SYSTEM_TASKLET_EXECUTOR_PRIORITY);
+
+	return 0;
+}
+
+SYS_INIT(k_sys_tasklet_executor_init, POST_KERNEL,
+	 CONFIG_KERNEL_INIT_PRIORITY_DEFAULT);
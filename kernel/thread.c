@@ -23,6 +23,7 @@
 #include <ksched.h>
 #include <wait_q.h>
 #include <atomic.h>
+#include <string.h>
 
 extern struct _static_thread_data _static_thread_data_list_start[];
 extern struct _static_thread_data _static_thread_data_list_end[];
@@ -266,7 +267,10 @@ void _setup_new_thread(struct k_thread *new_thread,
 	_new_thread(new_thread, stack, stack_size, entry, p1, p2, p3,
 		    prio, options);
 #ifdef CONFIG_USERSPACE
-	new_thread->base.perm_index = thread_index_get();
+	new_thread->perm_index = thread_index_get();
+#if CONFIG_OBJECT_CACHE_ENTRIES > 0
+	memset(&new_thread->obj_cache, 0, sizeof(new_thread->obj_cache));
+#endif
 	_k_object_init(new_thread);
 
 	/* Any given thread has access to itself */
@@ -474,6 +478,10 @@ void _init_thread_base(struct _thread_base *thread_base, int priority,
 
 	thread_base->sched_locked = 0;
 
+#ifdef CONFIG_SCHED_DEADLINE
+	thread_base->prio_deadline = 0;
+#endif
+
 	/* swap_data does not need to be initialized */
 
 	_init_thread_timeout(thread_base);
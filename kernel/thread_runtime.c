@@ -0,0 +1,84 @@
+/*
+ * Copyright (c) 2017 Intel Corporation
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+/**
+ * @file
+ *
+ * @brief Thread CPU time accounting
+ *
+ * The architecture's context switch code calls
+ * _thread_runtime_stats_switch() with interrupts locked, right before it
+ * switches from the current thread to the one in the ready queue cache.
+ * The outgoing thread is charged the time since it was switched in and,
+ * if it was preempted, starts waiting for the CPU again; the incoming
+ * thread is charged the time it has been waiting for it. The scheduler
+ * reports threads entering and leaving the ready queue otherwise.
+ */
+
+#include <kernel.h>
+#include <kernel_structs.h>
+#include <ksched.h>
+
+void _thread_runtime_stats_switch(void)
+{
+	struct k_thread *outgoing = _current;
+	struct k_thread *incoming = _ready_q.cache;
+	u32_t now = k_cycle_get_32();
+
+	outgoing->runtime.running_cycles += now - outgoing->runtime.run_stamp;
+
+	if (outgoing == incoming) {
+		outgoing->runtime.run_stamp = now;
+		return;
+	}
+
+	if (_is_thread_ready(outgoing)) {
+		outgoing->runtime.ready_stamp = now;
+	}
+
+	incoming->runtime.ready_cycles += now - incoming->runtime.ready_stamp;
+	incoming->runtime.run_stamp = now;
+	incoming->runtime.switches++;
+}
+
+/*
+ * The ready queue holds the current thread as well, which is taken off and
+ * put back by k_yield() or when pending: only the time other threads spend
+ * in it is accounted for here.
+ */
+void _thread_runtime_stats_ready(struct k_thread *thread)
+{
+	if (thread != _current) {
+		thread->runtime.ready_stamp = k_cycle_get_32();
+	}
+}
+
+void _thread_runtime_stats_unready(struct k_thread *thread)
+{
+	if (thread != _current) {
+		thread->runtime.ready_cycles +=
+			k_cycle_get_32() - thread->runtime.ready_stamp;
+	}
+}
+
+void k_thread_runtime_stats_get(k_tid_t thread,
+				struct k_thread_runtime_stats *stats)
+{
+	unsigned int key = irq_lock();
+	u32_t now = k_cycle_get_32();
+
+	stats->running_cycles = thread->runtime.running_cycles;
+	stats->ready_cycles = thread->runtime.ready_cycles;
+	stats->switches = thread->runtime.switches;
+
+	if (thread == _current) {
+		stats->running_cycles += now - thread->runtime.run_stamp;
+	} else if (_is_thread_ready(thread)) {
+		stats->ready_cycles += now - thread->runtime.ready_stamp;
+	}
+
+	irq_unlock(key);
+}
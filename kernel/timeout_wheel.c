@@ -0,0 +1,278 @@
+/*
+ * Copyright (c) 2017 Intel Corporation
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+/**
+ * @file
+ *
+ * @brief Hierarchical timer wheel backend for the kernel timeout queue.
+ *
+ * Each armed timeout is stored in a slot chosen from its absolute expiry,
+ * expressed in wheel ticks, i.e. in ticks announced to the kernel since boot.
+ * The wheel is made of CONFIG_TIMEOUT_WHEEL_LEVELS levels of 32 slots each:
+ * level n holds the timeouts whose expiry differs from the current wheel time
+ * in bits [5n, 5n + 4] at the most. When the wheel time reaches the start of
+ * a level n slot, the timeouts in that slot are cascaded down into level
+ * n - 1 (or lower), so that level 0 always holds the timeouts expiring within
+ * the current 32-tick window, one slot per tick.
+ *
+ * Timeouts too far away to fit in the wheel are kept on an overflow list,
+ * re-examined every time the wheel completes a full revolution.
+ *
+ * Adding and aborting a timeout is O(1). Announcing ticks costs O(1) per
+ * non-empty slot reached, plus the cost of cascading, which every timeout
+ * goes through at most once per level. Each level keeps a bitmap of its
+ * non-empty slots so that the next event can be found without scanning the
+ * slots, which keeps tickless idle periods cheap to announce.
+ */
+
+#include <kernel.h>
+#include <kernel_structs.h>
+#include <wait_q.h>
+#include <misc/dlist.h>
+#include <misc/__assert.h>
+
+#define WHEEL_BITS 5
+#define WHEEL_SLOTS (1 << WHEEL_BITS)
+#define WHEEL_MASK (WHEEL_SLOTS - 1)
+#define WHEEL_LEVELS CONFIG_TIMEOUT_WHEEL_LEVELS
+#define WHEEL_SPAN_MASK ((1 << (WHEEL_BITS * WHEEL_LEVELS)) - 1)
+
+struct _wheel_level {
+	/* bitmap of slots that contain at least one timeout */
+	u32_t occupied;
+
+	sys_dlist_t slot[WHEEL_SLOTS];
+};
+
+static struct {
+	/* current wheel time: wraps around, all computations are modulo 2^32 */
+	u32_t now;
+
+	/*
+	 * time announced to the wheel, ahead of the wheel time while ticks
+	 * are being announced: timeouts added meanwhile, from ISRs, count
+	 * from it so that they do not expire early
+	 */
+	u32_t target;
+
+	struct _wheel_level level[WHEEL_LEVELS];
+
+	/* timeouts beyond the range of the wheel */
+	sys_dlist_t overflow;
+} wheel;
+
+void _timeout_wheel_init(void)
+{
+	int lvl, i;
+
+	wheel.now = 0;
+	wheel.target = 0;
+
+	for (lvl = 0; lvl < WHEEL_LEVELS; lvl++) {
+		wheel.level[lvl].occupied = 0;
+		for (i = 0; i < WHEEL_SLOTS; i++) {
+			sys_dlist_init(&wheel.level[lvl].slot[i]);
+		}
+	}
+
+	sys_dlist_init(&wheel.overflow);
+}
+
+/*
+ * Find the list a timeout belongs to, based on the highest bit that differs
+ * between its expiry and the current wheel time. Since the wheel time never
+ * crosses the start of a non-empty slot without cascading it, the result
+ * stays the same for as long as the timeout sits in the wheel.
+ *
+ * A timeout expiring on the current tick goes to the current level 0 slot.
+ */
+static sys_dlist_t *wheel_list(u32_t expiry, int *lvl, int *idx)
+{
+	u32_t diff = expiry ^ wheel.now;
+
+	*lvl = diff ? (find_msb_set(diff) - 1) / WHEEL_BITS : 0;
+
+	if (*lvl >= WHEEL_LEVELS) {
+		*idx = 0;
+		return &wheel.overflow;
+	}
+
+	*idx = (expiry >> (*lvl * WHEEL_BITS)) & WHEEL_MASK;
+
+	return &wheel.level[*lvl].slot[*idx];
+}
+
+static void wheel_insert(struct _timeout *timeout)
+{
+	int lvl, idx;
+	sys_dlist_t *list = wheel_list(timeout->expiry, &lvl, &idx);
+
+	sys_dlist_append(list, &timeout->node);
+
+	if (lvl < WHEEL_LEVELS) {
+		wheel.level[lvl].occupied |= BIT(idx);
+	}
+}
+
+void _timeout_wheel_add(struct _timeout *timeout, s32_t ticks)
+{
+	__ASSERT(ticks > 0, "");
+
+	timeout->expiry = wheel.target + ticks;
+	wheel_insert(timeout);
+}
+
+void _timeout_wheel_remove(struct _timeout *timeout)
+{
+	int lvl, idx;
+	sys_dlist_t *list = wheel_list(timeout->expiry, &lvl, &idx);
+
+	sys_dlist_remove(&timeout->node);
+
+	if (lvl < WHEEL_LEVELS && sys_dlist_is_empty(list)) {
+		wheel.level[lvl].occupied &= ~BIT(idx);
+	}
+}
+
+s32_t _timeout_wheel_remaining(struct _timeout *timeout)
+{
+	return (s32_t)(timeout->expiry - wheel.target);
+}
+
+/*
+ * Number of ticks until the next slot that has to be processed, either
+ * because it expires timeouts (level 0) or because it has to be cascaded
+ * (other levels and overflow list), or 0 if the wheel is empty.
+ *
+ * Slots at or below the current position of a level are always empty: a
+ * timeout is never placed there, and they have already been processed.
+ */
+static u32_t wheel_next_event(void)
+{
+	int lvl;
+
+	for (lvl = 0; lvl < WHEEL_LEVELS; lvl++) {
+		int shift = lvl * WHEEL_BITS;
+		u32_t pos = (wheel.now >> shift) & WHEEL_MASK;
+		u32_t pending = wheel.level[lvl].occupied &
+				~((2u << pos) - 1);
+
+		if (pending) {
+			u32_t slot = find_lsb_set(pending) - 1;
+			u32_t window = ~((1 << (shift + WHEEL_BITS)) - 1);
+
+			return ((wheel.now & window) | (slot << shift)) -
+				wheel.now;
+		}
+	}
+
+	if (!sys_dlist_is_empty(&wheel.overflow)) {
+		return ((wheel.now | WHEEL_SPAN_MASK) + 1) - wheel.now;
+	}
+
+	return 0;
+}
+
+s32_t _timeout_wheel_next_expiry(void)
+{
+	u32_t next = wheel_next_event();
+
+	/*
+	 * For a timeout not in level 0 yet, this is the time when it cascades,
+	 * which is earlier than its expiry: the caller will only be woken up
+	 * earlier than strictly needed.
+	 */
+	return next ? (s32_t)next : K_FOREVER;
+}
+
+/* move all timeouts of a list back into the wheel, relative to its new time */
+static unsigned int wheel_cascade(sys_dlist_t *list, unsigned int key)
+{
+	sys_dnode_t *node;
+
+	while ((node = sys_dlist_get(list)) != NULL) {
+		wheel_insert((struct _timeout *)node);
+
+		irq_unlock(key);
+		key = irq_lock();
+	}
+
+	return key;
+}
+
+/*
+ * Advance the wheel by @a ticks, cascading the slots reached on the way and
+ * moving the timeouts that expire onto the @a expired queue, marked as
+ * _EXPIRED. Timeouts expiring on the same tick are queued in the order they
+ * were added.
+ *
+ * Interrupts are locked only for the time needed to move one timeout. The
+ * timeouts added in between count from the announced time, beyond the wheel
+ * time, so none of them expires in this call: the wheel time never crosses
+ * the slots they are put in without cascading them.
+ */
+void _timeout_wheel_expire(s32_t ticks, sys_dlist_t *expired)
+{
+	unsigned int key = irq_lock();
+
+	wheel.target = wheel.now + ticks;
+
+	while (ticks > 0) {
+		u32_t next = wheel_next_event();
+		sys_dlist_t *slot;
+		sys_dnode_t *node;
+		int lvl;
+
+		if (!next || next > (u32_t)ticks) {
+			wheel.now += ticks;
+			break;
+		}
+
+		wheel.now += next;
+		ticks -= next;
+
+		/* cascade from the top, so lower levels see what comes down */
+		if (!(wheel.now & WHEEL_SPAN_MASK)) {
+			sys_dlist_t far;
+
+			/* detach it first: some timeouts may go back to it */
+			sys_dlist_init(&far);
+			while ((node = sys_dlist_get(&wheel.overflow)) != NULL) {
+				sys_dlist_append(&far, node);
+			}
+
+			key = wheel_cascade(&far, key);
+		}
+
+		for (lvl = WHEEL_LEVELS - 1; lvl > 0; lvl--) {
+			int shift = lvl * WHEEL_BITS;
+			int idx = (wheel.now >> shift) & WHEEL_MASK;
+
+			if (wheel.now & ((1 << shift) - 1)) {
+				continue;
+			}
+
+			key = wheel_cascade(&wheel.level[lvl].slot[idx], key);
+			wheel.level[lvl].occupied &= ~BIT(idx);
+		}
+
+		slot = &wheel.level[0].slot[wheel.now & WHEEL_MASK];
+
+		while ((node = sys_dlist_get(slot)) != NULL) {
+			struct _timeout *timeout = (struct _timeout *)node;
+
+			timeout->delta_ticks_from_prev = _EXPIRED;
+			sys_dlist_append(expired, node);
+
+			irq_unlock(key);
+			key = irq_lock();
+		}
+
+		wheel.level[0].occupied &= ~BIT(wheel.now & WHEEL_MASK);
+	}
+
+	irq_unlock(key);
+}
@@ -48,6 +48,8 @@ void _timer_expiration_handler(struct _timeout *t)
 	struct k_thread *thread;
 	unsigned int key;
 
+	sys_trace_event(SYS_TRACE_TIMER_EXPIRY, timer, timer->status);
+
 	/*
 	 * if the timer is periodic, start it again; don't add _TICK_ALIGN
 	 * since we're already aligned to a tick boundary
@@ -115,6 +117,8 @@ void k_timer_start(struct k_timer *timer, s32_t duration, s32_t period)
 
 	volatile s32_t period_in_ticks, duration_in_ticks;
 
+	sys_trace_event(SYS_TRACE_TIMER_START, timer, duration);
+
 	period_in_ticks = _ms_to_ticks(period);
 	duration_in_ticks = _ms_to_ticks(duration);
 
@@ -133,6 +137,8 @@ void k_timer_start(struct k_timer *timer, s32_t duration, s32_t period)
 
 void k_timer_stop(struct k_timer *timer)
 {
+	sys_trace_event(SYS_TRACE_TIMER_STOP, timer, 0);
+
 	int key = irq_lock();
 	int inactive = (_abort_timeout(&timer->timeout) == _INACTIVE);
 
@@ -210,6 +216,9 @@ s32_t _timeout_remaining_get(struct _timeout *timeout)
 	if (timeout->delta_ticks_from_prev == _INACTIVE) {
 		remaining_ticks = 0;
 	} else {
+#ifdef CONFIG_TIMEOUT_QUEUE_WHEEL
+		remaining_ticks = _timeout_wheel_remaining(timeout);
+#else
 		/*
 		 * compute remaining ticks by walking the timeout list
 		 * and summing up the various tick deltas involved
@@ -223,6 +232,7 @@ s32_t _timeout_remaining_get(struct _timeout *timeout)
 								   &t->node);
 			remaining_ticks += t->delta_ticks_from_prev;
 		}
+#endif
 	}
 
 	irq_unlock(key);
@@ -115,18 +115,18 @@ const char *otype_to_str(enum k_objects otype)
 
 static void set_thread_perms(struct _k_object *ko, struct k_thread *thread)
 {
-	if (thread->base.perm_index < 8 * CONFIG_MAX_THREAD_BYTES) {
+	if (thread->perm_index < 8 * CONFIG_MAX_THREAD_BYTES) {
 		sys_bitfield_set_bit((mem_addr_t)&ko->perms,
-				     thread->base.perm_index);
+				     thread->perm_index);
 	}
 }
 
 
 static int test_thread_perms(struct _k_object *ko)
 {
-	if (_current->base.perm_index < 8 * CONFIG_MAX_THREAD_BYTES) {
+	if (_current->perm_index < 8 * CONFIG_MAX_THREAD_BYTES) {
 		return sys_bitfield_test_bit((mem_addr_t)&ko->perms,
-					     _current->base.perm_index);
+					     _current->perm_index);
 	}
 	return 0;
 }
@@ -165,11 +165,58 @@ void k_object_grant_access(void *object, struct k_thread *thread)
 }
 
 
+#if CONFIG_OBJECT_CACHE_ENTRIES > 0
+/* The cache only maps object addresses to their entries in the kernel
+ * object table, which never change: permissions and flags are still
+ * checked in the entry, so that changes to them take effect immediately.
+ */
+static struct _k_object *object_cache_find(void *obj)
+{
+	struct _k_object_cache *cache = &_current->obj_cache;
+	int i;
+
+	for (i = 0; i < CONFIG_OBJECT_CACHE_ENTRIES; i++) {
+		if (cache->obj[i] == obj) {
+			return cache->ko[i];
+		}
+	}
+
+	return NULL;
+}
+
+static void object_cache_add(void *obj, struct _k_object *ko)
+{
+	struct _k_object_cache *cache = &_current->obj_cache;
+
+	cache->obj[cache->next] = obj;
+	cache->ko[cache->next] = ko;
+	cache->next = (cache->next + 1) % CONFIG_OBJECT_CACHE_ENTRIES;
+}
+#else
+static inline struct _k_object *object_cache_find(void *obj)
+{
+	ARG_UNUSED(obj);
+
+	return NULL;
+}
+
+static inline void object_cache_add(void *obj, struct _k_object *ko)
+{
+	ARG_UNUSED(obj);
+	ARG_UNUSED(ko);
+}
+#endif /* CONFIG_OBJECT_CACHE_ENTRIES > 0 */
+
 int _k_object_validate(void *obj, enum k_objects otype, int init)
 {
 	struct _k_object *ko;
+	int cached = 1;
 
-	ko = _k_object_find(obj);
+	ko = object_cache_find(obj);
+	if (!ko) {
+		ko = _k_object_find(obj);
+		cached = 0;
+	}
 
 	if (!ko || ko->type != otype) {
 		printk("%p is not a %s\n", obj, otype_to_str(otype));
@@ -196,6 +243,10 @@ int _k_object_validate(void *obj, enum k_objects otype, int init)
 		return -EINVAL;
 	}
 
+	if (!cached) {
+		object_cache_add(obj, ko);
+	}
+
 	return 0;
 }
 
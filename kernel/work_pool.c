@@ -0,0 +1,177 @@
+/*
+ * Copyright (c) 2017 Intel Corporation
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+/**
+ * @file
+ *
+ * Workqueue pool support functions
+ *
+ * A pool is a queue of work items served by several threads. It does not
+ * reuse k_queue: a k_queue only wakes up one of the threads polling it, and
+ * ordering work items by priority means inserting in the middle of the
+ * queue. Idle threads pend on the pool's wait queue, and a work item
+ * submitted while one does is handed over to it directly.
+ */
+
+#include <kernel_structs.h>
+#include <ksched.h>
+#include <wait_q.h>
+
+static void work_pool_main(void *pool_ptr, void *p2, void *p3)
+{
+	struct k_work_pool *pool = pool_ptr;
+
+	ARG_UNUSED(p2);
+	ARG_UNUSED(p3);
+
+	while (1) {
+		struct k_work *work;
+		k_work_handler_t handler;
+		unsigned int key;
+		u32_t start, cycles;
+
+		key = irq_lock();
+
+		work = (struct k_work *)sys_slist_get(&pool->items);
+		if (work) {
+			pool->stats.depth--;
+			irq_unlock(key);
+		} else {
+			_pend_current_thread(&pool->wait_q, K_FOREVER);
+			(void)_Swap(key);
+			work = _current->base.swap_data;
+		}
+
+		handler = work->handler;
+
+		/* Reset pending state so it can be resubmitted by handler */
+		if (!atomic_test_and_clear_bit(work->flags,
+					       K_WORK_STATE_PENDING)) {
+			continue;
+		}
+
+		start = k_cycle_get_32();
+		handler(work);
+		cycles = k_cycle_get_32() - start;
+
+		key = irq_lock();
+		pool->stats.processed++;
+		if (cycles > pool->stats.max_handler_cycles) {
+			pool->stats.max_handler_cycles = cycles;
+		}
+		irq_unlock(key);
+
+		/* Make sure we don't hog up the CPU if the queue never (or
+		 * very rarely) gets empty.
+		 */
+		k_yield();
+	}
+}
+
+/* the queue is initialized statically, it may hold work items already */
+void k_work_pool_start(struct k_work_pool *pool, int prio)
+{
+	int i;
+
+	for (i = 0; i < pool->num_threads; i++) {
+		k_thread_stack_t stack = (k_thread_stack_t)
+			((char *)pool->stacks + i * pool->stack_stride);
+
+		k_thread_create(&pool->threads[i], stack, pool->stack_size,
+				work_pool_main, pool, NULL, NULL, prio, 0,
+				K_NO_WAIT);
+	}
+}
+
+#ifdef CONFIG_WORK_POOL_PRIORITY
+static void insert_by_prio(struct k_work_pool *pool, struct k_work *work)
+{
+	sys_snode_t *node, *prev = NULL;
+
+	/* all of the same priority is the common case: append in O(1) */
+	node = sys_slist_peek_tail(&pool->items);
+	if (!node || ((struct k_work *)node)->prio <= work->prio) {
+		sys_slist_append(&pool->items, (sys_snode_t *)work);
+		return;
+	}
+
+	SYS_SLIST_FOR_EACH_NODE(&pool->items, node) {
+		if (((struct k_work *)node)->prio > work->prio) {
+			break;
+		}
+		prev = node;
+	}
+
+	sys_slist_insert(&pool->items, prev, (sys_snode_t *)work);
+}
+#endif /* CONFIG_WORK_POOL_PRIORITY */
+
+static void work_pool_insert(struct k_work_pool *pool, struct k_work *work,
+			     int prio)
+{
+	struct k_thread *thread;
+	unsigned int key;
+
+	key = irq_lock();
+
+	if (atomic_test_and_set_bit(work->flags, K_WORK_STATE_PENDING)) {
+		irq_unlock(key);
+		return;
+	}
+
+	thread = _unpend_first_thread(&pool->wait_q);
+	if (thread) {
+		_ready_thread(thread);
+		_set_thread_return_value_with_data(thread, 0, work);
+
+		if (!_is_in_isr() && _must_switch_threads()) {
+			(void)_Swap(key);
+			return;
+		}
+
+		irq_unlock(key);
+		return;
+	}
+
+#ifdef CONFIG_WORK_POOL_PRIORITY
+	work->prio = prio;
+	insert_by_prio(pool, work);
+#else
+	ARG_UNUSED(prio);
+
+	sys_slist_append(&pool->items, (sys_snode_t *)work);
+#endif
+
+	pool->stats.depth++;
+	if (pool->stats.depth > pool->stats.max_depth) {
+		pool->stats.max_depth = pool->stats.depth;
+	}
+
+	irq_unlock(key);
+}
+
+void k_work_pool_submit(struct k_work_pool *pool, struct k_work *work)
+{
+	work_pool_insert(pool, work, 0);
+}
+
+#ifdef CONFIG_WORK_POOL_PRIORITY
+void k_work_pool_submit_prio(struct k_work_pool *pool, struct k_work *work,
+			     int prio)
+{
+	work_pool_insert(pool, work, prio);
+}
+#endif /* CONFIG_WORK_POOL_PRIORITY */
+
+void k_work_pool_stats_get(struct k_work_pool *pool,
+			   struct k_work_pool_stats *stats)
+{
+	unsigned int key = irq_lock();
+
+	*stats = pool->stats;
+
+	irq_unlock(key);
+}
@@ -7,6 +7,7 @@
  */
 
 #include <misc/ring_buffer.h>
+#include <string.h>
 
 /**
  * Internal data structure for a buffer header.
@@ -92,3 +93,110 @@ int sys_ring_buf_get(struct ring_buf *buf, u16_t *type, u8_t *value,
 
 	return 0;
 }
+
+/*
+ * Byte ring buffer: the producer and the consumer each own their indexes.
+ * The compiler barriers order the accesses to the bytes with the update of
+ * the indexes, which is all a single CPU needs for a thread and an ISR to
+ * share the ring buffer.
+ */
+
+u32_t sys_ring_buf_bytes_put_claim(struct ring_buf_bytes *buf, u8_t **data,
+				   u32_t size)
+{
+	u32_t head = buf->head;
+	u32_t offset = buf->put_tail & (buf->size - 1);
+	u32_t space = buf->size - (buf->put_tail - head);
+
+	size = min(size, min(space, buf->size - offset));
+
+	*data = &buf->buf[offset];
+	buf->put_tail += size;
+
+	return size;
+}
+
+int sys_ring_buf_bytes_put_finish(struct ring_buf_bytes *buf, u32_t size)
+{
+	if (size > buf->put_tail - buf->tail) {
+		return -EINVAL;
+	}
+
+	/* the bytes must be written before the consumer sees them */
+	compiler_barrier();
+
+	buf->tail += size;
+	buf->put_tail = buf->tail;
+
+	return 0;
+}
+
+u32_t sys_ring_buf_bytes_put(struct ring_buf_bytes *buf, const u8_t *data,
+			     u32_t size)
+{
+	u32_t claimed, total = 0;
+	u8_t *dst;
+
+	do {
+		claimed = sys_ring_buf_bytes_put_claim(buf, &dst, size);
+		memcpy(dst, data, claimed);
+		data += claimed;
+		size -= claimed;
+		total += claimed;
+	} while (size && claimed);
+
+	sys_ring_buf_bytes_put_finish(buf, total);
+
+	return total;
+}
+
+u32_t sys_ring_buf_bytes_get_claim(struct ring_buf_bytes *buf, u8_t **data,
+				   u32_t size)
+{
+	u32_t tail = buf->tail;
+	u32_t offset = buf->get_head & (buf->size - 1);
+
+	/* the bytes must not be read before the producer committed them */
+	compiler_barrier();
+
+	size = min(size, min(tail - buf->get_head, buf->size - offset));
+
+	*data = &buf->buf[offset];
+	buf->get_head += size;
+
+	return size;
+}
+
+int sys_ring_buf_bytes_get_finish(struct ring_buf_bytes *buf, u32_t size)
+{
+	if (size > buf->get_head - buf->head) {
+		return -EINVAL;
+	}
+
+	/* the bytes must be read before the producer overwrites them */
+	compiler_barrier();
+
+	buf->head += size;
+	buf->get_head = buf->head;
+
+	return 0;
+}
+
+u32_t sys_ring_buf_bytes_get(struct ring_buf_bytes *buf, u8_t *data,
+			     u32_t size)
+{
+	u32_t claimed, total = 0;
+	u8_t *src;
+
+	do {
+		claimed = sys_ring_buf_bytes_get_claim(buf, &src, size);
+		memcpy(data, src, claimed);
+		data += claimed;
+		size -= claimed;
+		total += claimed;
+	} while (size && claimed);
+
+	sys_ring_buf_bytes_get_finish(buf, total);
+
+	return total;
+}
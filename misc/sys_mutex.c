@@ -0,0 +1,31 @@
+/*
+ * Copyright (c) 2017 Intel Corporation
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+#include <misc/sys_mutex.h>
+
+int _sys_mutex_lock_contended(struct sys_mutex *mutex, s32_t timeout)
+{
+	if (timeout == K_NO_WAIT) {
+		return -EBUSY;
+	}
+
+	/* mark the mutex contended, which takes it if it got unlocked */
+	while (atomic_set(&mutex->val, SYS_MUTEX_CONTENDED) !=
+	       SYS_MUTEX_UNLOCKED) {
+		if (k_futex_wait(&mutex->val, SYS_MUTEX_CONTENDED,
+				 timeout) == -ETIMEDOUT) {
+			return -EAGAIN;
+		}
+	}
+
+	return 0;
+}
+
+void _sys_mutex_unlock_contended(struct sys_mutex *mutex)
+{
+	atomic_set(&mutex->val, SYS_MUTEX_UNLOCKED);
+	k_futex_wake(&mutex->val, 0);
+}
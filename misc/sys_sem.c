@@ -0,0 +1,39 @@
+/*
+ * Copyright (c) 2017 Intel Corporation
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+#include <misc/sys_sem.h>
+
+int _sys_sem_take_contended(struct sys_sem *sem, s32_t timeout)
+{
+	atomic_val_t count;
+	int ret;
+
+	for (;;) {
+		count = atomic_get(&sem->count);
+
+		if (count > 0) {
+			if (atomic_cas(&sem->count, count, count - 1)) {
+				return 0;
+			}
+			continue;
+		}
+
+		if (timeout == K_NO_WAIT) {
+			return -EBUSY;
+		}
+
+		/* a giver either sees the waiter, or gets the kernel not to
+		 * wait since the count is no longer zero
+		 */
+		atomic_inc(&sem->waiters);
+		ret = k_futex_wait(&sem->count, 0, timeout);
+		atomic_dec(&sem->waiters);
+
+		if (ret == -ETIMEDOUT) {
+			return -EAGAIN;
+		}
+	}
+}
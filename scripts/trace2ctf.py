@@ -0,0 +1,234 @@
+#!/usr/bin/env python3
+#
+# Copyright (c) 2017 Intel Corporation
+#
+# SPDX-License-Identifier: Apache-2.0
+
+"""Convert kernel trace buffer dumps to Common Trace Format
+
+Each input file is a memory dump of the _sys_trace_buffer variable of a
+kernel built with CONFIG_KERNEL_TRACE, one per CPU, e.g. taken with gdb:
+
+    (gdb) dump binary value trace.bin _sys_trace_buffer
+
+The output directory is a CTF trace, with one stream per CPU, that can be
+opened with babeltrace or TraceCompass.
+"""
+
+import argparse
+import os
+import struct
+import sys
+
+TRACE_MAGIC = 0x5a545243
+TRACE_VERSION = 1
+CTF_MAGIC = 0xc1fc1fc1
+
+# magic, version, record_size, num_records, cycles_per_sec, cpu, enabled, head
+HEADER = "IHHIIIII"
+RECORD = "IHHII"
+
+# event ID: name and fields, as recorded by the kernel (obj, arg)
+EVENTS = {
+    0x0001: ("context_switch", ("next_thread", "hex32_t"),
+             ("prev_thread", "hex32_t")),
+    0x0002: ("isr_enter", ("isr", "hex32_t"), None),
+    0x0003: ("isr_exit", None, None),
+    0x0004: ("sem_give", ("sem", "hex32_t"), ("count", "uint32_t")),
+    0x0005: ("sem_take", ("sem", "hex32_t"), ("timeout", "int32_t")),
+    0x0006: ("mutex_lock", ("mutex", "hex32_t"), ("timeout", "int32_t")),
+    0x0007: ("mutex_unlock", ("mutex", "hex32_t"), ("lock_count", "uint32_t")),
+    0x0008: ("queue_put", ("queue", "hex32_t"), ("data", "hex32_t")),
+    0x0009: ("queue_get", ("queue", "hex32_t"), ("timeout", "int32_t")),
+    0x000a: ("timer_start", ("timer", "hex32_t"), ("duration", "int32_t")),
+    0x000b: ("timer_stop", ("timer", "hex32_t"), None),
+    0x000c: ("timer_expiry", ("timer", "hex32_t"), ("status", "uint32_t")),
+}
+
+# application events, from SYS_TRACE_USER on, share one CTF event
+USER_EVENT_ID = 0xffff
+
+METADATA_HEADER = """/* CTF 1.8 */
+
+typealias integer { size = 8; align = 8; signed = false; } := uint8_t;
+typealias integer { size = 16; align = 8; signed = false; } := uint16_t;
+typealias integer { size = 32; align = 8; signed = false; } := uint32_t;
+typealias integer { size = 32; align = 8; signed = true; } := int32_t;
+typealias integer { size = 32; align = 8; signed = false; base = 16; } := hex32_t;
+typealias integer { size = 64; align = 8; signed = false; } := uint64_t;
+
+trace {
+	major = 1;
+	minor = 8;
+	byte_order = le;
+	packet.header := struct {
+		uint32_t magic;
+		uint32_t stream_id;
+	};
+};
+
+env {
+	domain = "zephyr";
+	tracer_name = "kernel_trace";
+};
+
+clock {
+	name = cycles;
+	freq = %d;
+	offset = 0;
+};
+
+typealias integer {
+	size = 64; align = 8; signed = false;
+	map = clock.cycles.value;
+} := cycles_t;
+
+stream {
+	id = 0;
+	packet.context := struct {
+		cycles_t timestamp_begin;
+		cycles_t timestamp_end;
+		uint64_t content_size;
+		uint64_t packet_size;
+		uint32_t cpu_id;
+	};
+	event.header := struct {
+		uint16_t id;
+		cycles_t timestamp;
+	};
+};
+"""
+
+def parse_args():
+    global args
+
+    parser = argparse.ArgumentParser(description = __doc__,
+            formatter_class = argparse.RawDescriptionHelpFormatter)
+
+    parser.add_argument("-o", "--output", required=True,
+            help="Output directory for the CTF trace")
+    parser.add_argument("dumps", nargs="+",
+            help="Trace buffer dumps, one per CPU")
+    args = parser.parse_args()
+
+def read_dump(path):
+    with open(path, "rb") as f:
+        data = f.read()
+
+    for endian in "<>":
+        header = struct.unpack_from(endian + HEADER, data)
+        if header[0] == TRACE_MAGIC:
+            break
+    else:
+        sys.exit("%s: not a kernel trace buffer dump" % path)
+
+    (_, version, record_size, num_records, freq, cpu, _, head) = header
+    if version != TRACE_VERSION:
+        sys.exit("%s: unsupported version %d" % (path, version))
+
+    records = []
+    offset = struct.calcsize(HEADER)
+
+    # only the last num_records ones are still there, and complete ones
+    for index in range(max(0, head - num_records), head):
+        slot = index % num_records
+        (timestamp, event_id, seq, obj, arg) = struct.unpack_from(
+                endian + RECORD, data, offset + slot * record_size)
+        if seq != index & 0xffff:
+            continue
+        records.append((timestamp, event_id, obj, arg))
+
+    return (cpu, freq, unwrap(records))
+
+def unwrap(records):
+    """Extend the 32-bit timestamps to 64 bits, and sort by time
+
+    Records are in the order they were reserved, which an interrupt may
+    reverse for records close in time: a step back is not a wrap around.
+    """
+    events = []
+    now = records[0][0] if records else 0
+    last = None
+
+    for (timestamp, event_id, obj, arg) in records:
+        if last is not None:
+            delta = (timestamp - last) & 0xffffffff
+            if delta >= 0x80000000:
+                delta -= 0x100000000
+            now += delta
+        last = timestamp
+        events.append((now, event_id, obj, arg))
+
+    # the CPUs share the cycle counter: keep its values, unless negative
+    if events and min(e[0] for e in events) < 0:
+        base = min(e[0] for e in events)
+        events = [(t - base, i, o, a) for (t, i, o, a) in events]
+
+    return sorted(events, key=lambda e: e[0])
+
+def metadata(freq):
+    text = METADATA_HEADER % freq
+
+    for (event_id, (name, obj, arg)) in sorted(EVENTS.items()):
+        fields = "".join("\t\t%s %s;\n" % (f[1], f[0])
+                         for f in (obj, arg) if f)
+        text += "\nevent {\n\tname = \"%s\";\n\tid = %d;\n\tstream_id = 0;\n" \
+                % (name, event_id)
+        if fields:
+            text += "\tfields := struct {\n%s\t};\n" % fields
+        text += "};\n"
+
+    text += "\nevent {\n\tname = \"user\";\n\tid = %d;\n\tstream_id = 0;\n" \
+            "\tfields := struct {\n\t\tuint16_t user_id;\n" \
+            "\t\thex32_t obj;\n\t\tuint32_t arg;\n\t};\n};\n" % USER_EVENT_ID
+
+    return text
+
+def pack_fields(event_id, obj, arg):
+    if event_id not in EVENTS:
+        return struct.pack("<HII", event_id, obj, arg)
+
+    (_, obj_field, arg_field) = EVENTS[event_id]
+    data = b""
+    for (field, value) in ((obj_field, obj), (arg_field, arg)):
+        if field:
+            fmt = "<i" if field[1] == "int32_t" else "<I"
+            if fmt == "<i" and value >= 0x80000000:
+                value -= 0x100000000
+            data += struct.pack(fmt, value)
+    return data
+
+def stream(cpu, events):
+    body = b""
+    for (timestamp, event_id, obj, arg) in events:
+        ctf_id = event_id if event_id in EVENTS else USER_EVENT_ID
+        body += struct.pack("<HQ", ctf_id, timestamp)
+        body += pack_fields(event_id, obj, arg)
+
+    begin = events[0][0] if events else 0
+    end = events[-1][0] if events else 0
+    header_size = struct.calcsize("<IIQQQQI")
+    size = (header_size + len(body)) * 8
+
+    header = struct.pack("<IIQQQQI", CTF_MAGIC, 0, begin, end, size, size,
+                         cpu)
+    return header + body
+
+def main():
+    parse_args()
+
+    dumps = [read_dump(path) for path in args.dumps]
+    freq = dumps[0][1]
+
+    os.makedirs(args.output, exist_ok=True)
+
+    with open(os.path.join(args.output, "metadata"), "w") as f:
+        f.write(metadata(freq))
+
+    for (cpu, _, events) in dumps:
+        with open(os.path.join(args.output, "stream_%d" % cpu), "wb") as f:
+            f.write(stream(cpu, events))
+        print("cpu %d: %d events" % (cpu, len(events)))
+
+if __name__ == "__main__":
+    main()
@@ -0,0 +1,143 @@
+/*
+ * Copyright (c) 2017 Intel Corporation
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+/**
+ * @file
+ * @brief Kernel trace buffer
+ *
+ * A writer reserves a record with an atomic increment of the head index,
+ * then fills it in. Since it may be interrupted by a writer of a later
+ * record, or a reader, at any point, it first marks the record as
+ * incomplete, and sets its sequence number last: a reader copies a record
+ * and only accepts the copy if its sequence number was that of the index it
+ * wanted both before and after copying it.
+ */
+
+#include <kernel.h>
+#include <kernel_structs.h>
+#include <init.h>
+#include <errno.h>
+#include <logging/kernel_trace.h>
+
+#define NUM_RECORDS CONFIG_KERNEL_TRACE_RECORDS
+
+BUILD_ASSERT_MSG((NUM_RECORDS & (NUM_RECORDS - 1)) == 0,
+		 "CONFIG_KERNEL_TRACE_RECORDS must be a power of two");
+
+/* the header is part of a memory dump: see scripts/trace2ctf.py */
+struct sys_trace_buffer {
+	u32_t magic;
+	u16_t version;
+	u16_t record_size;
+	u32_t num_records;
+	u32_t cycles_per_sec;
+	u32_t cpu;
+	volatile u32_t enabled;
+	/* index of the next record, ever increasing */
+	atomic_t head;
+	struct sys_trace_record records[NUM_RECORDS];
+};
+
+/* one per CPU */
+struct sys_trace_buffer _sys_trace_buffer = {
+	.magic = SYS_TRACE_MAGIC,
+	.version = SYS_TRACE_VERSION,
+	.record_size = sizeof(struct sys_trace_record),
+	.num_records = NUM_RECORDS,
+	.cpu = 0,
+	.enabled = 1,
+};
+
+void sys_trace_event(u16_t id, const void *obj, u32_t arg)
+{
+	struct sys_trace_buffer *buf = &_sys_trace_buffer;
+	struct sys_trace_record *record;
+	u32_t timestamp, index;
+
+	if (!buf->enabled) {
+		return;
+	}
+
+	timestamp = k_cycle_get_32();
+	index = atomic_inc(&buf->head);
+	record = &buf->records[index & (NUM_RECORDS - 1)];
+
+	/* not the sequence number of this record or of the one it replaces */
+	record->seq = (u16_t)~index;
+	compiler_barrier();
+
+	record->timestamp = timestamp;
+	record->id = id;
+	record->obj = (u32_t)obj;
+	record->arg = arg;
+
+	compiler_barrier();
+	record->seq = (u16_t)index;
+}
+
+void _sys_trace_context_switch(void)
+{
+	sys_trace_event(SYS_TRACE_CONTEXT_SWITCH, _kernel.ready_q.cache,
+			(u32_t)_kernel.current);
+}
+
+void _sys_trace_isr_enter(void *isr)
+{
+	sys_trace_event(SYS_TRACE_ISR_ENTER, isr, 0);
+}
+
+void _sys_trace_isr_exit(void)
+{
+	sys_trace_event(SYS_TRACE_ISR_EXIT, NULL, 0);
+}
+
+void sys_trace_enable(int enable)
+{
+	_sys_trace_buffer.enabled = enable;
+}
+
+u32_t sys_trace_head(void)
+{
+	return atomic_get(&_sys_trace_buffer.head);
+}
+
+int sys_trace_get(u32_t index, struct sys_trace_record *record)
+{
+	struct sys_trace_record *in_buf;
+
+	if (sys_trace_head() - index - 1 >= NUM_RECORDS) {
+		/* overwritten, or not written yet */
+		return -ENOENT;
+	}
+
+	in_buf = &_sys_trace_buffer.records[index & (NUM_RECORDS - 1)];
+
+	if (in_buf->seq != (u16_t)index) {
+		return -ENOENT;
+	}
+	compiler_barrier();
+
+	*record = *in_buf;
+
+	compiler_barrier();
+	if (in_buf->seq != (u16_t)index) {
+		return -ENOENT;
+	}
+
+	return 0;
+}
+
+static int sys_trace_init(struct device *unused)
+{
+	ARG_UNUSED(unused);
+
+	/* known once the system clock driver is initialized */
+	_sys_trace_buffer.cycles_per_sec = sys_clock_hw_cycles_per_sec;
+
+	return 0;
+}
+
+SYS_INIT(sys_trace_init, POST_KERNEL, CONFIG_KERNEL_INIT_PRIORITY_DEFAULT);
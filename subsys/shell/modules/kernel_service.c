@@ -8,6 +8,8 @@
 #include <shell/shell.h>
 #include <init.h>
 #include <debug/object_tracing.h>
+#include <debug/int_latency.h>
+#include <power.h>
 
 #define SHELL_KERNEL "kernel"
 
@@ -68,6 +70,48 @@ static int shell_cmd_tasks(int argc, char *argv[])
 #endif
 
 
+#if defined(CONFIG_THREAD_RUNTIME_STATS) && defined(CONFIG_THREAD_MONITOR)
+static u32_t percent(u64_t part, u64_t total)
+{
+	return total ? (u32_t)(part * 100 / total) : 0;
+}
+
+static u32_t cycles_to_ms(u64_t cycles)
+{
+	return (u32_t)(cycles / (sys_clock_hw_cycles_per_sec / MSEC_PER_SEC));
+}
+
+static int shell_cmd_top(int argc, char *argv[])
+{
+	ARG_UNUSED(argc);
+	ARG_UNUSED(argv);
+	struct k_thread *thread_list = NULL;
+	struct k_thread_runtime_stats stats;
+	struct k_cpu_runtime_stats cpu;
+
+	k_cpu_runtime_stats_get(&cpu);
+
+	printk("cpu: %u%% busy, %u%% idle since boot\n",
+	       percent(cpu.total_cycles - cpu.idle_cycles, cpu.total_cycles),
+	       percent(cpu.idle_cycles, cpu.total_cycles));
+	printk(" thread        cpu  running ms  ready ms  switches\n");
+
+	thread_list   = (struct k_thread *)SYS_THREAD_MONITOR_HEAD;
+	while (thread_list != NULL) {
+		k_thread_runtime_stats_get(thread_list, &stats);
+		printk("%s%p  %3u%%  %10u  %8u  %8u\n",
+		       (thread_list == k_current_get()) ? "*" : " ",
+		       thread_list,
+		       percent(stats.running_cycles, cpu.total_cycles),
+		       cycles_to_ms(stats.running_cycles),
+		       cycles_to_ms(stats.ready_cycles),
+		       stats.switches);
+		thread_list = (struct k_thread *)SYS_THREAD_MONITOR_NEXT(thread_list);
+	}
+	return 0;
+}
+#endif
+
 #if defined(CONFIG_INIT_STACKS)
 static int shell_cmd_stack(int argc, char *argv[])
 {
@@ -76,6 +120,165 @@ static int shell_cmd_stack(int argc, char *argv[])
 }
 #endif
 
+#if defined(CONFIG_MEM_POOL_CACHE)
+/* Linker-defined symbols bound the static pool structs */
+extern struct k_mem_pool _k_mem_pool_list_start[];
+extern struct k_mem_pool _k_mem_pool_list_end[];
+
+static int shell_cmd_mempools(int argc, char *argv[])
+{
+	ARG_UNUSED(argc);
+	ARG_UNUSED(argv);
+	struct k_mem_pool_cache_stats stats;
+	struct k_mem_pool *pool;
+
+	printk("memory pool caches:\n");
+
+	for (pool = _k_mem_pool_list_start; pool < _k_mem_pool_list_end;
+	     pool++) {
+		k_mem_pool_cache_stats_get(pool, &stats);
+		printk("%p:   hits: %u misses: %u flushes: %u\n",
+		       pool, stats.hits, stats.misses, stats.flushes);
+	}
+	return 0;
+}
+#endif
+
+#if defined(CONFIG_MEM_SLAB_STATS)
+static void print_mem_slab(struct k_mem_slab *slab, void *user_data)
+{
+	struct k_mem_slab_stats stats;
+
+	ARG_UNUSED(user_data);
+
+	k_mem_slab_stats_get(slab, &stats);
+	printk("%p  %6u  %6u  %6u  %6u  %3u%%  %8u\n",
+	       slab, (u32_t)stats.block_size, stats.num_blocks,
+	       stats.num_used, stats.max_used,
+	       stats.max_used * 100 / stats.num_blocks, stats.alloc_failures);
+}
+
+static int shell_cmd_memslabs(int argc, char *argv[])
+{
+	ARG_UNUSED(argc);
+	ARG_UNUSED(argv);
+
+	printk("slab        block  blocks    used     max  max%%  failures\n");
+	k_mem_slab_foreach(print_mem_slab, NULL);
+	return 0;
+}
+#endif
+
+#if defined(CONFIG_INT_LATENCY_BENCHMARK)
+static int shell_cmd_latency(int argc, char *argv[])
+{
+	ARG_UNUSED(argc);
+	ARG_UNUSED(argv);
+
+	int_latency_show();
+	return 0;
+}
+#endif
+
+#if defined(CONFIG_SYS_POWER_IDLE_GOVERNOR)
+static int shell_cmd_idle(int argc, char *argv[])
+{
+	ARG_UNUSED(argc);
+	ARG_UNUSED(argv);
+	const struct sys_pm_idle_state *states;
+	struct sys_pm_idle_state_stats stats;
+	struct sys_pm_idle_wake_source
+		sources[CONFIG_SYS_POWER_IDLE_GOVERNOR_WAKE_SOURCES];
+	int num_states, state, n, i;
+
+	num_states = sys_pm_idle_states_get(&states);
+
+	printk(" entries  residency ms  too short  too long  state\n");
+	for (state = SYS_PM_IDLE_CPU; state < num_states; state++) {
+		sys_pm_idle_stats_get(state, &stats);
+		printk("%8u  %12u  %9u  %8u  %s\n",
+		       stats.entries, (u32_t)(stats.residency_us / 1000),
+		       stats.too_short, stats.too_long,
+		       state == SYS_PM_IDLE_CPU ? "cpu" : states[state].name);
+	}
+
+	n = sys_pm_idle_wake_sources_get(sources, ARRAY_SIZE(sources));
+
+	printk("   wakes  interval us  deviation us  source\n");
+	for (i = 0; i < n; i++) {
+		printk("%8u  %11u  %12u  ", sources[i].wakes,
+		       sources[i].interval_us, sources[i].deviation_us);
+		if (sources[i].source == SYS_PM_IDLE_WAKE_TIMER) {
+			printk("timer\n");
+		} else if (sources[i].source == SYS_PM_IDLE_WAKE_UNKNOWN) {
+			printk("unknown\n");
+		} else {
+			printk("%p\n", sources[i].source);
+		}
+	}
+	return 0;
+}
+#endif
+
+#if defined(CONFIG_CONTENTION_STATS)
+static u32_t cycles_to_us(u64_t cycles)
+{
+	return (u32_t)(SYS_CLOCK_HW_CYCLES_TO_NS64(cycles) / NSEC_PER_USEC);
+}
+
+static void print_contention(void *obj, const char *type,
+			     struct k_contention_stats *stats)
+{
+	int i;
+
+	if (stats->acquisitions == 0 && stats->failures == 0) {
+		return;
+	}
+
+	printk("%p  %8u  %9u  %6u  %6u  %13u  %6u  %s\n",
+	       obj, stats->acquisitions, stats->contended, stats->failures,
+	       stats->prio_boosts, cycles_to_us(stats->wait_cycles),
+	       cycles_to_us(stats->max_wait_cycles), type);
+
+	for (i = 0; i < CONFIG_CONTENTION_TOP_WAITERS; i++) {
+		if (stats->top_waiters[i].thread == NULL) {
+			break;
+		}
+		printk("  waiter %p  %8u  %10u\n",
+		       stats->top_waiters[i].thread,
+		       stats->top_waiters[i].waits,
+		       cycles_to_us(stats->top_waiters[i].wait_cycles));
+	}
+}
+
+static int shell_cmd_contention(int argc, char *argv[])
+{
+	ARG_UNUSED(argc);
+	ARG_UNUSED(argv);
+	struct k_contention_stats stats;
+	struct k_mutex *mutex;
+	struct k_sem *sem;
+
+	printk("object      acquired  contended  failed  boosts  "
+	       "wait total us  max us  type\n");
+
+	mutex = SYS_TRACING_HEAD(struct k_mutex, k_mutex);
+	while (mutex != NULL) {
+		k_mutex_contention_get(mutex, &stats);
+		print_contention(mutex, "mutex", &stats);
+		mutex = SYS_TRACING_NEXT(struct k_mutex, k_mutex, mutex);
+	}
+
+	sem = SYS_TRACING_HEAD(struct k_sem, k_sem);
+	while (sem != NULL) {
+		k_sem_contention_get(sem, &stats);
+		print_contention(sem, "sem", &stats);
+		sem = SYS_TRACING_NEXT(struct k_sem, k_sem, sem);
+	}
+	return 0;
+}
+#endif
+
 struct shell_cmd kernel_commands[] = {
 	{ "version", shell_cmd_version, "show kernel version" },
 	{ "uptime", shell_cmd_uptime, "show system uptime in milliseconds" },
@@ -83,8 +286,28 @@ struct shell_cmd kernel_commands[] = {
 #if defined(CONFIG_OBJECT_TRACING) && defined(CONFIG_THREAD_MONITOR)
 	{ "tasks", shell_cmd_tasks, "show running tasks" },
 #endif
+#if defined(CONFIG_THREAD_RUNTIME_STATS) && defined(CONFIG_THREAD_MONITOR)
+	{ "top", shell_cmd_top, "show CPU usage of threads" },
+#endif
 #if defined(CONFIG_INIT_STACKS)
 	{ "stacks", shell_cmd_stack, "show system stacks" },
+#endif
+#if defined(CONFIG_MEM_POOL_CACHE)
+	{ "mempools", shell_cmd_mempools, "show memory pool cache statistics" },
+#endif
+#if defined(CONFIG_MEM_SLAB_STATS)
+	{ "memslabs", shell_cmd_memslabs, "show memory slab usage" },
+#endif
+#if defined(CONFIG_INT_LATENCY_BENCHMARK)
+	{ "latency", shell_cmd_latency,
+	  "show interrupt latencies and start a new sampling interval" },
+#endif
+#if defined(CONFIG_SYS_POWER_IDLE_GOVERNOR)
+	{ "idle", shell_cmd_idle, "show low power state residencies" },
+#endif
+#if defined(CONFIG_CONTENTION_STATS)
+	{ "contention", shell_cmd_contention,
+	  "show mutex and semaphore contention" },
 #endif
 	{ NULL, NULL, NULL }
 };
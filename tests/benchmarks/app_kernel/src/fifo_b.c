@@ -10,6 +10,71 @@
 
 #ifdef FIFO_BENCH
 
+#define FIFO_BATCH_SIZE 10
+
+/**
+ *
+ * @brief Batched and in place queue transfer speed test
+ *
+ * Puts and gets NR_OF_FIFO_RUNS messages FIFO_BATCH_SIZE at a time, then
+ * puts them again and reads them in place, one at a time.
+ *
+ * @param queue     Message queue to use, empty.
+ * @param msg_size  Size of its messages, in bytes, for the report.
+ *
+ * @return N/A
+ */
+static void queue_batch_test(struct k_msgq *queue, int msg_size)
+{
+	char label[64];
+	u32_t et; /* elapsed time */
+	void *msg;
+	int i;
+
+	et = BENCH_START();
+	for (i = 0; i < NR_OF_FIFO_RUNS; i += FIFO_BATCH_SIZE) {
+		k_msgq_put_batch(queue, data_bench, FIFO_BATCH_SIZE, K_FOREVER);
+	}
+	et = TIME_STAMP_DELTA_GET(et);
+	check_result();
+
+	snprintf(label, sizeof(label),
+		 "enqueue %d bytes msg in FIFO, %d per batch",
+		 msg_size, FIFO_BATCH_SIZE);
+	PRINT_F(output_file, FORMAT, label,
+			SYS_CLOCK_HW_CYCLES_TO_NS_AVG(et, NR_OF_FIFO_RUNS));
+
+	et = BENCH_START();
+	for (i = 0; i < NR_OF_FIFO_RUNS; i += FIFO_BATCH_SIZE) {
+		k_msgq_get_batch(queue, data_bench, FIFO_BATCH_SIZE, K_FOREVER);
+	}
+	et = TIME_STAMP_DELTA_GET(et);
+	check_result();
+
+	snprintf(label, sizeof(label),
+		 "dequeue %d bytes msg in FIFO, %d per batch",
+		 msg_size, FIFO_BATCH_SIZE);
+	PRINT_F(output_file, FORMAT, label,
+			SYS_CLOCK_HW_CYCLES_TO_NS_AVG(et, NR_OF_FIFO_RUNS));
+
+	for (i = 0; i < NR_OF_FIFO_RUNS; i += FIFO_BATCH_SIZE) {
+		k_msgq_put_batch(queue, data_bench, FIFO_BATCH_SIZE, K_FOREVER);
+	}
+
+	et = BENCH_START();
+	for (i = 0; i < NR_OF_FIFO_RUNS; i++) {
+		k_msgq_peek_claim(queue, &msg);
+		k_msgq_peek_finish(queue);
+	}
+	et = TIME_STAMP_DELTA_GET(et);
+	check_result();
+
+	snprintf(label, sizeof(label),
+		 "dequeue %d bytes msg in FIFO, in place", msg_size);
+	PRINT_F(output_file, FORMAT, label,
+			SYS_CLOCK_HW_CYCLES_TO_NS_AVG(et, NR_OF_FIFO_RUNS));
+}
+
 /**
  *
  * @brief Queue transfer speed test
@@ -61,6 +126,30 @@ void queue_test(void)
 	PRINT_F(output_file, FORMAT, "dequeue 4 bytes msg in FIFO",
 			SYS_CLOCK_HW_CYCLES_TO_NS_AVG(et, NR_OF_FIFO_RUNS));
 
+	et = BENCH_START();
+	for (i = 0; i < NR_OF_FIFO_RUNS; i++) {
+		k_msgq_put(&DEMOQX8, data_bench, K_FOREVER);
+	}
+	et = TIME_STAMP_DELTA_GET(et);
+	check_result();
+
+	PRINT_F(output_file, FORMAT, "enqueue 8 bytes msg in FIFO",
+			SYS_CLOCK_HW_CYCLES_TO_NS_AVG(et, NR_OF_FIFO_RUNS));
+
+	et = BENCH_START();
+	for (i = 0; i < NR_OF_FIFO_RUNS; i++) {
+		k_msgq_get(&DEMOQX8, data_bench, K_FOREVER);
+	}
+	et = TIME_STAMP_DELTA_GET(et);
+	check_result();
+
+	PRINT_F(output_file, FORMAT, "dequeue 8 bytes msg in FIFO",
+			SYS_CLOCK_HW_CYCLES_TO_NS_AVG(et, NR_OF_FIFO_RUNS));
+
+	queue_batch_test(&DEMOQX1, 1);
+	queue_batch_test(&DEMOQX4, 4);
+	queue_batch_test(&DEMOQX8, 8);
+
 	k_sem_give(&STARTRCV);
 
 	et = BENCH_START();
@@ -41,6 +41,7 @@ K_THREAD_DEFINE(RECVTASK, 1024, recvtask, NULL, NULL, NULL, 5, 0, K_NO_WAIT);
 
 K_MSGQ_DEFINE(DEMOQX1, 1, 500, 4);
 K_MSGQ_DEFINE(DEMOQX4, 4, 500, 4);
+K_MSGQ_DEFINE(DEMOQX8, 8, 500, 4);
 K_MSGQ_DEFINE(MB_COMM, 12, 1, 4);
 K_MSGQ_DEFINE(CH_COMM, 12, 1, 4);
 
@@ -62,6 +63,7 @@ K_PIPE_DEFINE(PIPE_SMALLBUFF, 256, 4);
 K_PIPE_DEFINE(PIPE_BIGBUFF, 4096, 4);
 
 K_MEM_POOL_DEFINE(DEMOPOOL, 16, 16, 1, 4);
+K_MEM_POOL_DEFINE(SPLITPOOL, 16, 1024, 1, 4);
 
 K_ALERT_DEFINE(TEST_EVENT, NULL, 1);
 
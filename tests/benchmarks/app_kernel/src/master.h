@@ -140,6 +140,7 @@ extern struct k_sem STARTRCV;
 
 extern struct k_msgq DEMOQX1;
 extern struct k_msgq DEMOQX4;
+extern struct k_msgq DEMOQX8;
 extern struct k_msgq MB_COMM;
 extern struct k_msgq CH_COMM;
 
@@ -156,6 +157,7 @@ extern struct k_mem_slab MAP1;
 extern struct k_alert TEST_EVENT;
 
 extern struct k_mem_pool DEMOPOOL;
+extern struct k_mem_pool SPLITPOOL;
 
 
 
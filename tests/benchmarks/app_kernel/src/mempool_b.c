@@ -22,6 +22,9 @@ void mempool_test(void)
 	int i;
 	s32_t return_value = 0;
 	struct k_mem_block block;
+#ifdef CONFIG_MEM_POOL_CACHE
+	struct k_mem_pool_cache_stats stats;
+#endif
 
 	PRINT_STRING(dashline, output_file);
 	et = BENCH_START();
@@ -41,6 +44,32 @@ void mempool_test(void)
 	PRINT_F(output_file, FORMAT,
 		"average alloc and dealloc memory pool block",
 		SYS_CLOCK_HW_CYCLES_TO_NS_AVG(et, (2 * NR_OF_POOL_RUNS)));
+
+	/* smallest block of a pool that has to split and merge 3 levels */
+	et = BENCH_START();
+	for (i = 0; i < NR_OF_POOL_RUNS; i++) {
+		return_value |= k_mem_pool_alloc(&SPLITPOOL,
+						&block,
+						16,
+						K_FOREVER);
+		k_mem_pool_free(&block);
+	}
+	et = TIME_STAMP_DELTA_GET(et);
+	check_result();
+
+	if (return_value != 0) {
+		k_panic();
+	}
+	PRINT_F(output_file, FORMAT,
+		"average alloc and dealloc split memory pool block",
+		SYS_CLOCK_HW_CYCLES_TO_NS_AVG(et, (2 * NR_OF_POOL_RUNS)));
+
+#ifdef CONFIG_MEM_POOL_CACHE
+	k_mem_pool_cache_stats_get(&SPLITPOOL, &stats);
+	PRINT_F(output_file, FORMAT,
+		"split memory pool block cache hits",
+		stats.hits);
+#endif
 }
 
 #endif /* MEMPOOL_BENCH */
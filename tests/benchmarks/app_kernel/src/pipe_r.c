@@ -17,6 +17,8 @@
  */
 int pipeget(struct k_pipe *pipe, enum pipe_options option,
 			int size, int count, unsigned int *time);
+int pipeget_claim(struct k_pipe *pipe, int size, int count,
+		  unsigned int *time);
 
 /*
  * Function declarations.
@@ -71,6 +73,20 @@ void piperecvtask(void)
 	}
 	}
 
+	/* matching, in place (claim/finish) */
+
+	for (getsize = 8; getsize <= MESSAGE_SIZE_PIPE; getsize <<= 1) {
+		for (pipe = 1; pipe < 3; pipe++) {
+			getcount = NR_OF_PIPE_RUNS;
+			pipeget_claim(test_pipes[pipe], getsize,
+				      getcount, &gettime);
+			getinfo.time = gettime;
+			getinfo.size = getsize;
+			getinfo.count = getcount;
+			/* acknowledge to master */
+			k_msgq_put(&CH_COMM, &getinfo, K_FOREVER);
+		}
+	}
 }
 
 
@@ -141,4 +157,55 @@ int pipeget(struct k_pipe *pipe, enum pipe_options option, int size, int count,
 	return 0;
 }
 
+/**
+ *
+ * @brief Read data in place from the pipe and measure time
+ *
+ * The data is consumed directly from the pipe's buffer, so no copy is made.
+ *
+ * @return 0 on success, 1 on error
+ *
+ * @param pipe     Pipe to read data from.
+ * @param size     Data chunk size.
+ * @param count    Number of data chunks.
+ * @param time     Total read time.
+ */
+int pipeget_claim(struct k_pipe *pipe, int size, int count,
+		  unsigned int *time)
+{
+	unsigned int t;
+	size_t size2xfer_total = size * count;
+
+	/* sync with the sender */
+	k_sem_take(&SEM0, K_FOREVER);
+	t = BENCH_START();
+	while (size2xfer_total) {
+		size_t claimed = size2xfer_total;
+		void *data;
+
+		if (k_pipe_get_claim(pipe, &data, &claimed, K_FOREVER) != 0) {
+			return 1;
+		}
+		k_pipe_get_finish(pipe, claimed);
+		size2xfer_total -= claimed;
+	}
+
+	t = TIME_STAMP_DELTA_GET(t);
+	*time = SYS_CLOCK_HW_CYCLES_TO_NS_AVG(t, count);
+	if (bench_test_end() < 0) {
+		if (high_timer_overflow()) {
+			PRINT_STRING("| Timer overflow. "
+			"Results are invalid            ",
+						 output_file);
+		} else {
+			PRINT_STRING("| Tick occurred. "
+			"Results may be inaccurate       ",
+						 output_file);
+		}
+		PRINT_STRING("                             |\n",
+					 output_file);
+	}
+	return 0;
+}
+
 #endif /* PIPE_BENCH */
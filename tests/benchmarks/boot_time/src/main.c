@@ -14,9 +14,13 @@
  *  2. From __start to main()
  *  3. From __start to task
  *  4. From __start to idle
+ *
+ * and how long each device took to initialize, with
+ * CONFIG_DEVICE_INIT_PROFILING.
  */
 
 #include <zephyr.h>
+#include <device.h>
 
 #include <tc_util.h>
 
@@ -25,6 +29,10 @@ extern u64_t __start_time_stamp;    /* timestamp when kernel begins executing */
 extern u64_t __main_time_stamp;     /* timestamp when main() begins executing */
 extern u64_t __idle_time_stamp;     /* timestamp when CPU went idle */
 
+#ifdef CONFIG_DEVICE_INIT_PARALLEL
+extern int check_parallel_init(void);
+#endif
+
 void main(void)
 {
 	u64_t task_time_stamp;      /* timestamp at beginning of first task  */
@@ -35,6 +43,7 @@ void main(void)
 	u64_t s_task_time_stamp;    /*__start->task timestamp		 */
 	u64_t idle_us;       /* begin of idle timestamp in us	 */
 	u64_t s_idle_time_stamp;    /*__start->idle timestamp		 */
+	int result = TC_PASS;
 
 	task_time_stamp = (u64_t)k_cycle_get_32();
 
@@ -72,10 +81,19 @@ void main(void)
 		 (u32_t)(s_idle_time_stamp & 0xFFFFFFFFULL),
 		 (u32_t)  (idle_us  & 0xFFFFFFFFULL));
 
+#ifdef CONFIG_DEVICE_INIT_PROFILING
+	TC_PRINT("Device initialization:\n");
+	device_init_profile_show();
+#endif
+
+#ifdef CONFIG_DEVICE_INIT_PARALLEL
+	result = check_parallel_init();
+#endif
+
 	TC_PRINT("Boot Time Measurement finished\n");
 
 	/* for sanity regression test utility. */
-	TC_END_RESULT(TC_PASS);
-	TC_END_REPORT(TC_PASS);
+	TC_END_RESULT(result);
+	TC_END_REPORT(result);
 
 }
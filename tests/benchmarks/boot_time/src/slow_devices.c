@@ -0,0 +1,88 @@
+/*
+ * Copyright (c) 2017 Intel Corporation
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+/**
+ * @file
+ * @brief Slow devices, initialized in parallel
+ *
+ * Each device waits for its hardware for SLOW_DEVICE_DELAY ms. slow_a and
+ * slow_b are independent, so are initialized concurrently, while slow_c
+ * depends on slow_a.
+ */
+
+#include <zephyr.h>
+#include <device.h>
+#include <init.h>
+#include <tc_util.h>
+
+#define SLOW_DEVICE_DELAY 50
+
+static int slow_device_init(struct device *dev)
+{
+	ARG_UNUSED(dev);
+
+	k_sleep(SLOW_DEVICE_DELAY);
+	return 0;
+}
+
+DEVICE_INIT(slow_a, "SLOW_A", slow_device_init, NULL, NULL,
+	    POST_KERNEL, CONFIG_KERNEL_INIT_PRIORITY_DEVICE);
+DEVICE_INIT_PARALLEL(slow_a);
+
+DEVICE_INIT(slow_b, "SLOW_B", slow_device_init, NULL, NULL,
+	    POST_KERNEL, CONFIG_KERNEL_INIT_PRIORITY_DEVICE);
+DEVICE_INIT_PARALLEL(slow_b);
+
+DEVICE_INIT(slow_c, "SLOW_C", slow_device_init, NULL, NULL,
+	    POST_KERNEL, CONFIG_KERNEL_INIT_PRIORITY_DEVICE);
+DEVICE_INIT_PARALLEL(slow_c, DEVICE_GET(slow_a));
+
+static const struct device_init_record *find_record(struct device *dev)
+{
+	const struct device_init_record *records;
+	int count = device_init_profile_get(&records);
+	int i;
+
+	for (i = 0; i < min(count, CONFIG_DEVICE_INIT_PROFILING_RECORDS); i++) {
+		if (records[i].dev == dev) {
+			return &records[i];
+		}
+	}
+
+	return NULL;
+}
+
+int check_parallel_init(void)
+{
+	const struct device_init_record *a = find_record(DEVICE_GET(slow_a));
+	const struct device_init_record *b = find_record(DEVICE_GET(slow_b));
+	const struct device_init_record *c = find_record(DEVICE_GET(slow_c));
+
+	if (!a || !b || !c) {
+		TC_PRINT("slow devices not profiled\n");
+		return TC_FAIL;
+	}
+
+	if (!a->parallel || !b->parallel || !c->parallel) {
+		TC_PRINT("slow devices not initialized in parallel\n");
+		return TC_FAIL;
+	}
+
+	/* disjoint if either one starts once the other has ended */
+	if ((s32_t)(b->start - a->end) >= 0 ||
+	    (s32_t)(a->start - b->end) >= 0) {
+		TC_PRINT("independent slow devices not initialized "
+			 "concurrently\n");
+		return TC_FAIL;
+	}
+
+	if ((s32_t)(c->start - a->end) < 0) {
+		TC_PRINT("slow device initialized before its dependency\n");
+		return TC_FAIL;
+	}
+
+	return TC_PASS;
+}
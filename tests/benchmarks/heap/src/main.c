@@ -0,0 +1,158 @@
+/*
+ * Copyright (c) 2017 Intel Corporation
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+/**
+ * @file
+ * @brief Measure the latency and the memory efficiency of the heap
+ *
+ * Runs the same pseudo-random workload of variable-sized allocations, mostly
+ * small as for e.g. serialized messages, and reports:
+ *  1. the average and worst case time of k_malloc() and k_free()
+ *  2. how many bytes can be allocated in a fresh heap before the first
+ *     failure, as a percentage of the heap size
+ *  3. the same once the heap has been fragmented by the workload
+ *
+ * Build with prj.conf for the memory pool heap and with prj_tlsf.conf for
+ * the two-level segregated fit heap to compare both allocators.
+ */
+
+#include <zephyr.h>
+#include <tc_util.h>
+
+#define NB_OF_OPS 10000
+#define NB_OF_SLOTS 32
+#define MAX_FILL_BLOCKS 1024
+
+#define HEAP_SIZE CONFIG_HEAP_MEM_POOL_SIZE
+
+static void *slots[NB_OF_SLOTS];
+static void *fill_blocks[MAX_FILL_BLOCKS];
+
+static u32_t seed;
+
+static u32_t rand32(void)
+{
+	/* Numerical Recipes LCG: reproducible from one run to the other */
+	seed = seed * 1664525 + 1013904223;
+	return seed >> 8;
+}
+
+/* mostly small payloads, with a few larger ones */
+static size_t rand_size(void)
+{
+	return rand32() % 8 ? 8 + rand32() % 120 : 128 + rand32() % 512;
+}
+
+static void free_slots(void)
+{
+	int i;
+
+	for (i = 0; i < NB_OF_SLOTS; i++) {
+		k_free(slots[i]);
+		slots[i] = NULL;
+	}
+}
+
+static void measure_latency(void)
+{
+	u32_t alloc_cycles = 0, alloc_max = 0, nb_allocs = 0;
+	u32_t free_cycles = 0, free_max = 0, nb_frees = 0;
+	u32_t failures = 0;
+	u32_t stamp, delta;
+	int i, slot;
+
+	for (i = 0; i < NB_OF_OPS; i++) {
+		slot = rand32() % NB_OF_SLOTS;
+
+		if (slots[slot]) {
+			stamp = k_cycle_get_32();
+			k_free(slots[slot]);
+			delta = k_cycle_get_32() - stamp;
+
+			slots[slot] = NULL;
+			free_cycles += delta;
+			free_max = max(free_max, delta);
+			nb_frees++;
+		} else {
+			size_t size = rand_size();
+
+			stamp = k_cycle_get_32();
+			slots[slot] = k_malloc(size);
+			delta = k_cycle_get_32() - stamp;
+
+			if (!slots[slot]) {
+				failures++;
+				continue;
+			}
+			alloc_cycles += delta;
+			alloc_max = max(alloc_max, delta);
+			nb_allocs++;
+		}
+	}
+
+	TC_PRINT("k_malloc: average %6u nsec, worst %6u nsec, %u failed\n",
+		 SYS_CLOCK_HW_CYCLES_TO_NS_AVG(alloc_cycles, nb_allocs),
+		 SYS_CLOCK_HW_CYCLES_TO_NS(alloc_max), failures);
+	TC_PRINT("k_free:   average %6u nsec, worst %6u nsec\n",
+		 SYS_CLOCK_HW_CYCLES_TO_NS_AVG(free_cycles, nb_frees),
+		 SYS_CLOCK_HW_CYCLES_TO_NS(free_max));
+}
+
+/* allocate until the first failure: returns the number of bytes obtained */
+static size_t fill_heap(void)
+{
+	size_t total = 0;
+	int i, n;
+
+	for (n = 0; n < MAX_FILL_BLOCKS; n++) {
+		size_t size = rand_size();
+
+		fill_blocks[n] = k_malloc(size);
+		if (!fill_blocks[n]) {
+			break;
+		}
+		total += size;
+	}
+
+	for (i = 0; i < n; i++) {
+		k_free(fill_blocks[i]);
+	}
+
+	return total;
+}
+
+void main(void)
+{
+	size_t fresh, fragmented;
+	int status = TC_PASS;
+
+	TC_START("Heap benchmark");
+
+	TC_PRINT("Heap of %d bytes, %d operations on %d blocks\n",
+		 HEAP_SIZE, NB_OF_OPS, NB_OF_SLOTS);
+
+	seed = 1;
+	fresh = fill_heap();
+
+	measure_latency();
+
+	/* the blocks left by the workload fragment the heap */
+	fragmented = fill_heap();
+	free_slots();
+
+	TC_PRINT("usable in a fresh heap:      %6u bytes (%u%%)\n",
+		 (u32_t)fresh, (u32_t)(fresh * 100 / HEAP_SIZE));
+	TC_PRINT("usable in a fragmented heap: %6u bytes (%u%%)\n",
+		 (u32_t)fragmented, (u32_t)(fragmented * 100 / HEAP_SIZE));
+
+	if (!fresh) {
+		TC_ERROR("nothing could be allocated\n");
+		status = TC_FAIL;
+	}
+
+	TC_END_RESULT(status);
+	TC_END_REPORT(status);
+}
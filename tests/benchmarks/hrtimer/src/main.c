@@ -0,0 +1,173 @@
+/*
+ * Copyright (c) 2017 Intel Corporation
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+/**
+ * @file
+ * @brief Measure the lateness of high-resolution timers
+ *
+ * Reports the average and worst delay between the time a timer was due and
+ * the run of its expiry function:
+ *  1. for one-shot k_hrtimer of a few sub-millisecond durations
+ *  2. for each period of a periodic k_hrtimer
+ *  3. for a one millisecond k_timer, for comparison
+ */
+
+#include <zephyr.h>
+#include <tc_util.h>
+
+#define NB_OF_EXPIRIES 100
+
+#define PERIOD_US 250
+
+static const u32_t durations_us[] = { 50, 200, 500 };
+
+static struct k_hrtimer hrtimer;
+static struct k_timer timer;
+static K_SEM_DEFINE(done, 0, 1);
+
+/* cycle count the timer is due at, and lateness of the expiries so far */
+static u32_t due;
+static u32_t total;
+static u32_t worst;
+static int expiries;
+
+static void reset_stats(u32_t due_at)
+{
+	due = due_at;
+	total = 0;
+	worst = 0;
+	expiries = 0;
+}
+
+static void record(u32_t now)
+{
+	u32_t late = now - due;
+
+	total += late;
+	if (late > worst) {
+		worst = late;
+	}
+	expiries++;
+}
+
+static void print_stats(const char *what)
+{
+	TC_PRINT("%-28s %6u nsec %6u nsec\n", what,
+		 SYS_CLOCK_HW_CYCLES_TO_NS_AVG(total, expiries),
+		 SYS_CLOCK_HW_CYCLES_TO_NS(worst));
+}
+
+static void oneshot_expiry(struct k_hrtimer *t)
+{
+	ARG_UNUSED(t);
+
+	record(k_cycle_get_32());
+	k_sem_give(&done);
+}
+
+static void periodic_expiry(struct k_hrtimer *t)
+{
+	record(k_cycle_get_32());
+	due += t->period;
+
+	if (expiries == NB_OF_EXPIRIES) {
+		k_hrtimer_stop(t);
+		k_sem_give(&done);
+	}
+}
+
+static void timer_expiry(struct k_timer *t)
+{
+	ARG_UNUSED(t);
+
+	record(k_cycle_get_32());
+	k_sem_give(&done);
+}
+
+static void measure_oneshot(u32_t us)
+{
+	u32_t cycles = k_hrtimer_us_to_cycles(us);
+	char what[28];
+	int i;
+
+	k_hrtimer_init(&hrtimer, oneshot_expiry);
+	reset_stats(0);
+
+	for (i = 0; i < NB_OF_EXPIRIES; i++) {
+		unsigned int key = irq_lock();
+
+		due = k_cycle_get_32() + cycles;
+		k_hrtimer_start(&hrtimer, cycles, 0);
+		irq_unlock(key);
+
+		k_sem_take(&done, K_FOREVER);
+	}
+
+	snprintk(what, sizeof(what), "k_hrtimer %4u usec", us);
+	print_stats(what);
+}
+
+static void measure_periodic(void)
+{
+	u32_t cycles = k_hrtimer_us_to_cycles(PERIOD_US);
+	unsigned int key;
+
+	k_hrtimer_init(&hrtimer, periodic_expiry);
+
+	key = irq_lock();
+	reset_stats(k_cycle_get_32() + cycles);
+	k_hrtimer_start(&hrtimer, cycles, cycles);
+	irq_unlock(key);
+
+	k_sem_take(&done, K_FOREVER);
+
+	print_stats("k_hrtimer  " STRINGIFY(PERIOD_US) " usec periodic");
+}
+
+static void measure_timer(void)
+{
+	u32_t cycles = k_hrtimer_us_to_cycles(USEC_PER_MSEC);
+	int i;
+
+	k_timer_init(&timer, timer_expiry, NULL);
+	reset_stats(0);
+
+	for (i = 0; i < NB_OF_EXPIRIES; i++) {
+		unsigned int key = irq_lock();
+
+		due = k_cycle_get_32() + cycles;
+		k_timer_start(&timer, K_MSEC(1), 0);
+		irq_unlock(key);
+
+		k_sem_take(&done, K_FOREVER);
+	}
+
+	print_stats("k_timer      1 msec");
+}
+
+void main(void)
+{
+	int i;
+
+	TC_START("High-resolution timer benchmark");
+
+	/* keep the cycle count running while no tick is programmed */
+	k_enable_sys_clock_always_on();
+
+	TC_PRINT("%d expiries, lateness of the expiry function\n",
+		 NB_OF_EXPIRIES);
+	TC_PRINT("timer                           average       worst\n");
+
+	for (i = 0; i < ARRAY_SIZE(durations_us); i++) {
+		measure_oneshot(durations_us[i]);
+	}
+
+	measure_periodic();
+	measure_timer();
+
+	TC_END_RESULT(TC_PASS);
+	TC_END_REPORT(TC_PASS);
+}
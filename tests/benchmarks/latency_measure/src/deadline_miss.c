@@ -0,0 +1,201 @@
+/*
+ * Copyright (c) 2017 Intel Corporation
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+/**
+ * @file
+ * This file contains the benchmark that measures the deadline miss rate of a
+ * set of periodic threads, scheduled with fixed priorities and with the
+ * earliest-deadline-first scheduling class.
+ *
+ * Each periodic thread is released by a kernel timer and has to complete a
+ * fixed amount of busy work before its next release (implicit deadline). The
+ * same task set, which uses about 94% of the CPU, is run three times:
+ *
+ *  - all threads at the same priority, served first-in first-out
+ *  - rate-monotonic priorities: the shorter the period, the higher the prio
+ *  - all threads at the same priority, with a deadline set on each release
+ *
+ * The utilization is above the rate-monotonic schedulability bound for three
+ * tasks (~78%), but below 100%, so only EDF is expected to meet all deadlines.
+ */
+
+#include <zephyr.h>
+#include <timestamp.h>
+#include "utils.h"
+
+#define DL_NUM_TASKS    3
+#define DL_STACK_SIZE   512
+#define DL_PRIORITY     5
+#define DL_RUN_TIME     K_SECONDS(3)
+
+/* number of loops used to calibrate the busy work */
+#define DL_CALIBRATION_LOOPS 100000
+
+enum dl_mode {
+	DL_FIFO,
+	DL_RATE_MONOTONIC,
+	DL_EDF,
+};
+
+static const char * const dl_mode_names[] = {
+	"same priority, FIFO",
+	"rate-monotonic priorities",
+	"same priority, EDF",
+};
+
+struct dl_task {
+	s32_t period;    /* in ms */
+	s32_t work;      /* in ms */
+	int rm_prio;
+	struct k_timer timer;
+	struct k_thread thread;
+	u32_t releases;
+	u32_t misses;
+};
+
+static struct dl_task dl_tasks[DL_NUM_TASKS] = {
+	{ .period = 20, .work = 8, .rm_prio = DL_PRIORITY - 2 },
+	{ .period = 30, .work = 9, .rm_prio = DL_PRIORITY - 1 },
+	{ .period = 50, .work = 12, .rm_prio = DL_PRIORITY },
+};
+
+K_THREAD_STACK_ARRAY_DEFINE(dl_stacks, DL_NUM_TASKS, DL_STACK_SIZE);
+
+static volatile int dl_running;
+static u32_t loops_per_ms;
+
+static void busy_work(s32_t ms)
+{
+	volatile u32_t i;
+
+	for (i = 0; i < ms * loops_per_ms; i++) {
+		/* spin */
+	}
+}
+
+static void calibrate(void)
+{
+	u32_t cycles_per_ms = sys_clock_hw_cycles_per_sec / MSEC_PER_SEC;
+	volatile u32_t i;
+	u32_t start;
+
+	start = k_cycle_get_32();
+	for (i = 0; i < DL_CALIBRATION_LOOPS; i++) {
+		/* spin */
+	}
+
+	loops_per_ms = (u64_t)DL_CALIBRATION_LOOPS * cycles_per_ms /
+		       (k_cycle_get_32() - start);
+}
+
+static void dl_task_entry(void *p1, void *p2, void *p3)
+{
+	struct dl_task *task = p1;
+	int mode = (int)p2;
+	int period_cycles = task->period *
+			    (sys_clock_hw_cycles_per_sec / MSEC_PER_SEC);
+	u32_t released = 0;
+
+	ARG_UNUSED(p3);
+
+	while (dl_running) {
+		if (!released) {
+			released = k_timer_status_sync(&task->timer);
+			if (!released) {
+				/* timer stopped: end of the run */
+				break;
+			}
+		}
+		released--;
+
+		if (mode == DL_EDF) {
+			k_thread_deadline_set(k_current_get(), period_cycles);
+		}
+
+		busy_work(task->work);
+		task->releases++;
+
+		/* next period started before this one completed: missed */
+		released += k_timer_status_get(&task->timer);
+		if (released) {
+			task->misses++;
+		}
+	}
+}
+
+static void run_task_set(enum dl_mode mode)
+{
+	u32_t releases = 0;
+	u32_t misses = 0;
+	int i;
+
+	dl_running = 1;
+
+	for (i = 0; i < DL_NUM_TASKS; i++) {
+		struct dl_task *task = &dl_tasks[i];
+
+		task->releases = 0;
+		task->misses = 0;
+		k_timer_init(&task->timer, NULL, NULL);
+		k_thread_create(&task->thread, dl_stacks[i], DL_STACK_SIZE,
+				dl_task_entry, task, (void *)mode, NULL,
+				mode == DL_RATE_MONOTONIC ?
+					task->rm_prio : DL_PRIORITY,
+				0, K_NO_WAIT);
+	}
+
+	/* release all tasks at the same time */
+	for (i = 0; i < DL_NUM_TASKS; i++) {
+		k_timer_start(&dl_tasks[i].timer, dl_tasks[i].period,
+			      dl_tasks[i].period);
+	}
+
+	k_sleep(DL_RUN_TIME);
+
+	/* the tasks preempt this thread and exit as soon as they wake up */
+	dl_running = 0;
+	for (i = 0; i < DL_NUM_TASKS; i++) {
+		k_timer_stop(&dl_tasks[i].timer);
+	}
+	k_sleep(K_MSEC(100));
+
+	PRINT_FORMAT(" %s:", dl_mode_names[mode]);
+	for (i = 0; i < DL_NUM_TASKS; i++) {
+		PRINT_FORMAT("   period %2d ms, work %2d ms: %3u of %3u"
+			     " deadlines missed", dl_tasks[i].period,
+			     dl_tasks[i].work, dl_tasks[i].misses,
+			     dl_tasks[i].releases);
+		releases += dl_tasks[i].releases;
+		misses += dl_tasks[i].misses;
+	}
+
+	PRINT_FORMAT("   deadline miss rate: %u.%u %%",
+		     releases ? misses * 100 / releases : 0,
+		     releases ? (misses * 1000 / releases) % 10 : 0);
+}
+
+/**
+ *
+ * @brief Entry point for the deadline miss rate test
+ *
+ * @return N/A
+ */
+void deadline_miss(void)
+{
+	PRINT_FORMAT(" 7 - Measure deadline miss rate of periodic threads,"
+		     " fixed prio vs EDF");
+
+	calibrate();
+
+	run_task_set(DL_FIFO);
+	run_task_set(DL_RATE_MONOTONIC);
+	run_task_set(DL_EDF);
+
+	if (dl_tasks[0].releases == 0) {
+		error_count++;
+		PRINT_FORMAT(" Error, periodic threads did not run");
+	}
+}
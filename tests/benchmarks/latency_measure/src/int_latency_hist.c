@@ -0,0 +1,129 @@
+/*
+ * Copyright (c) 2017 Intel Corporation
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+/**
+ * @file
+ * This file contains the benchmark that reports the distribution of the
+ * interrupt latencies tracked by the kernel's interrupt latency benchmark.
+ *
+ * Software interrupts are raised repeatedly, each waking a higher priority
+ * thread, and interrupts are locked for varying lengths of time in between.
+ * The entry latency of the software interrupts is recorded by their handler.
+ */
+
+#include <zephyr.h>
+#include <irq_offload.h>
+#include <debug/int_latency.h>
+
+#include "timestamp.h"
+#include "utils.h"
+
+#define HIST_ITERATIONS 1000
+#define HIST_SITES 4
+
+K_SEM_DEFINE(hist_sema, 0, 1);
+
+static u32_t irq_raised_timestamp;
+
+static void hist_isr(void *unused)
+{
+	ARG_UNUSED(unused);
+
+	int_latency_record(INT_LATENCY_ISR_ENTRY,
+			   TIME_STAMP_DELTA_GET(irq_raised_timestamp));
+	k_sem_give(&hist_sema);
+}
+
+/* higher priority than the test thread: runs as the ISR returns */
+static void hist_waiter(void)
+{
+	while (1) {
+		k_sem_take(&hist_sema, K_FOREVER);
+	}
+}
+
+K_THREAD_DEFINE(hist_waiter_id, 512,
+		(k_thread_entry_t) hist_waiter, NULL, NULL, NULL,
+		9, 0, K_NO_WAIT);
+
+static void lock_interrupts_for(int loops)
+{
+	volatile int i;
+	unsigned int key = irq_lock();
+
+	for (i = 0; i < loops; i++) {
+		/* spin */
+	}
+
+	irq_unlock(key);
+}
+
+static int check_stats(enum int_latency_type type, const char *name)
+{
+	struct int_latency_stats stats;
+
+	int_latency_stats_get(type, &stats);
+
+	PRINT_FORMAT("  %s, %u samples:", name, stats.count);
+	PRINT_FORMAT("   p50 %u tcs, p99 %u tcs, p99.9 %u tcs, max %u tcs",
+		     stats.p50, stats.p99, stats.p999, stats.max);
+
+	if (stats.count == 0 || stats.min > stats.p50 ||
+	    stats.p50 > stats.p99 || stats.p99 > stats.p999 ||
+	    stats.p999 > stats.max) {
+		PRINT_FORMAT("  Error: inconsistent distribution");
+		return -1;
+	}
+
+	return 0;
+}
+
+/**
+ *
+ * @brief The test main function
+ *
+ * @return 0 on success
+ */
+int int_latency_hist(void)
+{
+	struct int_latency_site sites[HIST_SITES];
+	int i, n;
+
+	PRINT_FORMAT(" 8 - Measure distribution of interrupt latencies");
+
+	int_latency_init();
+
+	for (i = 0; i < HIST_ITERATIONS; i++) {
+		irq_raised_timestamp = OS_GET_TIME();
+		irq_offload(hist_isr, NULL);
+
+		/* sections 10 to 1000 loops long, the longer the rarer */
+		lock_interrupts_for((i % 100 == 0) ? 1000 :
+				    (i % 10 == 0) ? 100 : 10);
+	}
+
+	if (check_stats(INT_LATENCY_IRQ_LOCKED, "interrupts locked") ||
+	    check_stats(INT_LATENCY_ISR_ENTRY, "sw interrupt to handler") ||
+	    check_stats(INT_LATENCY_ISR_TO_THREAD,
+			"handler to woken thread")) {
+		error_count++;
+	}
+
+	n = int_latency_sites_get(sites, HIST_SITES);
+	PRINT_FORMAT("  Longest sections with interrupts locked:");
+	for (i = 0; i < n; i++) {
+		PRINT_FORMAT("   locked at %p: %u tcs", sites[i].site,
+			     sites[i].cycles);
+	}
+
+	if (n == 0) {
+		PRINT_FORMAT("  Error: no section attributed");
+		error_count++;
+	}
+
+	int_latency_reset();
+	return 0;
+}
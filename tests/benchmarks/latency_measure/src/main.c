@@ -25,6 +25,8 @@ extern void int_to_thread_evt(void);
 extern void sema_lock_unlock(void);
 extern void mutex_lock_unlock(void);
 extern int coop_ctx_switch(void);
+extern void deadline_miss(void);
+extern int int_latency_hist(void);
 void test_thread(void *arg1, void *arg2, void *arg3)
 {
 	PRINT_BANNER();
@@ -50,6 +52,16 @@ void test_thread(void *arg1, void *arg2, void *arg3)
 	coop_ctx_switch();
 	print_dash_line();
 
+#ifdef CONFIG_SCHED_DEADLINE
+	deadline_miss();
+	print_dash_line();
+#endif
+
+#ifdef CONFIG_INT_LATENCY_BENCHMARK
+	int_latency_hist();
+	print_dash_line();
+#endif
+
 	TC_END_REPORT(error_count);
 }
 
@@ -9,9 +9,14 @@
  * This file contains the benchmark that measure the average time it takes to
  * do context switches between threads using k_yield () to force
  * context switch.
+ *
+ * When the data cache can be flushed, the switches are also measured with
+ * the thread structures flushed beforehand, which shows the cost of the
+ * cache lines the switches touch in them.
  */
 
 #include <zephyr.h>
+#include <cache.h>
 #include <timestamp.h>  /* reading time */
 #include "utils.h"      /* PRINT () and other macros */
 
@@ -46,6 +51,93 @@ void yielding_thread(void *arg1, void *arg2, void *arg3)
 	}
 }
 
+/* bytes at the start of a thread that hold the fields switches use */
+#define THREAD_HOT_BYTES offsetof(struct k_thread, init_data)
+
+static void print_thread_layout(void)
+{
+	PRINT_FORMAT(" Thread: %u bytes, aligned on %u, switch fields in the"
+		     " first %u", (u32_t)sizeof(struct k_thread),
+		     (u32_t)__alignof__(struct k_thread),
+		     (u32_t)THREAD_HOT_BYTES);
+
+	if (sys_cache_line_size) {
+		PRINT_FORMAT(" i.e. in %u cache lines of %u bytes",
+			     (u32_t)((THREAD_HOT_BYTES + sys_cache_line_size - 1)
+				     / sys_cache_line_size),
+			     (u32_t)sys_cache_line_size);
+	}
+}
+
+#ifdef CONFIG_CACHE_FLUSHING
+static u32_t cold_switch_start;
+static u32_t cold_switch_cycles;
+static u32_t cold_switches;
+static k_tid_t main_thread_id;
+
+static void flush_threads(void)
+{
+	sys_cache_flush((vaddr_t)&y_thread, sizeof(y_thread));
+	sys_cache_flush((vaddr_t)main_thread_id, sizeof(struct k_thread));
+}
+
+/* both threads time the switches to them from the other one */
+static void cold_yield(void)
+{
+	flush_threads();
+	cold_switch_start = TIME_STAMP_DELTA_GET(0);
+	k_yield();
+	cold_switch_cycles += TIME_STAMP_DELTA_GET(cold_switch_start);
+	cold_switches++;
+}
+
+void cold_yielding_thread(void *arg1, void *arg2, void *arg3)
+{
+	while (helper_thread_iterations < NB_OF_YIELD) {
+		cold_yield();
+		helper_thread_iterations++;
+	}
+}
+
+static void thread_switch_yield_cold(void)
+{
+	u32_t iterations = 0;
+
+	helper_thread_iterations = 0;
+	cold_switch_cycles = 0;
+	cold_switches = 0;
+	main_thread_id = k_current_get();
+
+	bench_test_start();
+
+	k_thread_create(&y_thread, y_stack_area, Y_STACK_SIZE,
+			cold_yielding_thread, NULL, NULL, NULL,
+			Y_PRIORITY, 0, K_NO_WAIT);
+
+	while (iterations < NB_OF_YIELD &&
+	       helper_thread_iterations < NB_OF_YIELD) {
+		cold_yield();
+		iterations++;
+	}
+
+	if (bench_test_end() < 0) {
+		error_count++;
+		PRINT_OVERFLOW_ERROR();
+	} else if (cold_switches == 0) {
+		error_count++;
+		PRINT_FORMAT(" Error, no switch measured");
+	} else {
+		PRINT_FORMAT(" Average thread context switch using "
+			     "yield, threads not cached %u tcs = %u nsec",
+			     cold_switch_cycles / cold_switches,
+			     SYS_CLOCK_HW_CYCLES_TO_NS_AVG(cold_switch_cycles,
+							   cold_switches));
+	}
+
+	k_thread_abort(&y_thread);
+}
+#endif /* CONFIG_CACHE_FLUSHING */
+
 /**
  *
  * @brief Entry point for thread context switch using yield test
@@ -109,4 +201,12 @@ void thread_switch_yield(void)
 			     SYS_CLOCK_HW_CYCLES_TO_NS_AVG(timestamp,
 							   (iterations + helper_thread_iterations)));
 	}
+
+	print_thread_layout();
+
+#ifdef CONFIG_CACHE_FLUSHING
+	/* the helper thread is done, or one iteration away from it */
+	k_thread_abort(&y_thread);
+	thread_switch_yield_cold();
+#endif
 }
@@ -0,0 +1,118 @@
+/*
+ * Copyright (c) 2017 Intel Corporation
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+/**
+ * @file
+ * @brief Measure the cost of context switches between memory domains
+ *
+ * Two cooperative threads yield to each other, and the average time of a
+ * context switch is reported when:
+ *  1. neither thread belongs to a memory domain
+ *  2. both threads belong to the same memory domain
+ *  3. the threads belong to different memory domains
+ *
+ * The MPU is only reprogrammed in the third case, so the first two are
+ * expected to cost about the same.
+ */
+
+#include <zephyr.h>
+#include <tc_util.h>
+
+#define STACK_SIZE 512
+#define NUM_SWITCHES 10000
+
+/* the start address of the MPU region needs to align with its size */
+static u8_t __aligned(32) buf_a[32];
+static u8_t __aligned(32) buf_b[32];
+
+K_MEM_PARTITION_DEFINE(part_a, buf_a, sizeof(buf_a),
+		       K_MEM_PARTITION_P_RW_U_RW);
+K_MEM_PARTITION_DEFINE(part_b, buf_b, sizeof(buf_b),
+		       K_MEM_PARTITION_P_RW_U_RW);
+
+static struct k_mem_partition *parts_a[] = { &part_a };
+static struct k_mem_partition *parts_b[] = { &part_b };
+
+static struct k_mem_domain domain_a;
+static struct k_mem_domain domain_b;
+
+static K_THREAD_STACK_ARRAY_DEFINE(stacks, 2, STACK_SIZE);
+static struct k_thread threads[2];
+
+static K_SEM_DEFINE(done, 0, 2);
+
+static u32_t start_stamp;
+static u32_t end_stamp;
+
+static void yield_thread(void *p1, void *p2, void *p3)
+{
+	int i;
+
+	ARG_UNUSED(p2);
+	ARG_UNUSED(p3);
+
+	/* the first thread starts the clock, the last to end stops it */
+	if (p1 == &threads[0]) {
+		start_stamp = k_cycle_get_32();
+	}
+
+	for (i = 0; i < NUM_SWITCHES / 2; i++) {
+		k_yield();
+	}
+
+	end_stamp = k_cycle_get_32();
+	k_sem_give(&done);
+}
+
+static u32_t run(struct k_mem_domain *domain0, struct k_mem_domain *domain1)
+{
+	struct k_mem_domain *domains[2] = { domain0, domain1 };
+	int i;
+
+	k_mem_domain_init(&domain_a, ARRAY_SIZE(parts_a), parts_a);
+	k_mem_domain_init(&domain_b, ARRAY_SIZE(parts_b), parts_b);
+
+	/* the threads run once the main thread waits for them */
+	for (i = 0; i < 2; i++) {
+		k_thread_create(&threads[i], stacks[i], STACK_SIZE,
+				yield_thread, &threads[i], NULL, NULL,
+				K_PRIO_COOP(1), 0, K_NO_WAIT);
+		if (domains[i]) {
+			k_mem_domain_add_thread(domains[i], &threads[i]);
+		}
+	}
+
+	k_sem_take(&done, K_FOREVER);
+	k_sem_take(&done, K_FOREVER);
+
+	/* forget the threads, which have ended */
+	k_mem_domain_destroy(&domain_a);
+	k_mem_domain_destroy(&domain_b);
+
+	return end_stamp - start_stamp;
+}
+
+static void report(const char *name, u32_t cycles)
+{
+	TC_PRINT("%6u nsec per switch  %s\n",
+		 (u32_t)(SYS_CLOCK_HW_CYCLES_TO_NS64(cycles) / NUM_SWITCHES),
+		 name);
+}
+
+void main(void)
+{
+	TC_START("Memory domain switch benchmark");
+
+	/* above the threads, so that they only start when waited for */
+	k_thread_priority_set(k_current_get(), K_PRIO_COOP(0));
+
+	report("no domain", run(NULL, NULL));
+	report("same domain", run(&domain_a, &domain_a));
+	report("different domains", run(&domain_a, &domain_b));
+
+	TC_END_RESULT(TC_PASS);
+	TC_END_REPORT(TC_PASS);
+}
@@ -28,10 +28,18 @@ typedef void * (*pfunc) (void *);
 
 #define MESSAGE "Running maximal kernel configuration\n"
 
-/* stack used by thread */
+/* stacks used by threads */
 #ifdef CONFIG_OBJECTS_THREAD
-static K_THREAD_STACK_DEFINE(pStack, THREAD_STACK_SIZE);
-static struct k_thread objects_thread;
+#define NUM_THREADS CONFIG_OBJECTS_NUM_THREADS
+static K_THREAD_STACK_ARRAY_DEFINE(pStack, NUM_THREADS, THREAD_STACK_SIZE);
+static struct k_thread objects_thread[NUM_THREADS];
+#endif
+
+/* tasklets, which share the stack of the system tasklet executor */
+#ifdef CONFIG_OBJECTS_TASKLET
+#define NUM_TASKLETS CONFIG_OBJECTS_NUM_TASKLETS
+static struct k_tasklet objects_tasklet[NUM_TASKLETS];
+K_SEM_DEFINE(tasklet_sem, 0, 1);
 #endif
 
 /* pointer array ensures specified functions are linked into the image */
@@ -103,12 +111,43 @@ static void thread_entry(void *arg1, void *arg2, void *arg3)
 }
 #endif
 
+#ifdef CONFIG_OBJECTS_TASKLET
+
+/**
+ *
+ * @brief Trivial tasklet, waiting on a semaphore
+ *
+ * @param tasklet   Tasklet.
+ *
+ * @return N/A
+ */
+static void tasklet_handler(struct k_tasklet *tasklet)
+{
+	K_TASKLET_BEGIN(tasklet);
+	K_TASKLET_SEM_TAKE(tasklet, &tasklet_sem, K_FOREVER);
+	K_TASKLET_END(tasklet);
+}
+#endif
+
 
 
 void main(void)
 {
+#if defined(CONFIG_OBJECTS_THREAD) || defined(CONFIG_OBJECTS_TASKLET)
+	int n;
+#endif
+
 #ifdef CONFIG_OBJECTS_PRINTK
 	printk("Using printk\n");
+#ifdef CONFIG_OBJECTS_THREAD
+	printk("RAM per thread:  %u bytes\n",
+	       (u32_t)(sizeof(objects_thread[0]) +
+		       K_THREAD_STACK_SIZEOF(pStack[0])));
+#endif
+#ifdef CONFIG_OBJECTS_TASKLET
+	printk("RAM per tasklet: %u bytes\n",
+	       (u32_t)sizeof(objects_tasklet[0]));
+#endif
 #endif
 
 #if CONFIG_STATIC_ISR
@@ -116,10 +155,20 @@ void main(void)
 #endif
 
 #ifdef CONFIG_OBJECTS_THREAD
-	/* start a trivial fiber */
-	k_thread_create(&objects_thread, pStack, THREAD_STACK_SIZE,
-			thread_entry, MESSAGE, (void *)func_array,
-			NULL, 10, 0, K_NO_WAIT);
+	/* start trivial fibers */
+	for (n = 0; n < NUM_THREADS; n++) {
+		k_thread_create(&objects_thread[n], pStack[n],
+				THREAD_STACK_SIZE, thread_entry, MESSAGE,
+				(void *)func_array, NULL, 10, 0, K_NO_WAIT);
+	}
+#endif
+
+#ifdef CONFIG_OBJECTS_TASKLET
+	/* start trivial tasklets */
+	for (n = 0; n < NUM_TASKLETS; n++) {
+		k_tasklet_init(&objects_tasklet[n], tasklet_handler);
+		k_tasklet_start(&k_sys_tasklet_executor, &objects_tasklet[n]);
+	}
 #endif
 
 #ifdef CONFIG_OBJECTS_WHILELOOP
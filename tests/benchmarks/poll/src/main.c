@@ -0,0 +1,152 @@
+/*
+ * Copyright (c) 2017 Intel Corporation
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+/**
+ * @file
+ * @brief Measure the cost of waiting on many events with k_poll()
+ *
+ * A thread waits on an increasing number of poll signals while a lower
+ * priority thread raises them one at a time, and reports the time of one
+ * wait and wake up cycle:
+ *  1. with k_poll(), which registers all the events on each call
+ *  2. with a poll set, whose events stay registered between waits
+ */
+
+#include <zephyr.h>
+#include <tc_util.h>
+
+#define MAX_EVENTS 64
+#define NB_OF_WAITS 1000
+
+#define STACK_SIZE 512
+
+static struct k_poll_signal signals[MAX_EVENTS];
+static struct k_poll_event events[MAX_EVENTS];
+static struct k_poll_set set;
+
+static const int event_counts[] = { 1, 4, 16, MAX_EVENTS };
+
+static K_THREAD_STACK_DEFINE(signaler_stack, STACK_SIZE);
+static struct k_thread signaler_thread;
+
+/* runs only when the waiter is pending: raises one signal per wait */
+static void signaler(void *p1, void *p2, void *p3)
+{
+	int count = (int)p1;
+	int i;
+
+	ARG_UNUSED(p2);
+	ARG_UNUSED(p3);
+
+	for (i = 0; i < NB_OF_WAITS; i++) {
+		k_poll_signal(&signals[i % count], 0);
+	}
+}
+
+static void start_signaler(int count)
+{
+	k_thread_create(&signaler_thread, signaler_stack, STACK_SIZE,
+			signaler, (void *)count, NULL, NULL,
+			K_PRIO_PREEMPT(10), 0, K_NO_WAIT);
+}
+
+/* it has raised its last signal and only has to return by now */
+static void stop_signaler(void)
+{
+	k_thread_abort(&signaler_thread);
+}
+
+static void init_events(int count)
+{
+	int i;
+
+	for (i = 0; i < count; i++) {
+		k_poll_signal_init(&signals[i]);
+		k_poll_event_init(&events[i], K_POLL_TYPE_SIGNAL,
+				  K_POLL_MODE_NOTIFY_ONLY, &signals[i]);
+	}
+}
+
+static u32_t measure_k_poll(int count)
+{
+	u32_t stamp;
+	int i;
+
+	init_events(count);
+	start_signaler(count);
+
+	stamp = k_cycle_get_32();
+
+	for (i = 0; i < NB_OF_WAITS; i++) {
+		struct k_poll_event *event = &events[i % count];
+
+		k_poll(events, count, K_FOREVER);
+		event->signal->signaled = 0;
+		event->state = K_POLL_STATE_NOT_READY;
+	}
+
+	stamp = k_cycle_get_32() - stamp;
+
+	stop_signaler();
+
+	return stamp;
+}
+
+static u32_t measure_poll_set(int count)
+{
+	struct k_poll_event *ready;
+	u32_t stamp;
+	int i;
+
+	init_events(count);
+	k_poll_set_init(&set);
+	for (i = 0; i < count; i++) {
+		k_poll_set_add(&set, &events[i]);
+	}
+
+	start_signaler(count);
+
+	stamp = k_cycle_get_32();
+
+	for (i = 0; i < NB_OF_WAITS; i++) {
+		k_poll_set_wait(&set, &ready, 1, K_FOREVER);
+		ready->signal->signaled = 0;
+	}
+
+	stamp = k_cycle_get_32() - stamp;
+
+	stop_signaler();
+
+	for (i = 0; i < count; i++) {
+		k_poll_set_remove(&set, &events[i]);
+	}
+
+	return stamp;
+}
+
+void main(void)
+{
+	int i;
+
+	TC_START("Poll benchmark");
+
+	TC_PRINT("%d waits, average time of one wait and wake up\n",
+		 NB_OF_WAITS);
+	TC_PRINT("events   k_poll()   poll set\n");
+
+	for (i = 0; i < ARRAY_SIZE(event_counts); i++) {
+		int count = event_counts[i];
+		u32_t poll_cycles = measure_k_poll(count);
+		u32_t set_cycles = measure_poll_set(count);
+
+		TC_PRINT("%6d %6u nsec %6u nsec\n", count,
+			 SYS_CLOCK_HW_CYCLES_TO_NS_AVG(poll_cycles, NB_OF_WAITS),
+			 SYS_CLOCK_HW_CYCLES_TO_NS_AVG(set_cycles, NB_OF_WAITS));
+	}
+
+	TC_END_RESULT(TC_PASS);
+	TC_END_REPORT(TC_PASS);
+}
@@ -0,0 +1,216 @@
+/*
+ * Copyright (c) 2017 Intel Corporation
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+/**
+ * @file
+ * @brief Measure the throughput of the ring buffers
+ *
+ * Streams the same bytes, in chunks of increasing size, through:
+ *  1. the word ring buffer, sys_ring_buf_put() and sys_ring_buf_get()
+ *  2. the byte ring buffer, sys_ring_buf_bytes_put() and
+ *     sys_ring_buf_bytes_get()
+ *  3. the byte ring buffer accessed in place, with the claim and finish
+ *     routines
+ *
+ * The producer copies each chunk from a source buffer, and the consumer
+ * checksums it, after copying it out except in the third case. Several
+ * chunks are put before they are all read back, so the ring buffers wrap.
+ * The time per KB of data is reported for each side.
+ */
+
+#include <zephyr.h>
+#include <tc_util.h>
+#include <misc/ring_buffer.h>
+#include <string.h>
+
+/* both ring buffers hold 1KB */
+#define RING_BUF_POW2_WORDS 8
+#define RING_BUF_POW2_BYTES 10
+#define BATCH_BYTES 256
+
+#define TOTAL_BYTES (64 * 1024)
+#define MAX_CHUNK 256
+
+SYS_RING_BUF_DECLARE_POW2(word_buf, RING_BUF_POW2_WORDS);
+SYS_RING_BUF_BYTES_DECLARE_POW2(byte_buf, RING_BUF_POW2_BYTES);
+
+static u32_t src[MAX_CHUNK / sizeof(u32_t)];
+static u32_t dst[MAX_CHUNK / sizeof(u32_t)];
+
+static const u32_t chunk_sizes[] = { 4, 16, 64, 256 };
+
+struct result {
+	u32_t put_cycles;
+	u32_t get_cycles;
+	u32_t checksum;
+	int errors;
+};
+
+static u32_t checksum(const u8_t *data, u32_t size, u32_t sum)
+{
+	while (size--) {
+		sum += *data++;
+	}
+
+	return sum;
+}
+
+static void run_words(u32_t chunk, struct result *res)
+{
+	u32_t stamp, i, n, sent = 0;
+	u16_t type;
+	u8_t value, size32;
+
+	while (sent < TOTAL_BYTES) {
+		n = BATCH_BYTES / chunk;
+
+		stamp = k_cycle_get_32();
+		for (i = 0; i < n; i++) {
+			res->errors += sys_ring_buf_put(&word_buf, 0, 0, src,
+							chunk / sizeof(u32_t))
+				       != 0;
+		}
+		res->put_cycles += k_cycle_get_32() - stamp;
+
+		stamp = k_cycle_get_32();
+		for (i = 0; i < n; i++) {
+			size32 = ARRAY_SIZE(dst);
+			res->errors += sys_ring_buf_get(&word_buf, &type, &value,
+							dst, &size32) != 0;
+			res->checksum = checksum((u8_t *)dst, chunk,
+						 res->checksum);
+		}
+		res->get_cycles += k_cycle_get_32() - stamp;
+
+		sent += n * chunk;
+	}
+}
+
+static void run_bytes(u32_t chunk, struct result *res)
+{
+	u32_t stamp, i, n, sent = 0;
+
+	while (sent < TOTAL_BYTES) {
+		n = BATCH_BYTES / chunk;
+
+		stamp = k_cycle_get_32();
+		for (i = 0; i < n; i++) {
+			res->errors += sys_ring_buf_bytes_put(&byte_buf,
+							      (u8_t *)src,
+							      chunk) != chunk;
+		}
+		res->put_cycles += k_cycle_get_32() - stamp;
+
+		stamp = k_cycle_get_32();
+		for (i = 0; i < n; i++) {
+			res->errors += sys_ring_buf_bytes_get(&byte_buf,
+							      (u8_t *)dst,
+							      chunk) != chunk;
+			res->checksum = checksum((u8_t *)dst, chunk,
+						 res->checksum);
+		}
+		res->get_cycles += k_cycle_get_32() - stamp;
+
+		sent += n * chunk;
+	}
+}
+
+static void run_claims(u32_t chunk, struct result *res)
+{
+	u32_t stamp, i, n, size, done, sent = 0;
+	u8_t *data;
+
+	while (sent < TOTAL_BYTES) {
+		n = BATCH_BYTES / chunk;
+
+		stamp = k_cycle_get_32();
+		for (i = 0; i < n; i++) {
+			for (done = 0; done < chunk; done += size) {
+				size = sys_ring_buf_bytes_put_claim(&byte_buf,
+					&data, chunk - done);
+				if (!size) {
+					res->errors++;
+					break;
+				}
+				memcpy(data, (u8_t *)src + done, size);
+			}
+			sys_ring_buf_bytes_put_finish(&byte_buf, done);
+		}
+		res->put_cycles += k_cycle_get_32() - stamp;
+
+		stamp = k_cycle_get_32();
+		for (i = 0; i < n; i++) {
+			for (done = 0; done < chunk; done += size) {
+				size = sys_ring_buf_bytes_get_claim(&byte_buf,
+					&data, chunk - done);
+				if (!size) {
+					res->errors++;
+					break;
+				}
+				res->checksum = checksum(data, size,
+							 res->checksum);
+			}
+			sys_ring_buf_bytes_get_finish(&byte_buf, done);
+		}
+		res->get_cycles += k_cycle_get_32() - stamp;
+
+		sent += n * chunk;
+	}
+}
+
+static u32_t nsec_per_kb(u32_t cycles)
+{
+	return (u32_t)(SYS_CLOCK_HW_CYCLES_TO_NS64(cycles) * 1024 /
+		       TOTAL_BYTES);
+}
+
+static int run(const char *name, void (*fn)(u32_t, struct result *),
+	       u32_t chunk, u32_t expected)
+{
+	struct result res = { 0 };
+
+	fn(chunk, &res);
+
+	TC_PRINT("%3u bytes: put %7u nsec/KB, get %7u nsec/KB  %s\n", chunk,
+		 nsec_per_kb(res.put_cycles), nsec_per_kb(res.get_cycles),
+		 name);
+
+	if (res.errors || res.checksum != expected) {
+		TC_ERROR("%s: data lost or corrupted\n", name);
+		return TC_FAIL;
+	}
+
+	return TC_PASS;
+}
+
+void main(void)
+{
+	int status = TC_PASS;
+	u32_t expected;
+	int i;
+
+	TC_START("Ring buffer benchmark");
+
+	for (i = 0; i < sizeof(src); i++) {
+		((u8_t *)src)[i] = i;
+	}
+
+	TC_PRINT("%u bytes streamed through 1KB ring buffers\n", TOTAL_BYTES);
+
+	for (i = 0; i < ARRAY_SIZE(chunk_sizes); i++) {
+		u32_t chunk = chunk_sizes[i];
+
+		expected = checksum((u8_t *)src, chunk, 0) *
+			   (TOTAL_BYTES / chunk);
+
+		status |= run("words", run_words, chunk, expected);
+		status |= run("bytes", run_bytes, chunk, expected);
+		status |= run("bytes in place", run_claims, chunk, expected);
+	}
+
+	TC_END_RESULT(status);
+	TC_END_REPORT(status);
+}
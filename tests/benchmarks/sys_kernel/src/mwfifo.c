@@ -14,6 +14,11 @@ struct k_fifo fifo2;
 
 static struct k_fifo sync_fifo; /* for synchronization */
 
+/* number of items queued before they are all retrieved, in FIFO #4 */
+#define BATCH_SIZE 16
+
+static int batch[BATCH_SIZE][2];
+
 
 /**
  *
@@ -257,5 +262,43 @@ int fifo_test(void)
 		k_fifo_put(&sync_fifo, (void *) element);
 	}
 
+	/* test put & get functions with no thread waiting on the fifo */
+	fprintf(output_file, sz_test_case_fmt,
+			"FIFO #4");
+	fprintf(output_file, sz_description,
+			"\n\tk_fifo_init"
+			"\n\tk_fifo_put"
+			"\n\tk_fifo_get(TICKS_NONE)");
+	printf(sz_test_start_fmt);
+
+	fifo_test_init();
+
+	t = BENCH_START();
+
+	for (i = 0; i < NUMBER_OF_LOOPS; i++) {
+		int *pelement;
+
+		/* queue a batch, as a producer does while the consumer runs */
+		batch[i % BATCH_SIZE][1] = i;
+		k_fifo_put(&fifo1, batch[i % BATCH_SIZE]);
+		if (i % BATCH_SIZE != BATCH_SIZE - 1) {
+			continue;
+		}
+
+		for (j = i - BATCH_SIZE + 1; j <= i; j++) {
+			pelement = (int *)k_fifo_get(&fifo1, K_NO_WAIT);
+			if (!pelement || pelement[1] != j) {
+				break;
+			}
+		}
+		if (j <= i) {
+			break;
+		}
+	}
+
+	t = TIME_STAMP_DELTA_GET(t);
+
+	return_value += check_result(i, t);
+
 	return return_value;
 }
@@ -0,0 +1,75 @@
+/* spinlock.c */
+
+/*
+ * Copyright (c) 2017 Intel Corporation
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+#include "syskernel.h"
+
+#include <spinlock.h>
+
+static struct k_spinlock lock;
+
+/* touched inside the critical sections, so they are not optimized out */
+static volatile int counter;
+
+/**
+ *
+ * @brief The main test entry
+ *
+ * Measures the cost of a kernel spinlock against the interrupt lock it
+ * replaces. On a uniprocessor system, both are expected to cost the same.
+ *
+ * @return 1 if success and 0 on failure
+ *
+ */
+int spinlock_test(void)
+{
+	u32_t t;
+	int i;
+	int return_value = 0;
+
+	fprintf(output_file, sz_test_case_fmt,
+			"Lock #1");
+	fprintf(output_file, sz_description,
+			"\n\tirq_lock"
+			"\n\tirq_unlock");
+	printf(sz_test_start_fmt);
+
+	t = BENCH_START();
+
+	for (i = 0; i < NUMBER_OF_LOOPS; i++) {
+		unsigned int key = irq_lock();
+
+		counter++;
+		irq_unlock(key);
+	}
+
+	t = TIME_STAMP_DELTA_GET(t);
+
+	return_value += check_result(i, t);
+
+	fprintf(output_file, sz_test_case_fmt,
+			"Lock #2");
+	fprintf(output_file, sz_description,
+			"\n\tk_spin_lock"
+			"\n\tk_spin_unlock");
+	printf(sz_test_start_fmt);
+
+	t = BENCH_START();
+
+	for (i = 0; i < NUMBER_OF_LOOPS; i++) {
+		k_spinlock_key_t key = k_spin_lock(&lock);
+
+		counter++;
+		k_spin_unlock(&lock, key);
+	}
+
+	t = TIME_STAMP_DELTA_GET(t);
+
+	return_value += check_result(i, t);
+
+	return return_value;
+}
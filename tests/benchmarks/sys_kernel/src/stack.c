@@ -14,6 +14,12 @@ struct k_stack  stack_2;
 u32_t stack1[2];
 u32_t stack2[2];
 
+/* items moved per call by the batch test, dividing NUMBER_OF_LOOPS */
+#define STACK_BATCH 8
+
+static struct k_stack stack_3;
+static u32_t stack3[STACK_BATCH];
+
 /**
  *
  * @brief Initialize stacks for the test
@@ -238,5 +244,67 @@ int stack_test(void)
 
 	return_value += check_result(i * 2, t);
 
+	/* test push & pop stack functions without waiters, as an allocator
+	 * of free indexes does
+	 */
+	fprintf(output_file, sz_test_case_fmt,
+			"Stack #4");
+	fprintf(output_file, sz_description,
+			"\n\tk_stack_init"
+			"\n\tk_stack_push"
+			"\n\tk_stack_pop(K_NO_WAIT)");
+	printf(sz_test_start_fmt);
+
+	k_stack_init(&stack_3, stack3, STACK_BATCH);
+
+	t = BENCH_START();
+
+	for (i = 0; i < NUMBER_OF_LOOPS; i++) {
+		u32_t data;
+
+		k_stack_push(&stack_3, i);
+		if (k_stack_pop(&stack_3, &data, K_NO_WAIT) != 0 ||
+		    data != i) {
+			break;
+		}
+	}
+
+	t = TIME_STAMP_DELTA_GET(t);
+
+	return_value += check_result(i, t);
+
+	/* test the batch variants of the above, the time is per item */
+	fprintf(output_file, sz_test_case_fmt,
+			"Stack #5");
+	fprintf(output_file, sz_description,
+			"\n\tk_stack_init"
+			"\n\tk_stack_push_n"
+			"\n\tk_stack_pop_n(K_NO_WAIT)");
+	printf(sz_test_start_fmt);
+
+	k_stack_init(&stack_3, stack3, STACK_BATCH);
+
+	t = BENCH_START();
+
+	for (i = 0; i < NUMBER_OF_LOOPS; i += STACK_BATCH) {
+		u32_t data[STACK_BATCH];
+		int j;
+
+		for (j = 0; j < STACK_BATCH; j++) {
+			data[j] = i + j;
+		}
+
+		k_stack_push_n(&stack_3, data, STACK_BATCH);
+		if (k_stack_pop_n(&stack_3, data, STACK_BATCH,
+				  K_NO_WAIT) != STACK_BATCH ||
+		    data[0] != i + STACK_BATCH - 1) {
+			break;
+		}
+	}
+
+	t = TIME_STAMP_DELTA_GET(t);
+
+	return_value += check_result(i, t);
+
 	return return_value;
 }
@@ -0,0 +1,153 @@
+/*
+ * Copyright (c) 2017 Intel Corporation
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+/**
+ * @file
+ * @brief Measure the cost of the kernel timeout queue vs. number of timeouts
+ *
+ * For an increasing number of armed kernel timers, measures:
+ *  1. the time it takes to arm one more timer (k_timer_start())
+ *  2. the time it takes to disarm it (k_timer_stop())
+ *  3. the time it takes the kernel to expire that many timers on one tick
+ *
+ * Build with prj.conf for the sorted delta list and with prj_wheel.conf for
+ * the hierarchical timer wheel to compare both timeout queue implementations.
+ */
+
+#include <zephyr.h>
+#include <tc_util.h>
+
+#define MAX_TIMERS 512
+#define NB_OF_OPS 1000
+
+/* far enough so that the background timers never expire while measuring */
+#define BACKGROUND_DURATION K_SECONDS(60)
+#define BACKGROUND_SPREAD 5000
+
+static struct k_timer timers[MAX_TIMERS];
+static struct k_timer probe;
+
+static const int timer_counts[] = { 1, 16, 64, 256, MAX_TIMERS };
+
+static volatile int expired;
+static volatile u32_t first_expiry;
+static volatile u32_t last_expiry;
+
+static void expiry_fn(struct k_timer *timer)
+{
+	u32_t now = k_cycle_get_32();
+
+	if (!expired++) {
+		first_expiry = now;
+	}
+	last_expiry = now;
+}
+
+static void arm_background_timers(int count)
+{
+	int i;
+
+	for (i = 0; i < count; i++) {
+		/* pseudo-random spread, so insertions land all over the queue */
+		k_timer_start(&timers[i], BACKGROUND_DURATION +
+			      (i * 7919) % BACKGROUND_SPREAD, 0);
+	}
+}
+
+static void stop_timers(int count)
+{
+	int i;
+
+	for (i = 0; i < count; i++) {
+		k_timer_stop(&timers[i]);
+	}
+}
+
+static void measure_insert_remove(int count)
+{
+	u32_t start_cycles = 0;
+	u32_t stop_cycles = 0;
+	u32_t stamp;
+	int i;
+
+	arm_background_timers(count);
+
+	for (i = 0; i < NB_OF_OPS; i++) {
+		s32_t duration = BACKGROUND_DURATION +
+				 (i * 104729) % BACKGROUND_SPREAD;
+
+		stamp = k_cycle_get_32();
+		k_timer_start(&probe, duration, 0);
+		start_cycles += k_cycle_get_32() - stamp;
+
+		stamp = k_cycle_get_32();
+		k_timer_stop(&probe);
+		stop_cycles += k_cycle_get_32() - stamp;
+	}
+
+	stop_timers(count);
+
+	TC_PRINT("%4d timers: insert %6u nsec, remove %6u nsec\n", count,
+		 SYS_CLOCK_HW_CYCLES_TO_NS_AVG(start_cycles, NB_OF_OPS),
+		 SYS_CLOCK_HW_CYCLES_TO_NS_AVG(stop_cycles, NB_OF_OPS));
+}
+
+static int measure_expire(int count)
+{
+	int i;
+
+	expired = 0;
+
+	/* synchronize on a tick, so all timers expire on the same one */
+	k_sleep(1);
+
+	for (i = 0; i < count; i++) {
+		k_timer_start(&timers[i], K_MSEC(100), 0);
+	}
+
+	k_sleep(K_MSEC(200));
+
+	if (expired != count) {
+		TC_ERROR("%d timers armed, %d expired\n", count, expired);
+		stop_timers(count);
+		return TC_FAIL;
+	}
+
+	TC_PRINT("%4d timers: expire all %8u nsec, %6u nsec per timer\n",
+		 count,
+		 SYS_CLOCK_HW_CYCLES_TO_NS(last_expiry - first_expiry),
+		 SYS_CLOCK_HW_CYCLES_TO_NS_AVG(last_expiry - first_expiry,
+					       count));
+
+	return TC_PASS;
+}
+
+void main(void)
+{
+	int status = TC_PASS;
+	int i;
+
+	TC_START("Timeout queue benchmark");
+
+	for (i = 0; i < MAX_TIMERS; i++) {
+		k_timer_init(&timers[i], expiry_fn, NULL);
+	}
+	k_timer_init(&probe, NULL, NULL);
+
+	TC_PRINT("Each insert/remove is repeated %d times\n", NB_OF_OPS);
+	for (i = 0; i < ARRAY_SIZE(timer_counts); i++) {
+		measure_insert_remove(timer_counts[i]);
+	}
+
+	for (i = 0; i < ARRAY_SIZE(timer_counts); i++) {
+		if (measure_expire(timer_counts[i]) != TC_PASS) {
+			status = TC_FAIL;
+		}
+	}
+
+	TC_END_RESULT(status);
+	TC_END_REPORT(status);
+}
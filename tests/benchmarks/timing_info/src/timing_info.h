@@ -96,6 +96,7 @@ void heap_malloc_free_bench(void);
 void semaphore_bench(void);
 void mutex_bench(void);
 void msg_passing_bench(void);
+void userspace_bench(void);
 
 /* PRINT_F
  * Macro to print a formatted output string. fprintf is used when
@@ -0,0 +1,92 @@
+/*
+ * Copyright (c) 2017 Intel Corporation.
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+#include <kernel.h>
+#include <zephyr.h>
+#include <tc_util.h>
+#include <ksched.h>
+#include "timing_info.h"
+
+K_SEM_DEFINE(syscall_sem, 0, 1);
+K_SEM_DEFINE(syscall_sem_1, 0, 1);
+
+#define STACK_SIZE 500
+extern K_THREAD_STACK_DEFINE(my_stack_area, STACK_SIZE);
+extern struct k_thread my_thread;
+
+/* location of the time stamps */
+extern u64_t __start_syscall_time;
+extern u64_t __end_syscall_time;
+extern char sline[];
+
+/* time stamps of the user thread, which reads the time stamp counter */
+u64_t syscall_uncached_start_time;
+u64_t syscall_uncached_end_time;
+u64_t syscall_cached_start_time;
+u64_t syscall_cached_end_time;
+volatile int syscall_bench_done;
+
+void thread_syscall_test(void *p1, void *p2, void *p3);
+
+void userspace_bench(void)
+{
+	syscall_bench_done = 0;
+
+	/* lower priority than the current thread, which preempts it once
+	 * done sleeping: the user thread makes no system call past the
+	 * measured ones, so as to leave the time stamps alone
+	 */
+	k_thread_create(&my_thread, my_stack_area, STACK_SIZE,
+			thread_syscall_test, NULL, NULL, NULL,
+			k_thread_priority_get(k_current_get()) + 1,
+			K_USER, K_FOREVER);
+	k_object_grant_access(&syscall_sem, &my_thread);
+	k_object_grant_access(&syscall_sem_1, &my_thread);
+	k_thread_start(&my_thread);
+
+	k_sleep(1000);
+	k_thread_abort(&my_thread);
+
+	if (!syscall_bench_done) {
+		TC_PRINT("User thread did not complete\n");
+		return;
+	}
+
+	u32_t entry_cycles = __start_syscall_time - syscall_cached_start_time;
+	u32_t exit_cycles = syscall_cached_end_time - __end_syscall_time;
+	u32_t uncached_cycles = syscall_uncached_end_time -
+				syscall_uncached_start_time;
+	u32_t cached_cycles = syscall_cached_end_time -
+			      syscall_cached_start_time;
+
+	PRINT_STATS("System call entry", entry_cycles,
+		CYCLES_TO_NS(entry_cycles));
+	PRINT_STATS("System call exit", exit_cycles,
+		CYCLES_TO_NS(exit_cycles));
+	PRINT_STATS("System call, object looked up", uncached_cycles,
+		CYCLES_TO_NS(uncached_cycles));
+	PRINT_STATS("System call, object cached", cached_cycles,
+		CYCLES_TO_NS(cached_cycles));
+}
+
+void thread_syscall_test(void *p1, void *p2, void *p3)
+{
+	/* brings the system call path into the CPU caches */
+	k_sem_count_get(&syscall_sem);
+
+	syscall_uncached_start_time = _tsc_read();
+	k_sem_count_get(&syscall_sem_1);
+	syscall_uncached_end_time = _tsc_read();
+
+	syscall_cached_start_time = _tsc_read();
+	k_sem_count_get(&syscall_sem_1);
+	syscall_cached_end_time = _tsc_read();
+
+	syscall_bench_done = 1;
+
+	while (1) {
+	}
+}
@@ -8,6 +8,7 @@
 
 #include <ztest.h>
 #include <misc/ring_buffer.h>
+#include <irq_offload.h>
 #include <logging/sys_log.h>
 
 SYS_RING_BUF_DECLARE_POW2(ring_buf, 8);
@@ -67,3 +68,158 @@ void ring_buffer_test(void)
 			       &getsize);
 	zassert_true((ret == -EAGAIN), "Got data out of an empty buffer");
 }
+
+SYS_RING_BUF_BYTES_DECLARE_POW2(ring_buf_bytes, 6);
+
+#define BYTES_SIZE 64
+
+static u8_t byte_pattern[BYTES_SIZE * 2];
+
+static void byte_pattern_init(void)
+{
+	int i;
+
+	for (i = 0; i < sizeof(byte_pattern); i++) {
+		byte_pattern[i] = i;
+	}
+}
+
+void ring_buffer_bytes_test(void)
+{
+	u8_t getdata[BYTES_SIZE];
+	u8_t *claimed;
+	u32_t size;
+
+	byte_pattern_init();
+
+	/* the whole buffer can be filled, and no more */
+	size = sys_ring_buf_bytes_put(&ring_buf_bytes, byte_pattern,
+				      sizeof(byte_pattern));
+	zassert_equal(size, BYTES_SIZE, "ring buffer not filled");
+	zassert_equal(sys_ring_buf_bytes_space_get(&ring_buf_bytes), 0, NULL);
+	zassert_equal(sys_ring_buf_bytes_put(&ring_buf_bytes, byte_pattern, 1),
+		      0, "wrote to a full ring buffer");
+
+	size = sys_ring_buf_bytes_get(&ring_buf_bytes, getdata,
+				      sizeof(getdata));
+	zassert_equal(size, BYTES_SIZE, NULL);
+	zassert_true(memcmp(getdata, byte_pattern, size) == 0,
+		     "data corrupted");
+	zassert_true(sys_ring_buf_bytes_is_empty(&ring_buf_bytes), NULL);
+	zassert_equal(sys_ring_buf_bytes_get(&ring_buf_bytes, getdata, 1), 0,
+		      "read from an empty ring buffer");
+
+	/* move the indexes so the next put wraps around */
+	zassert_equal(sys_ring_buf_bytes_put(&ring_buf_bytes, byte_pattern,
+					     40), 40, NULL);
+	zassert_equal(sys_ring_buf_bytes_get(&ring_buf_bytes, getdata, 40), 40,
+		      NULL);
+
+	zassert_equal(sys_ring_buf_bytes_put(&ring_buf_bytes, byte_pattern,
+					     50), 50, NULL);
+
+	/* claims return contiguous bytes, up to the end of the buffer */
+	size = sys_ring_buf_bytes_get_claim(&ring_buf_bytes, &claimed, 50);
+	zassert_equal(size, BYTES_SIZE - 40, NULL);
+	zassert_true(memcmp(claimed, byte_pattern, size) == 0,
+		     "data corrupted");
+
+	size = sys_ring_buf_bytes_get_claim(&ring_buf_bytes, &claimed, 50);
+	zassert_equal(size, 50 - (BYTES_SIZE - 40), NULL);
+	zassert_equal(claimed, _ring_buffer_data_ring_buf_bytes, NULL);
+	zassert_true(memcmp(claimed, byte_pattern + BYTES_SIZE - 40,
+			    size) == 0, "data corrupted");
+
+	zassert_equal(sys_ring_buf_bytes_get_finish(&ring_buf_bytes, 51),
+		      -EINVAL, "released more than claimed");
+	zassert_equal(sys_ring_buf_bytes_get_finish(&ring_buf_bytes, 50), 0,
+		      NULL);
+	zassert_true(sys_ring_buf_bytes_is_empty(&ring_buf_bytes), NULL);
+}
+
+void ring_buffer_bytes_claim_test(void)
+{
+	struct ring_buf_bytes buf;
+	u8_t data[BYTES_SIZE];
+	u8_t getdata[BYTES_SIZE];
+	u8_t *claimed;
+	u32_t size;
+
+	byte_pattern_init();
+	sys_ring_buf_bytes_init(&buf, sizeof(data), data);
+
+	/* claimed space is not visible until committed */
+	size = sys_ring_buf_bytes_put_claim(&buf, &claimed, 16);
+	zassert_equal(size, 16, NULL);
+	memcpy(claimed, byte_pattern, size);
+	zassert_true(sys_ring_buf_bytes_is_empty(&buf), NULL);
+
+	/* committing less than claimed releases the rest of the claim */
+	zassert_equal(sys_ring_buf_bytes_put_finish(&buf, 17), -EINVAL,
+		      "committed more than claimed");
+	zassert_equal(sys_ring_buf_bytes_put_finish(&buf, 10), 0, NULL);
+	zassert_equal(sys_ring_buf_bytes_space_get(&buf), BYTES_SIZE - 10,
+		      NULL);
+
+	/* releasing less than claimed leaves the rest in the buffer */
+	size = sys_ring_buf_bytes_get_claim(&buf, &claimed, BYTES_SIZE);
+	zassert_equal(size, 10, NULL);
+	zassert_equal(sys_ring_buf_bytes_get_finish(&buf, 4), 0, NULL);
+
+	size = sys_ring_buf_bytes_get(&buf, getdata, sizeof(getdata));
+	zassert_equal(size, 6, NULL);
+	zassert_true(memcmp(getdata, byte_pattern + 4, size) == 0,
+		     "data corrupted");
+}
+
+static struct ring_buf_bytes *isr_buf;
+static u8_t isr_next;
+
+static void ring_buffer_bytes_isr(void *arg)
+{
+	u8_t *claimed;
+	u32_t i, size;
+
+	ARG_UNUSED(arg);
+
+	size = sys_ring_buf_bytes_put_claim(isr_buf, &claimed, 24);
+	for (i = 0; i < size; i++) {
+		claimed[i] = isr_next++;
+	}
+	sys_ring_buf_bytes_put_finish(isr_buf, size);
+}
+
+void ring_buffer_bytes_isr_test(void)
+{
+	struct ring_buf_bytes buf;
+	u8_t data[BYTES_SIZE];
+	u8_t *claimed;
+	u8_t expected = 0;
+	u32_t i, size;
+	int round;
+
+	sys_ring_buf_bytes_init(&buf, sizeof(data), data);
+	isr_buf = &buf;
+	isr_next = 0;
+
+	/* an ISR produces while the thread consumes, in odd sizes */
+	for (round = 0; round < 100; round++) {
+		irq_offload(ring_buffer_bytes_isr, NULL);
+
+		size = sys_ring_buf_bytes_get_claim(&buf, &claimed, 13);
+		for (i = 0; i < size; i++) {
+			zassert_equal(claimed[i], expected++, "data corrupted");
+		}
+		sys_ring_buf_bytes_get_finish(&buf, size);
+	}
+
+	/* drain what is left */
+	while ((size = sys_ring_buf_bytes_get_claim(&buf, &claimed, 13))) {
+		for (i = 0; i < size; i++) {
+			zassert_equal(claimed[i], expected++, "data corrupted");
+		}
+		sys_ring_buf_bytes_get_finish(&buf, size);
+	}
+
+	zassert_equal(expected, isr_next, "bytes lost");
+}
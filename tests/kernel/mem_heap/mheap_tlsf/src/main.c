@@ -0,0 +1,129 @@
+/*
+ * Copyright (c) 2017 Intel Corporation
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+/**
+ * @addtogroup t_mheap
+ * @{
+ * @defgroup t_mheap_tlsf test_mheap_tlsf
+ * @brief TestPurpose: verify the two-level segregated fit heap
+ * @}
+ */
+
+#include <ztest.h>
+
+#define HEAP_SIZE CONFIG_HEAP_MEM_POOL_SIZE
+#define BLK_NUM 32
+#define BLK_ALIGN 8
+
+static void *blocks[BLK_NUM];
+
+static void check_heap_empty(void)
+{
+	struct k_heap_stats stats;
+
+	k_heap_stats_get(&stats);
+	zassert_equal(stats.used_blocks, 0, "blocks left allocated");
+	zassert_equal(stats.free_blocks, 1, "free blocks were not merged");
+	zassert_equal(stats.max_free_size, stats.free_bytes, NULL);
+}
+
+/**
+ * @brief Check k_malloc() alignment and that blocks do not overlap
+ */
+void test_tlsf_malloc_free(void)
+{
+	int i;
+
+	for (i = 0; i < BLK_NUM; i++) {
+		blocks[i] = k_malloc(i + 1);
+		zassert_not_null(blocks[i], NULL);
+		zassert_false((u32_t)blocks[i] % BLK_ALIGN, "misaligned block");
+		memset(blocks[i], i, i + 1);
+	}
+
+	for (i = 0; i < BLK_NUM; i++) {
+		zassert_equal(((u8_t *)blocks[i])[i], i, "blocks overlap");
+		k_free(blocks[i]);
+	}
+
+	k_free(NULL);
+
+	check_heap_empty();
+}
+
+/**
+ * @brief Check that freed neighbors are merged back, whatever the order
+ *
+ * @details Fill the heap with small blocks, free every other one, then the
+ * rest, and check that the whole heap can be allocated in one block again.
+ */
+void test_tlsf_coalesce(void)
+{
+	struct k_heap_stats stats;
+	void *big;
+	int i;
+
+	for (i = 0; i < BLK_NUM; i++) {
+		blocks[i] = k_malloc(HEAP_SIZE / BLK_NUM / 2);
+		zassert_not_null(blocks[i], NULL);
+	}
+
+	for (i = 0; i < BLK_NUM; i += 2) {
+		k_free(blocks[i]);
+	}
+
+	k_heap_stats_get(&stats);
+	zassert_equal(stats.used_blocks, BLK_NUM / 2, NULL);
+
+	for (i = BLK_NUM - 1; i > 0; i -= 2) {
+		k_free(blocks[i]);
+	}
+
+	check_heap_empty();
+
+	k_heap_stats_get(&stats);
+	big = k_malloc(stats.max_free_size);
+	zassert_not_null(big, "heap is fragmented");
+	zassert_is_null(k_malloc(1), "heap not exhausted");
+	k_free(big);
+
+	zassert_is_null(k_malloc(HEAP_SIZE + 1), NULL);
+}
+
+/**
+ * @brief Check that k_calloc() zeroes the block and detects overflows
+ */
+void test_tlsf_calloc(void)
+{
+	u8_t *block;
+	int i;
+
+	/* leave garbage where k_calloc() is going to allocate */
+	block = k_malloc(64);
+	zassert_not_null(block, NULL);
+	memset(block, 0xa5, 64);
+	k_free(block);
+
+	block = k_calloc(16, 4);
+	zassert_not_null(block, NULL);
+	for (i = 0; i < 64; i++) {
+		zassert_equal(block[i], 0, "block not zeroed");
+	}
+	k_free(block);
+
+	zassert_is_null(k_calloc(0x10000, 0x10000), "overflow not detected");
+
+	check_heap_empty();
+}
+
+void test_main(void)
+{
+	ztest_test_suite(test_mheap_tlsf,
+			 ztest_unit_test(test_tlsf_malloc_free),
+			 ztest_unit_test(test_tlsf_coalesce),
+			 ztest_unit_test(test_tlsf_calloc));
+	ztest_run_test_suite(test_mheap_tlsf);
+}
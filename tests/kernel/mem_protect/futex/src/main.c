@@ -0,0 +1,281 @@
+/*
+ * Copyright (c) 2017 Intel Corporation
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+#include <ztest.h>
+#include <misc/sys_mutex.h>
+#include <misc/sys_sem.h>
+
+#define STACK_SIZE 1024
+#define USER_PRIO 0
+#define ITERATIONS 1000
+
+/* kernel objects, reached by user threads through system calls */
+K_SEM_DEFINE(kernel_sem, 0, 1);
+K_SEM_DEFINE(start_sem, 0, 1);
+K_SEM_DEFINE(done_sem, 0, 1);
+K_SEM_DEFINE(never_sem, 0, 1);
+
+/* futex-based objects, in application memory */
+SYS_MUTEX_DEFINE(mutex);
+SYS_SEM_DEFINE(sem, 0, 1);
+
+/* written by user threads, checked by the test thread */
+volatile int user_result;
+
+static K_THREAD_STACK_DEFINE(user_stack, STACK_SIZE);
+static struct k_thread __kernel_bss user_thread;
+
+static void user_wait_forever(void)
+{
+	k_sem_take(&never_sem, K_FOREVER);
+}
+
+static void start_user_thread(k_thread_entry_t entry, void *p1)
+{
+	user_result = 0;
+
+	k_thread_create(&user_thread, user_stack, STACK_SIZE, entry, p1,
+			NULL, NULL, USER_PRIO, K_USER, K_FOREVER);
+	k_object_grant_access(&kernel_sem, &user_thread);
+	k_object_grant_access(&start_sem, &user_thread);
+	k_object_grant_access(&done_sem, &user_thread);
+	k_object_grant_access(&never_sem, &user_thread);
+	k_thread_start(&user_thread);
+}
+
+static void user_mutex_lock(void *p1, void *p2, void *p3)
+{
+	user_result = sys_mutex_lock(&mutex, K_FOREVER) == 0 ? 1 : -1;
+	sys_mutex_unlock(&mutex);
+	k_sem_give(&done_sem);
+
+	user_wait_forever();
+}
+
+/**
+ * @brief Check that a user thread waits for, and is woken by the release
+ * of, a contended futex-based mutex
+ */
+void test_sys_mutex_contended(void)
+{
+	sys_mutex_init(&mutex);
+	zassert_equal(sys_mutex_lock(&mutex, K_NO_WAIT), 0, NULL);
+
+	start_user_thread(user_mutex_lock, NULL);
+	k_sleep(10);
+
+	zassert_equal(user_result, 0, "user thread did not wait");
+	zassert_equal(atomic_get(&mutex.val), SYS_MUTEX_CONTENDED,
+		      "mutex not marked contended");
+
+	sys_mutex_unlock(&mutex);
+	zassert_equal(k_sem_take(&done_sem, 100), 0, "user thread not woken");
+	zassert_equal(user_result, 1, "user thread did not lock the mutex");
+	zassert_equal(atomic_get(&mutex.val), SYS_MUTEX_UNLOCKED, NULL);
+
+	k_thread_abort(&user_thread);
+}
+
+/**
+ * @brief Check the futex-based mutex timeouts
+ */
+void test_sys_mutex_timeout(void)
+{
+	sys_mutex_init(&mutex);
+	zassert_equal(sys_mutex_lock(&mutex, K_NO_WAIT), 0, NULL);
+
+	zassert_equal(sys_mutex_lock(&mutex, K_NO_WAIT), -EBUSY, NULL);
+	zassert_equal(sys_mutex_lock(&mutex, 10), -EAGAIN, NULL);
+
+	sys_mutex_unlock(&mutex);
+	zassert_equal(sys_mutex_lock(&mutex, 10), 0, NULL);
+	sys_mutex_unlock(&mutex);
+}
+
+static void user_sem_take(void *p1, void *p2, void *p3)
+{
+	user_result = sys_sem_take(&sem, K_FOREVER) == 0 ? 1 : -1;
+	k_sem_give(&done_sem);
+
+	user_wait_forever();
+}
+
+/**
+ * @brief Check that a user thread waits for, and is woken by, a give of a
+ * futex-based semaphore
+ */
+void test_sys_sem_contended(void)
+{
+	zassert_equal(sys_sem_init(&sem, 0, 1), 0, NULL);
+
+	start_user_thread(user_sem_take, NULL);
+	k_sleep(10);
+
+	zassert_equal(user_result, 0, "user thread did not wait");
+	zassert_equal(atomic_get(&sem.waiters), 1, "waiter not counted");
+
+	sys_sem_give(&sem);
+	zassert_equal(k_sem_take(&done_sem, 100), 0, "user thread not woken");
+	zassert_equal(user_result, 1, "user thread did not take the semaphore");
+	zassert_equal(sys_sem_count_get(&sem), 0, NULL);
+	zassert_equal(atomic_get(&sem.waiters), 0, NULL);
+
+	k_thread_abort(&user_thread);
+}
+
+/**
+ * @brief Check the futex-based semaphore timeouts and limit
+ */
+void test_sys_sem_timeout(void)
+{
+	zassert_equal(sys_sem_init(&sem, 0, 2), 0, NULL);
+	zassert_equal(sys_sem_init(&sem, 3, 2), -EINVAL, NULL);
+	zassert_equal(sys_sem_init(&sem, 0, 2), 0, NULL);
+
+	zassert_equal(sys_sem_take(&sem, K_NO_WAIT), -EBUSY, NULL);
+	zassert_equal(sys_sem_take(&sem, 10), -EAGAIN, NULL);
+	zassert_equal(atomic_get(&sem.waiters), 0, NULL);
+
+	sys_sem_give(&sem);
+	sys_sem_give(&sem);
+	sys_sem_give(&sem);
+	zassert_equal(sys_sem_count_get(&sem), 2, "limit not enforced");
+
+	zassert_equal(sys_sem_take(&sem, K_NO_WAIT), 0, NULL);
+	zassert_equal(sys_sem_take(&sem, 10), 0, NULL);
+}
+
+/**
+ * @brief Check that the kernel does not wait on a futex word that changed
+ */
+void test_futex_value_changed(void)
+{
+	static atomic_t word = ATOMIC_INIT(1);
+
+	zassert_equal(k_futex_wait(&word, 0, K_FOREVER), -EAGAIN, NULL);
+	zassert_equal(k_futex_wait(&word, 1, K_NO_WAIT), -ETIMEDOUT, NULL);
+	zassert_equal(k_futex_wait(&word, 1, 10), -ETIMEDOUT, NULL);
+	zassert_equal(k_futex_wake(&word, 1), 0, "woke a thread");
+}
+
+/*
+ * Benchmark: uncontended take/give and lock/unlock pairs, from supervisor
+ * and user mode. A k_sem serves as the kernel mutex, being the one kernel
+ * synchronization object user threads have system calls for.
+ */
+
+static void bench_k_sem(void)
+{
+	int i;
+
+	for (i = 0; i < ITERATIONS; i++) {
+		k_sem_give(&kernel_sem);
+		k_sem_take(&kernel_sem, K_NO_WAIT);
+	}
+}
+
+static void bench_sys_sem(void)
+{
+	int i;
+
+	for (i = 0; i < ITERATIONS; i++) {
+		sys_sem_give(&sem);
+		sys_sem_take(&sem, K_NO_WAIT);
+	}
+}
+
+static void bench_sys_mutex(void)
+{
+	int i;
+
+	for (i = 0; i < ITERATIONS; i++) {
+		sys_mutex_lock(&mutex, K_NO_WAIT);
+		sys_mutex_unlock(&mutex);
+	}
+}
+
+typedef void (*bench_fn_t)(void);
+
+static const bench_fn_t bench_fns[] = {
+	bench_k_sem,
+	bench_sys_sem,
+	bench_sys_mutex,
+};
+
+static const char * const bench_names[] = {
+	"k_sem give/take (system calls)",
+	"sys_sem give/take",
+	"sys_mutex lock/unlock",
+};
+
+#define NUM_BENCH ARRAY_SIZE(bench_fns)
+
+static void user_bench(void *p1, void *p2, void *p3)
+{
+	int i;
+
+	for (i = 0; i < NUM_BENCH; i++) {
+		k_sem_take(&start_sem, K_FOREVER);
+		bench_fns[i]();
+		k_sem_give(&done_sem);
+	}
+
+	user_wait_forever();
+}
+
+/**
+ * @brief Compare the cost of system calls with the futex fast path
+ *
+ * The user thread cannot read the cycle counter: its runs are timed from
+ * the test thread, which includes two context switches and two system
+ * calls, spread over the iterations.
+ */
+void test_futex_benchmark(void)
+{
+	u32_t supervisor[NUM_BENCH], user[NUM_BENCH];
+	u32_t start;
+	int i;
+
+	sys_mutex_init(&mutex);
+	zassert_equal(sys_sem_init(&sem, 0, 1), 0, NULL);
+
+	for (i = 0; i < NUM_BENCH; i++) {
+		start = k_cycle_get_32();
+		bench_fns[i]();
+		supervisor[i] = (k_cycle_get_32() - start) / ITERATIONS;
+	}
+
+	start_user_thread(user_bench, NULL);
+
+	for (i = 0; i < NUM_BENCH; i++) {
+		start = k_cycle_get_32();
+		k_sem_give(&start_sem);
+		k_sem_take(&done_sem, K_FOREVER);
+		user[i] = (k_cycle_get_32() - start) / ITERATIONS;
+	}
+
+	k_thread_abort(&user_thread);
+
+	for (i = 0; i < NUM_BENCH; i++) {
+		TC_PRINT("%s: %u cycles from supervisor mode, %u from user mode\n",
+			 bench_names[i], supervisor[i], user[i]);
+	}
+
+	zassert_true(user[1] < user[0], "sys_sem fast path not faster");
+	zassert_true(user[2] < user[0], "sys_mutex fast path not faster");
+}
+
+void test_main(void)
+{
+	ztest_test_suite(test_futex,
+			 ztest_unit_test(test_sys_mutex_contended),
+			 ztest_unit_test(test_sys_mutex_timeout),
+			 ztest_unit_test(test_sys_sem_contended),
+			 ztest_unit_test(test_sys_sem_timeout),
+			 ztest_unit_test(test_futex_value_changed),
+			 ztest_unit_test(test_futex_benchmark));
+	ztest_run_test_suite(test_futex);
+}
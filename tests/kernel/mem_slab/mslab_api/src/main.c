@@ -13,6 +13,11 @@ extern void test_mslab_alloc_free_thread(void);
 extern void test_mslab_alloc_align(void);
 extern void test_mslab_alloc_timeout(void);
 extern void test_mslab_used_get(void);
+extern void test_mslab_free_isr_to_waiter(void);
+#ifdef CONFIG_MEM_SLAB_STATS
+extern void test_mslab_stats(void);
+extern void test_mslab_foreach(void);
+#endif
 
 /*test case main entry*/
 void test_main(void)
@@ -24,6 +29,11 @@ void test_main(void)
 			 ztest_unit_test(test_mslab_alloc_free_thread),
 			 ztest_unit_test(test_mslab_alloc_align),
 			 ztest_unit_test(test_mslab_alloc_timeout),
-			 ztest_unit_test(test_mslab_used_get));
+			 ztest_unit_test(test_mslab_used_get),
+#ifdef CONFIG_MEM_SLAB_STATS
+			 ztest_unit_test(test_mslab_stats),
+			 ztest_unit_test(test_mslab_foreach),
+#endif
+			 ztest_unit_test(test_mslab_free_isr_to_waiter));
 	ztest_run_test_suite(test_mslab_api);
 }
@@ -21,8 +21,14 @@
  */
 
 #include <ztest.h>
+#include <irq_offload.h>
 #include "test_mslab.h"
 
+#define STACK_SIZE 512
+static K_THREAD_STACK_DEFINE(waiter_stack, STACK_SIZE);
+static struct k_thread waiter_thread;
+static void *waiter_block;
+
 /** TESTPOINT: Statically define and initialize a memory slab*/
 K_MEM_SLAB_DEFINE(kmslab, BLK_SIZE, BLK_NUM, BLK_ALIGN);
 static char __aligned(BLK_ALIGN) tslab[BLK_SIZE * BLK_NUM];
@@ -139,6 +145,21 @@ static void tmslab_used_get(void *data)
 	}
 }
 
+static void tmslab_waiter(void *p1, void *p2, void *p3)
+{
+	struct k_mem_slab *pslab = (struct k_mem_slab *)p1;
+
+	zassert_equal(k_mem_slab_alloc(pslab, &waiter_block, TIMEOUT), 0,
+		      NULL);
+}
+
+static void tmslab_free_isr(void *data)
+{
+	void **block = (void **)data;
+
+	k_mem_slab_free(&mslab, block);
+}
+
 /*test cases*/
 void test_mslab_kinit(void)
 {
@@ -175,3 +196,33 @@ void test_mslab_used_get(void)
 	tmslab_used_get(&mslab);
 	tmslab_used_get(&kmslab);
 }
+
+void test_mslab_free_isr_to_waiter(void)
+{
+	void *block[BLK_NUM], *freed;
+
+	for (int i = 0; i < BLK_NUM; i++) {
+		zassert_true(k_mem_slab_alloc(&mslab, &block[i], K_NO_WAIT) == 0,
+			     NULL);
+	}
+
+	/* let the waiter run, and wait on the empty slab */
+	waiter_block = NULL;
+	k_thread_create(&waiter_thread, waiter_stack, STACK_SIZE,
+			tmslab_waiter, &mslab, NULL, NULL,
+			K_PRIO_PREEMPT(0), 0, 0);
+	k_sleep(10);
+
+	/** TESTPOINT: a block freed from an ISR goes to the waiting thread */
+	freed = block[0];
+	irq_offload(tmslab_free_isr, &block[0]);
+	k_sleep(10);
+	zassert_equal(waiter_block, freed, NULL);
+	zassert_equal(k_mem_slab_num_used_get(&mslab), BLK_NUM, NULL);
+
+	block[0] = waiter_block;
+	for (int i = 0; i < BLK_NUM; i++) {
+		k_mem_slab_free(&mslab, &block[i]);
+	}
+	zassert_equal(k_mem_slab_num_used_get(&mslab), 0, NULL);
+}
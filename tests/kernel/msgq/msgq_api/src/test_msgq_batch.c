@@ -0,0 +1,148 @@
+/*
+ * Copyright (c) 2017 Intel Corporation
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+/**
+ * @addtogroup t_kernel_msgq
+ * @{
+ * @defgroup t_msgq_batch test_msgq_batch
+ * @brief TestPurpose: verify batched and in place msgq apis
+ * - API coverage
+ *   -# k_msgq_put_batch
+ *   -# k_msgq_get_batch
+ *   -# k_msgq_peek_claim
+ *   -# k_msgq_peek_finish
+ * @}
+ */
+
+#include "test_msgq.h"
+
+#define BATCH_LEN 8
+#define OFFSET 3
+
+static K_THREAD_STACK_DEFINE(tstack, STACK_SIZE);
+static struct k_thread tdata;
+static char __aligned(4) tbuffer[MSG_SIZE * BATCH_LEN];
+static u32_t tx_data[BATCH_LEN + OFFSET];
+static u32_t rx_data[BATCH_LEN + OFFSET];
+static struct k_msgq msgq;
+static struct k_sem end_sema;
+
+static void thread_get(void *p1, void *p2, void *p3)
+{
+	u32_t msg;
+
+	zassert_false(k_msgq_get(&msgq, &msg, K_FOREVER), NULL);
+	zassert_equal(msg, tx_data[0], NULL);
+	k_sem_give(&end_sema);
+}
+
+static void thread_put(void *p1, void *p2, void *p3)
+{
+	zassert_false(k_msgq_put(&msgq, &tx_data[BATCH_LEN], K_FOREVER),
+		      NULL);
+	k_sem_give(&end_sema);
+}
+
+static void init_batch(void)
+{
+	for (int i = 0; i < BATCH_LEN + OFFSET; i++) {
+		tx_data[i] = MSG0 + i;
+	}
+	k_msgq_init(&msgq, tbuffer, MSG_SIZE, BATCH_LEN);
+	k_sem_init(&end_sema, 0, 1);
+}
+
+/*test cases*/
+void test_msgq_batch(void)
+{
+	init_batch();
+
+	/* move the read and write pointers so that batches wrap around */
+	zassert_equal(k_msgq_put_batch(&msgq, tx_data, OFFSET, K_NO_WAIT),
+		      OFFSET, NULL);
+	zassert_equal(k_msgq_get_batch(&msgq, rx_data, OFFSET, K_NO_WAIT),
+		      OFFSET, NULL);
+
+	/**TESTPOINT: only as many messages as there is room for are put*/
+	zassert_equal(k_msgq_put_batch(&msgq, tx_data, BATCH_LEN + OFFSET,
+				       K_NO_WAIT), BATCH_LEN, NULL);
+	zassert_equal(k_msgq_num_used_get(&msgq), BATCH_LEN, NULL);
+	zassert_equal(k_msgq_put_batch(&msgq, tx_data, 1, K_NO_WAIT),
+		      -ENOMSG, NULL);
+	zassert_equal(k_msgq_put_batch(&msgq, tx_data, 1, TIMEOUT),
+		      -EAGAIN, NULL);
+
+	/**TESTPOINT: only as many messages as available are got, in order*/
+	zassert_equal(k_msgq_get_batch(&msgq, rx_data, OFFSET, K_NO_WAIT),
+		      OFFSET, NULL);
+	zassert_equal(k_msgq_get_batch(&msgq, &rx_data[OFFSET],
+				       BATCH_LEN + OFFSET, K_NO_WAIT),
+		      BATCH_LEN - OFFSET, NULL);
+	for (int i = 0; i < BATCH_LEN; i++) {
+		zassert_equal(rx_data[i], tx_data[i], NULL);
+	}
+	zassert_equal(k_msgq_get_batch(&msgq, rx_data, 1, K_NO_WAIT),
+		      -ENOMSG, NULL);
+	zassert_equal(k_msgq_get_batch(&msgq, rx_data, 1, TIMEOUT),
+		      -EAGAIN, NULL);
+}
+
+void test_msgq_batch_waiters(void)
+{
+	init_batch();
+
+	/**TESTPOINT: a batch put gives its first message to a waiting reader*/
+	k_tid_t tid = k_thread_create(&tdata, tstack, STACK_SIZE,
+				      thread_get, NULL, NULL, NULL,
+				      K_PRIO_PREEMPT(0), 0, 0);
+	k_sleep(TIMEOUT);
+	zassert_equal(k_msgq_put_batch(&msgq, tx_data, BATCH_LEN, K_NO_WAIT),
+		      BATCH_LEN, NULL);
+	k_sem_take(&end_sema, K_FOREVER);
+	k_thread_abort(tid);
+	zassert_equal(k_msgq_num_used_get(&msgq), BATCH_LEN - 1, NULL);
+
+	/**TESTPOINT: a batch get lets a waiting writer put its message*/
+	zassert_equal(k_msgq_put_batch(&msgq, &tx_data[BATCH_LEN - 1], 1,
+				       K_NO_WAIT), 1, NULL);
+	tid = k_thread_create(&tdata, tstack, STACK_SIZE,
+			      thread_put, NULL, NULL, NULL,
+			      K_PRIO_PREEMPT(0), 0, 0);
+	k_sleep(TIMEOUT);
+	zassert_equal(k_msgq_get_batch(&msgq, rx_data, BATCH_LEN, K_NO_WAIT),
+		      BATCH_LEN, NULL);
+	k_sem_take(&end_sema, K_FOREVER);
+	k_thread_abort(tid);
+	zassert_equal(k_msgq_get_batch(&msgq, rx_data, BATCH_LEN, K_NO_WAIT),
+		      1, NULL);
+	zassert_equal(rx_data[0], tx_data[BATCH_LEN], NULL);
+}
+
+void test_msgq_peek(void)
+{
+	u32_t *msg;
+
+	init_batch();
+
+	/**TESTPOINT: nothing to claim in an empty queue*/
+	zassert_equal(k_msgq_peek_claim(&msgq, (void **)&msg), -ENOMSG,
+		      NULL);
+
+	zassert_equal(k_msgq_put_batch(&msgq, tx_data, 2, K_NO_WAIT), 2,
+		      NULL);
+
+	/**TESTPOINT: messages are read in place, in order*/
+	for (int i = 0; i < 2; i++) {
+		zassert_false(k_msgq_peek_claim(&msgq, (void **)&msg), NULL);
+		zassert_true((char *)msg >= tbuffer &&
+			     (char *)msg < tbuffer + sizeof(tbuffer), NULL);
+		zassert_equal(*msg, tx_data[i], NULL);
+		zassert_equal(k_msgq_num_used_get(&msgq), 2 - i, NULL);
+		k_msgq_peek_finish(&msgq);
+	}
+
+	zassert_equal(k_msgq_num_used_get(&msgq), 0, NULL);
+}
@@ -18,11 +18,26 @@ extern void test_mutex_reent_lock_forever(void);
 extern void test_mutex_reent_lock_no_wait(void);
 extern void test_mutex_reent_lock_timeout_fail(void);
 extern void test_mutex_reent_lock_timeout_pass(void);
+#ifdef CONFIG_CONTENTION_STATS
+extern void test_mutex_contention_uncontended(void);
+extern void test_mutex_contention_wait(void);
+extern void test_mutex_contention_fail(void);
+extern void test_mutex_contention_trace_list(void);
+extern void test_mutex_contention_reinit(void);
+#endif
 
 /*test case main entry*/
 void test_main(void)
 {
+	/* the trace list is walked before other tests initialize again */
 	ztest_test_suite(test_mutex_api,
+#ifdef CONFIG_CONTENTION_STATS
+			 ztest_unit_test(test_mutex_contention_trace_list),
+			 ztest_unit_test(test_mutex_contention_uncontended),
+			 ztest_unit_test(test_mutex_contention_wait),
+			 ztest_unit_test(test_mutex_contention_fail),
+			 ztest_unit_test(test_mutex_contention_reinit),
+#endif
 			 ztest_unit_test(test_mutex_lock_unlock),
 			 ztest_unit_test(test_mutex_reent_lock_forever),
 			 ztest_unit_test(test_mutex_reent_lock_no_wait),
@@ -0,0 +1,142 @@
+/*
+ * Copyright (c) 2017 Intel Corporation
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+/**
+ * @addtogroup t_mutex_api
+ * @{
+ * @defgroup t_mutex_contention test_mutex_contention
+ * @brief TestPurpose: verify the contention statistics of mutexes
+ * - API coverage
+ *   -# k_mutex_contention_get k_mutex_contention_reset k_mutex_init
+ * @}
+ */
+
+#include <ztest.h>
+#include <debug/object_tracing.h>
+
+#define STACK_SIZE 512
+#define HOLD_TIME 50
+/* higher than the priority of the ztest thread, to be boosted to */
+#define WAITER_PRIO (-2)
+
+K_MUTEX_DEFINE(cmutex);
+
+static K_THREAD_STACK_DEFINE(tstack, STACK_SIZE);
+static struct k_thread tdata;
+
+static void tThread_entry_lock(void *p1, void *p2, void *p3)
+{
+	zassert_equal(k_mutex_lock(&cmutex, (s32_t)(long)p1), (long)p2, NULL);
+	if ((long)p2 == 0) {
+		k_mutex_unlock(&cmutex);
+	}
+}
+
+static void contended_lock(s32_t timeout, int expected)
+{
+	zassert_equal(k_mutex_lock(&cmutex, K_FOREVER), 0, NULL);
+
+	k_thread_create(&tdata, tstack, STACK_SIZE, tThread_entry_lock,
+			(void *)(long)timeout, (void *)(long)expected, NULL,
+			WAITER_PRIO, 0, 0);
+
+	/* let the waiter pend on the mutex and time out if it has to */
+	k_sleep(HOLD_TIME);
+	k_mutex_unlock(&cmutex);
+	/* let the waiter take and give the mutex, and exit */
+	k_sleep(HOLD_TIME);
+}
+
+/*test cases*/
+void test_mutex_contention_uncontended(void)
+{
+	struct k_contention_stats stats;
+	int i;
+
+	k_mutex_contention_reset(&cmutex);
+
+	for (i = 0; i < 3; i++) {
+		zassert_equal(k_mutex_lock(&cmutex, K_FOREVER), 0, NULL);
+		k_mutex_unlock(&cmutex);
+	}
+
+	k_mutex_contention_get(&cmutex, &stats);
+	zassert_equal(stats.acquisitions, 3, NULL);
+	zassert_equal(stats.contended, 0, NULL);
+	zassert_equal(stats.failures, 0, NULL);
+	zassert_equal(stats.wait_cycles, 0, NULL);
+	zassert_is_null(stats.top_waiters[0].thread, NULL);
+}
+
+void test_mutex_contention_wait(void)
+{
+	struct k_contention_stats stats;
+
+	k_mutex_contention_reset(&cmutex);
+
+	/**TESTPOINT: the waiter gets the mutex once unlocked*/
+	contended_lock(K_FOREVER, 0);
+
+	k_mutex_contention_get(&cmutex, &stats);
+	zassert_equal(stats.acquisitions, 2, NULL);
+	zassert_equal(stats.contended, 1, NULL);
+	zassert_equal(stats.failures, 0, NULL);
+	zassert_equal(stats.prio_boosts, 1, "owner not boosted");
+	zassert_true(stats.wait_cycles > 0, NULL);
+	zassert_equal(stats.max_wait_cycles, stats.wait_cycles, NULL);
+	zassert_equal(stats.top_waiters[0].thread, &tdata, NULL);
+	zassert_equal(stats.top_waiters[0].waits, 1, NULL);
+	zassert_equal(stats.top_waiters[0].wait_cycles, stats.wait_cycles,
+		      NULL);
+}
+
+void test_mutex_contention_fail(void)
+{
+	struct k_contention_stats stats;
+
+	k_mutex_contention_reset(&cmutex);
+
+	/**TESTPOINT: the waiter times out*/
+	contended_lock(HOLD_TIME / 2, -EAGAIN);
+	/**TESTPOINT: the waiter does not wait*/
+	contended_lock(K_NO_WAIT, -EBUSY);
+
+	k_mutex_contention_get(&cmutex, &stats);
+	zassert_equal(stats.acquisitions, 2, NULL);
+	zassert_equal(stats.contended, 1, NULL);
+	zassert_equal(stats.failures, 2, NULL);
+	zassert_equal(stats.top_waiters[0].thread, &tdata, NULL);
+	zassert_is_null(stats.top_waiters[1].thread, NULL);
+}
+
+void test_mutex_contention_trace_list(void)
+{
+	struct k_mutex *mutex;
+
+	/**TESTPOINT: the mutex is found through the object tracing list*/
+	mutex = SYS_TRACING_HEAD(struct k_mutex, k_mutex);
+	while (mutex != NULL && mutex != &cmutex) {
+		mutex = SYS_TRACING_NEXT(struct k_mutex, k_mutex, mutex);
+	}
+
+	zassert_equal(mutex, &cmutex, "mutex not traced");
+}
+
+void test_mutex_contention_reinit(void)
+{
+	struct k_contention_stats stats;
+
+	/* statistics left over by a previous use of the mutex */
+	contended_lock(K_FOREVER, 0);
+
+	/**TESTPOINT: initializing the mutex again clears them*/
+	k_mutex_init(&cmutex);
+	k_mutex_contention_get(&cmutex, &stats);
+	zassert_equal(stats.acquisitions, 0, NULL);
+	zassert_equal(stats.contended, 0, NULL);
+	zassert_equal(stats.prio_boosts, 0, NULL);
+	zassert_is_null(stats.top_waiters[0].thread, NULL);
+}
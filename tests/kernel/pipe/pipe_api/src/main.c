@@ -18,6 +18,8 @@ extern void test_pipe_get_fail(void);
 extern void test_pipe_block_put(void);
 extern void test_pipe_block_put_sema(void);
 extern void test_pipe_get_put(void);
+extern void test_pipe_claim_wrap(void);
+extern void test_pipe_claim_thread2thread(void);
 
 /*test case main entry*/
 void test_main(void)
@@ -28,6 +30,8 @@ void test_main(void)
 			 ztest_unit_test(test_pipe_get_fail),
 			 ztest_unit_test(test_pipe_block_put),
 			 ztest_unit_test(test_pipe_block_put_sema),
-			 ztest_unit_test(test_pipe_get_put));
+			 ztest_unit_test(test_pipe_get_put),
+			 ztest_unit_test(test_pipe_claim_wrap),
+			 ztest_unit_test(test_pipe_claim_thread2thread));
 	ztest_run_test_suite(test_pipe_api);
 }
@@ -0,0 +1,168 @@
+/*
+ * Copyright (c) 2017 Intel Corporation
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+/**
+ * @addtogroup t_pipe_api
+ * @{
+ * @defgroup t_pipe_api_claim test_pipe_api_claim
+ * @brief TestPurpose: verify in place access to the pipe buffer
+ * - API coverage
+ *   -# k_pipe_put_claim
+ *   -# k_pipe_put_commit
+ *   -# k_pipe_get_claim
+ *   -# k_pipe_get_finish
+ * @}
+ */
+
+#include <ztest.h>
+
+#define STACK_SIZE 1024
+#define PIPE_LEN 16
+#define OFFSET 10
+
+static unsigned char __aligned(4) data[] = "abcd1234$%^&PIPE";
+static unsigned char __aligned(4) buffer[PIPE_LEN];
+static struct k_pipe pipe;
+
+static K_THREAD_STACK_DEFINE(tstack, STACK_SIZE);
+static struct k_thread tdata;
+static struct k_sem end_sema;
+
+static void tpipe_claim_put(struct k_pipe *ppipe, unsigned char *src,
+			    size_t len)
+{
+	size_t claimed;
+	void *ptr;
+
+	while (len) {
+		claimed = len;
+		zassert_false(k_pipe_put_claim(ppipe, &ptr, &claimed,
+					       K_FOREVER), NULL);
+		zassert_true(claimed > 0 && claimed <= len, NULL);
+		memcpy(ptr, src, claimed);
+		k_pipe_put_commit(ppipe, claimed);
+		src += claimed;
+		len -= claimed;
+	}
+}
+
+static void tpipe_claim_get(struct k_pipe *ppipe, unsigned char *dest,
+			    size_t len)
+{
+	size_t claimed;
+	void *ptr;
+
+	while (len) {
+		claimed = len;
+		zassert_false(k_pipe_get_claim(ppipe, &ptr, &claimed,
+					       K_FOREVER), NULL);
+		zassert_true(claimed > 0 && claimed <= len, NULL);
+		memcpy(dest, ptr, claimed);
+		k_pipe_get_finish(ppipe, claimed);
+		dest += claimed;
+		len -= claimed;
+	}
+}
+
+static void tThread_get(void *p1, void *p2, void *p3)
+{
+	unsigned char rx_data[PIPE_LEN];
+	size_t rd_byte;
+
+	zassert_false(k_pipe_get((struct k_pipe *)p1, rx_data, PIPE_LEN,
+				 &rd_byte, PIPE_LEN, K_FOREVER), NULL);
+	zassert_equal(rd_byte, PIPE_LEN, NULL);
+	zassert_false(memcmp(rx_data, data, PIPE_LEN), NULL);
+	k_sem_give(&end_sema);
+}
+
+static void tThread_claim_get(void *p1, void *p2, void *p3)
+{
+	unsigned char rx_data[PIPE_LEN];
+
+	tpipe_claim_get((struct k_pipe *)p1, rx_data, PIPE_LEN);
+	zassert_false(memcmp(rx_data, data, PIPE_LEN), NULL);
+	k_sem_give(&end_sema);
+}
+
+/*test cases*/
+void test_pipe_claim_wrap(void)
+{
+	unsigned char rx_data[PIPE_LEN];
+	size_t claimed, xferd;
+	void *ptr;
+
+	k_pipe_init(&pipe, buffer, PIPE_LEN);
+
+	/**TESTPOINT: nothing to claim without waiting*/
+	claimed = PIPE_LEN;
+	zassert_equal(k_pipe_get_claim(&pipe, &ptr, &claimed, K_NO_WAIT),
+		      -EIO, NULL);
+	zassert_equal(claimed, 0, NULL);
+
+	/* move the indexes so that the next transfers wrap around */
+	zassert_false(k_pipe_put(&pipe, data, OFFSET, &xferd, OFFSET,
+				 K_NO_WAIT), NULL);
+	zassert_false(k_pipe_get(&pipe, rx_data, OFFSET, &xferd, OFFSET,
+				 K_NO_WAIT), NULL);
+
+	/**TESTPOINT: claimed space stops at the end of the buffer*/
+	claimed = PIPE_LEN;
+	zassert_false(k_pipe_put_claim(&pipe, &ptr, &claimed, K_NO_WAIT),
+		      NULL);
+	zassert_equal(ptr, buffer + OFFSET, NULL);
+	zassert_equal(claimed, PIPE_LEN - OFFSET, NULL);
+	k_pipe_put_commit(&pipe, 0);
+
+	tpipe_claim_put(&pipe, data, PIPE_LEN);
+
+	/**TESTPOINT: nothing to claim in a full pipe without waiting*/
+	claimed = 1;
+	zassert_equal(k_pipe_put_claim(&pipe, &ptr, &claimed, K_NO_WAIT),
+		      -EIO, NULL);
+
+	/**TESTPOINT: claimed data stops at the end of the buffer*/
+	claimed = PIPE_LEN;
+	zassert_false(k_pipe_get_claim(&pipe, &ptr, &claimed, K_NO_WAIT),
+		      NULL);
+	zassert_equal(ptr, buffer + OFFSET, NULL);
+	zassert_equal(claimed, PIPE_LEN - OFFSET, NULL);
+	k_pipe_get_finish(&pipe, 0);
+
+	/**TESTPOINT: data written in place reads back in order*/
+	tpipe_claim_get(&pipe, rx_data, PIPE_LEN);
+	zassert_false(memcmp(rx_data, data, PIPE_LEN), NULL);
+}
+
+void test_pipe_claim_thread2thread(void)
+{
+	k_pipe_init(&pipe, buffer, PIPE_LEN);
+	k_sem_init(&end_sema, 0, 1);
+
+	/**TESTPOINT: a commit readies a reader waiting in k_pipe_get*/
+	k_tid_t tid = k_thread_create(&tdata, tstack, STACK_SIZE,
+				      tThread_get, &pipe, NULL, NULL,
+				      K_PRIO_PREEMPT(0), 0, 0);
+	k_sleep(10);
+	tpipe_claim_put(&pipe, data, PIPE_LEN);
+	k_sem_take(&end_sema, K_FOREVER);
+	k_thread_abort(tid);
+
+	/**TESTPOINT: k_pipe_put readies a reader waiting for a claim*/
+	tid = k_thread_create(&tdata, tstack, STACK_SIZE,
+			      tThread_claim_get, &pipe, NULL, NULL,
+			      K_PRIO_PREEMPT(0), 0, 0);
+	k_sleep(10);
+	for (int i = 0; i < PIPE_LEN; i += 4) {
+		size_t wt_byte;
+
+		zassert_false(k_pipe_put(&pipe, &data[i], 4, &wt_byte, 4,
+					 K_FOREVER), NULL);
+		k_sleep(1);
+	}
+	k_sem_take(&end_sema, K_FOREVER);
+	k_thread_abort(tid);
+}
@@ -15,6 +15,7 @@
 extern void test_poll_no_wait(void);
 extern void test_poll_wait(void);
 extern void test_poll_multi(void);
+extern void test_poll_set(void);
 
 /*test case main entry*/
 void test_main(void)
@@ -23,6 +24,7 @@ void test_main(void)
 			 , ztest_unit_test(test_poll_no_wait)
 			 , ztest_unit_test(test_poll_wait)
 			 , ztest_unit_test(test_poll_multi)
+			 , ztest_unit_test(test_poll_set)
 			 );
 	ztest_run_test_suite(test_poll_api);
 }
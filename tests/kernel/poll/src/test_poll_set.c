@@ -0,0 +1,123 @@
+/*
+ * Copyright (c) 2017 Intel Corporation
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+/**
+ * @addtogroup t_poll_api
+ * @{
+ * @defgroup t_poll_api_set test_poll_api_set
+ * @brief TestPurpose: verify persistent poll sets
+ * - API coverage
+ *   -# k_poll_set_init
+ *   -# k_poll_set_add k_poll_set_remove
+ *   -# k_poll_set_wait
+ * @}
+ */
+
+#include <ztest.h>
+#include <kernel.h>
+
+#define STACK_SIZE 1024
+#define SET_SIGNAL_RESULT 0x5e7
+
+struct fifo_msg {
+	void *private;
+	u32_t msg;
+};
+
+static struct k_poll_set set;
+static struct k_sem set_sem;
+static struct k_fifo set_fifo;
+static struct k_poll_signal set_signal;
+
+static struct k_poll_event set_events[] = {
+	K_POLL_EVENT_INITIALIZER(K_POLL_TYPE_SEM_AVAILABLE,
+				 K_POLL_MODE_NOTIFY_ONLY,
+				 &set_sem),
+	K_POLL_EVENT_INITIALIZER(K_POLL_TYPE_FIFO_DATA_AVAILABLE,
+				 K_POLL_MODE_NOTIFY_ONLY,
+				 &set_fifo),
+	K_POLL_EVENT_INITIALIZER(K_POLL_TYPE_SIGNAL,
+				 K_POLL_MODE_NOTIFY_ONLY,
+				 &set_signal),
+};
+
+static K_THREAD_STACK_DEFINE(set_stack, STACK_SIZE);
+static struct k_thread set_thread;
+
+static void set_sem_giver(void *p1, void *p2, void *p3)
+{
+	k_sem_give(&set_sem);
+}
+
+void test_poll_set(void)
+{
+	struct fifo_msg msg = { NULL, 0 };
+	struct k_poll_event *ready[ARRAY_SIZE(set_events)];
+
+	k_sem_init(&set_sem, 0, 1);
+	k_fifo_init(&set_fifo);
+	k_poll_signal_init(&set_signal);
+	k_poll_set_init(&set);
+
+	for (int i = 0; i < ARRAY_SIZE(set_events); i++) {
+		k_poll_set_add(&set, &set_events[i]);
+	}
+
+	/* nothing happened yet */
+	zassert_equal(k_poll_set_wait(&set, ready, ARRAY_SIZE(ready), 0),
+		      -EAGAIN, "");
+	zassert_equal(k_poll_set_wait(&set, ready, ARRAY_SIZE(ready),
+				      K_MSEC(10)), -EAGAIN, "");
+
+	/* only the event that occurred is returned */
+	k_poll_signal(&set_signal, SET_SIGNAL_RESULT);
+	zassert_equal(k_poll_set_wait(&set, ready, ARRAY_SIZE(ready), 0),
+		      1, "");
+	zassert_equal(ready[0], &set_events[2], "");
+	zassert_equal(ready[0]->state, K_POLL_STATE_SIGNALED, "");
+	zassert_equal(set_signal.result, SET_SIGNAL_RESULT, "");
+
+	/* events are level-triggered: returned until their condition clears */
+	zassert_equal(k_poll_set_wait(&set, ready, ARRAY_SIZE(ready), 0),
+		      1, "");
+	zassert_equal(ready[0], &set_events[2], "");
+	set_signal.signaled = 0;
+	zassert_equal(k_poll_set_wait(&set, ready, ARRAY_SIZE(ready), 0),
+		      -EAGAIN, "");
+
+	/* several events are returned at once, in the order they occurred */
+	k_sem_give(&set_sem);
+	k_fifo_put(&set_fifo, &msg);
+	zassert_equal(k_poll_set_wait(&set, ready, ARRAY_SIZE(ready), 0),
+		      2, "");
+	zassert_equal(ready[0], &set_events[0], "");
+	zassert_equal(ready[0]->state, K_POLL_STATE_SEM_AVAILABLE, "");
+	zassert_equal(ready[1], &set_events[1], "");
+	zassert_equal(ready[1]->state, K_POLL_STATE_FIFO_DATA_AVAILABLE, "");
+	zassert_equal(k_sem_take(&set_sem, 0), 0, "");
+	zassert_equal(k_fifo_get(&set_fifo, 0), &msg, "");
+	zassert_equal(k_poll_set_wait(&set, ready, ARRAY_SIZE(ready), 0),
+		      -EAGAIN, "");
+
+	/* a thread waiting on the set is woken up by an event */
+	k_thread_create(&set_thread, set_stack, STACK_SIZE, set_sem_giver,
+			NULL, NULL, NULL, K_PRIO_PREEMPT(0), 0, 0);
+	zassert_equal(k_poll_set_wait(&set, ready, ARRAY_SIZE(ready),
+				      K_FOREVER), 1, "");
+	zassert_equal(ready[0], &set_events[0], "");
+	zassert_equal(k_sem_take(&set_sem, 0), 0, "");
+
+	/* removed events are not returned anymore */
+	for (int i = 0; i < ARRAY_SIZE(set_events); i++) {
+		k_poll_set_remove(&set, &set_events[i]);
+	}
+	k_sem_give(&set_sem);
+	k_poll_signal(&set_signal, SET_SIGNAL_RESULT);
+	zassert_equal(k_poll_set_wait(&set, ready, ARRAY_SIZE(ready), 0),
+		      -EAGAIN, "");
+	zassert_equal(k_sem_take(&set_sem, 0), 0, "");
+	zassert_true(sys_dlist_is_empty(&set_signal.poll_events), "");
+}
@@ -0,0 +1,106 @@
+/*
+ * Copyright (c) 2017 Intel Corporation
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+#include <ztest.h>
+
+#define STACK_SIZE 512
+#define BUSY_MS 10
+
+static K_THREAD_STACK_DEFINE(busy_stack, STACK_SIZE);
+static struct k_thread busy_thread;
+
+static u32_t ms_to_cycles(u32_t ms)
+{
+	return ms * (sys_clock_hw_cycles_per_sec / MSEC_PER_SEC);
+}
+
+static void busy_entry(void *p1, void *p2, void *p3)
+{
+	ARG_UNUSED(p1);
+	ARG_UNUSED(p2);
+	ARG_UNUSED(p3);
+
+	k_busy_wait(BUSY_MS * USEC_PER_MSEC);
+}
+
+/**
+ * @brief Check that the current thread is charged the time it runs
+ */
+void test_runtime_current(void)
+{
+	struct k_thread_runtime_stats before, after;
+
+	k_thread_runtime_stats_get(k_current_get(), &before);
+	k_busy_wait(BUSY_MS * USEC_PER_MSEC);
+	k_thread_runtime_stats_get(k_current_get(), &after);
+
+	zassert_true(after.running_cycles - before.running_cycles >=
+		     ms_to_cycles(BUSY_MS), "running time not accounted");
+	zassert_equal(after.switches, before.switches,
+		      "switched while busy");
+}
+
+/**
+ * @brief Check the running, ready and switch counts of a preempting thread
+ *
+ * A higher priority thread runs for BUSY_MS right when it is created: the
+ * current thread waits as long, ready to run.
+ */
+void test_runtime_preempted(void)
+{
+	struct k_thread_runtime_stats busy, before, after;
+
+	k_thread_runtime_stats_get(k_current_get(), &before);
+
+	k_thread_create(&busy_thread, busy_stack, STACK_SIZE,
+			busy_entry, NULL, NULL, NULL,
+			k_thread_priority_get(k_current_get()) - 1, 0,
+			K_NO_WAIT);
+
+	k_thread_runtime_stats_get(k_current_get(), &after);
+	k_thread_runtime_stats_get(&busy_thread, &busy);
+
+	zassert_true(busy.running_cycles >= ms_to_cycles(BUSY_MS),
+		     "busy thread running time not accounted");
+	zassert_equal(busy.switches, 1, "busy thread switched in more than once");
+	zassert_true(after.ready_cycles - before.ready_cycles >=
+		     ms_to_cycles(BUSY_MS), "ready time not accounted");
+	zassert_equal(after.switches, before.switches + 1,
+		      "current thread switch not counted");
+}
+
+/**
+ * @brief Check that the CPU is idle while the current thread sleeps
+ */
+void test_runtime_idle(void)
+{
+	struct k_cpu_runtime_stats before, after;
+	struct k_thread_runtime_stats self_before, self_after;
+
+	k_cpu_runtime_stats_get(&before);
+	k_thread_runtime_stats_get(k_current_get(), &self_before);
+
+	k_sleep(50);
+
+	k_cpu_runtime_stats_get(&after);
+	k_thread_runtime_stats_get(k_current_get(), &self_after);
+
+	zassert_true(after.idle_cycles - before.idle_cycles >=
+		     ms_to_cycles(40), "idle time not accounted");
+	zassert_true(self_after.running_cycles - self_before.running_cycles <
+		     ms_to_cycles(10), "sleeping thread charged");
+	zassert_true(after.total_cycles >= after.idle_cycles,
+		     "more idle than elapsed time");
+}
+
+void test_main(void)
+{
+	ztest_test_suite(test_runtime_stats,
+			 ztest_unit_test(test_runtime_current),
+			 ztest_unit_test(test_runtime_preempted),
+			 ztest_unit_test(test_runtime_idle));
+	ztest_run_test_suite(test_runtime_stats);
+}
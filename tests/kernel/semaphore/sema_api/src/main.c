@@ -17,11 +17,22 @@ extern void test_sema_thread2thread(void);
 extern void test_sema_thread2isr(void);
 extern void test_sema_reset(void);
 extern void test_sema_count_get(void);
+#ifdef CONFIG_CONTENTION_STATS
+extern void test_sema_contention(void);
+extern void test_sema_contention_trace_list(void);
+extern void test_sema_contention_reinit(void);
+#endif
 
 /*test case main entry*/
 void test_main(void)
 {
+	/* the trace list is walked before other tests initialize again */
 	ztest_test_suite(test_sema_api,
+#ifdef CONFIG_CONTENTION_STATS
+			 ztest_unit_test(test_sema_contention_trace_list),
+			 ztest_unit_test(test_sema_contention),
+			 ztest_unit_test(test_sema_contention_reinit),
+#endif
 			 ztest_unit_test(test_sema_thread2thread),
 			 ztest_unit_test(test_sema_thread2isr),
 			 ztest_unit_test(test_sema_reset),
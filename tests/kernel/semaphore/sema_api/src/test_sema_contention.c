@@ -0,0 +1,102 @@
+/*
+ * Copyright (c) 2017 Intel Corporation
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+/**
+ * @addtogroup t_sema_api
+ * @{
+ * @defgroup t_sema_contention test_sema_contention
+ * @brief TestPurpose: verify the contention statistics of semaphores
+ * - API coverage
+ *   -# k_sem_contention_get k_sem_contention_reset k_sem_init
+ * @}
+ */
+
+#include <ztest.h>
+#include <irq_offload.h>
+#include <debug/object_tracing.h>
+
+#define STACK_SIZE 512
+#define GIVE_DELAY 50
+
+K_SEM_DEFINE(csema, 0, 1);
+static K_THREAD_STACK_DEFINE(tstack, STACK_SIZE);
+static struct k_thread tdata;
+
+static void tisr_entry(void *p)
+{
+	zassert_equal(k_sem_take((struct k_sem *)p, K_NO_WAIT), -EBUSY, NULL);
+}
+
+static void thread_entry(void *p1, void *p2, void *p3)
+{
+	k_sleep(GIVE_DELAY);
+	k_sem_give((struct k_sem *)p1);
+}
+
+/*test cases*/
+void test_sema_contention(void)
+{
+	struct k_contention_stats stats;
+
+	k_sem_contention_reset(&csema);
+
+	/**TESTPOINT: take without waiting*/
+	k_sem_give(&csema);
+	zassert_equal(k_sem_take(&csema, K_FOREVER), 0, NULL);
+
+	/**TESTPOINT: fail to take from an isr*/
+	irq_offload(tisr_entry, &csema);
+
+	/**TESTPOINT: wait for the semaphore to be given*/
+	k_thread_create(&tdata, tstack, STACK_SIZE, thread_entry, &csema,
+			NULL, NULL, K_PRIO_PREEMPT(0), 0, 0);
+	zassert_equal(k_sem_take(&csema, K_FOREVER), 0, NULL);
+
+	k_sem_contention_get(&csema, &stats);
+	zassert_equal(stats.acquisitions, 2, NULL);
+	zassert_equal(stats.contended, 1, NULL);
+	zassert_equal(stats.failures, 1, NULL);
+	zassert_equal(stats.prio_boosts, 0, NULL);
+	zassert_true(stats.max_wait_cycles > 0, NULL);
+	zassert_equal(stats.top_waiters[0].thread, k_current_get(), NULL);
+	zassert_equal(stats.top_waiters[0].waits, 1, NULL);
+
+	k_sem_contention_reset(&csema);
+	k_sem_contention_get(&csema, &stats);
+	zassert_equal(stats.acquisitions, 0, NULL);
+	zassert_is_null(stats.top_waiters[0].thread, NULL);
+}
+
+void test_sema_contention_trace_list(void)
+{
+	struct k_sem *sem;
+
+	/**TESTPOINT: the semaphore is found through the object tracing list*/
+	sem = SYS_TRACING_HEAD(struct k_sem, k_sem);
+	while (sem != NULL && sem != &csema) {
+		sem = SYS_TRACING_NEXT(struct k_sem, k_sem, sem);
+	}
+
+	zassert_equal(sem, &csema, "semaphore not traced");
+}
+
+void test_sema_contention_reinit(void)
+{
+	struct k_contention_stats stats;
+
+	/* statistics left over by a previous use of the semaphore */
+	k_thread_create(&tdata, tstack, STACK_SIZE, thread_entry, &csema,
+			NULL, NULL, K_PRIO_PREEMPT(0), 0, 0);
+	zassert_equal(k_sem_take(&csema, K_FOREVER), 0, NULL);
+
+	/**TESTPOINT: initializing the semaphore again clears them*/
+	k_sem_init(&csema, 0, 1);
+	k_sem_contention_get(&csema, &stats);
+	zassert_equal(stats.acquisitions, 0, NULL);
+	zassert_equal(stats.contended, 0, NULL);
+	zassert_equal(stats.wait_cycles, 0, NULL);
+	zassert_is_null(stats.top_waiters[0].thread, NULL);
+}
@@ -15,6 +15,10 @@
 extern void test_stack_thread2thread(void);
 extern void test_stack_thread2isr(void);
 extern void test_stack_pop_fail(void);
+extern void test_stack_push_n(void);
+extern void test_stack_pop_n(void);
+extern void test_stack_batch_waiter(void);
+extern void test_stack_batch_isr(void);
 
 /*test case main entry*/
 void test_main(void)
@@ -22,6 +26,10 @@ void test_main(void)
 	ztest_test_suite(test_stack_api,
 			 ztest_unit_test(test_stack_thread2thread),
 			 ztest_unit_test(test_stack_thread2isr),
-			 ztest_unit_test(test_stack_pop_fail));
+			 ztest_unit_test(test_stack_pop_fail),
+			 ztest_unit_test(test_stack_push_n),
+			 ztest_unit_test(test_stack_pop_n),
+			 ztest_unit_test(test_stack_batch_waiter),
+			 ztest_unit_test(test_stack_batch_isr));
 	ztest_run_test_suite(test_stack_api);
 }
@@ -0,0 +1,150 @@
+/*
+ * Copyright (c) 2017 Intel Corporation
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+/**
+ * @addtogroup t_stack_api
+ * @{
+ * @defgroup t_stack_batch test_stack_batch
+ * @brief TestPurpose: verify pushing and popping several stack items at once
+ * - API coverage
+ *   -# k_stack_push_n
+ *   -# k_stack_pop_n
+ * @}
+ */
+
+#include <ztest.h>
+#include <irq_offload.h>
+
+#define STACK_SIZE 512
+#define STACK_LEN 8
+#define TIMEOUT 100
+
+static struct k_stack stack;
+static u32_t buffer[STACK_LEN];
+static const u32_t values[STACK_LEN] = {
+	0x10, 0x11, 0x12, 0x13, 0x14, 0x15, 0x16, 0x17
+};
+
+static K_THREAD_STACK_DEFINE(threadstack, STACK_SIZE);
+static struct k_thread thread_data;
+static u32_t rx_waiter[STACK_LEN];
+static int rx_count;
+
+/* pop the whole stack, one item at a time, and check it holds the values */
+static void check_content(const u32_t *expected, int num)
+{
+	u32_t rx_data;
+	int i;
+
+	for (i = num - 1; i >= 0; i--) {
+		zassert_false(k_stack_pop(&stack, &rx_data, K_NO_WAIT), NULL);
+		zassert_equal(rx_data, expected[i], NULL);
+	}
+
+	zassert_equal(k_stack_pop(&stack, &rx_data, K_NO_WAIT), -EBUSY,
+		      "stack not empty");
+}
+
+static void tIsr_entry_push_n(void *p)
+{
+	k_stack_push_n((struct k_stack *)p, values, STACK_LEN);
+}
+
+static void tIsr_entry_pop_n(void *p)
+{
+	rx_count = k_stack_pop_n((struct k_stack *)p, rx_waiter, STACK_LEN,
+				 K_NO_WAIT);
+}
+
+static void tThread_entry(void *p1, void *p2, void *p3)
+{
+	rx_count = k_stack_pop_n((struct k_stack *)p1, rx_waiter, STACK_LEN,
+				 K_FOREVER);
+}
+
+/*test cases*/
+void test_stack_push_n(void)
+{
+	k_stack_init(&stack, buffer, STACK_LEN);
+
+	/**TESTPOINT: the last value pushed ends on top*/
+	k_stack_push_n(&stack, values, STACK_LEN);
+	check_content(values, STACK_LEN);
+
+	/**TESTPOINT: batch and single pushes combine*/
+	k_stack_push(&stack, values[0]);
+	k_stack_push_n(&stack, &values[1], STACK_LEN - 1);
+	check_content(values, STACK_LEN);
+}
+
+void test_stack_pop_n(void)
+{
+	u32_t rx_data[STACK_LEN];
+	int i;
+
+	k_stack_init(&stack, buffer, STACK_LEN);
+	k_stack_push_n(&stack, values, STACK_LEN);
+
+	/**TESTPOINT: the top of the stack is popped first*/
+	zassert_equal(k_stack_pop_n(&stack, rx_data, 3, K_NO_WAIT), 3, NULL);
+	for (i = 0; i < 3; i++) {
+		zassert_equal(rx_data[i], values[STACK_LEN - 1 - i], NULL);
+	}
+
+	/**TESTPOINT: no more values than the stack holds are popped*/
+	zassert_equal(k_stack_pop_n(&stack, rx_data, STACK_LEN, K_NO_WAIT),
+		      STACK_LEN - 3, NULL);
+	for (i = 0; i < STACK_LEN - 3; i++) {
+		zassert_equal(rx_data[i], values[STACK_LEN - 4 - i], NULL);
+	}
+
+	/**TESTPOINT: popping from an empty stack fails as k_stack_pop does*/
+	zassert_equal(k_stack_pop_n(&stack, rx_data, STACK_LEN, K_NO_WAIT),
+		      -EBUSY, NULL);
+	zassert_equal(k_stack_pop_n(&stack, rx_data, STACK_LEN, TIMEOUT),
+		      -EAGAIN, NULL);
+}
+
+void test_stack_batch_waiter(void)
+{
+	k_tid_t tid;
+
+	k_stack_init(&stack, buffer, STACK_LEN);
+	rx_count = 0;
+
+	tid = k_thread_create(&thread_data, threadstack, STACK_SIZE,
+			      tThread_entry, &stack, NULL, NULL,
+			      K_PRIO_PREEMPT(0), 0, 0);
+	k_sleep(10);
+
+	/**TESTPOINT: a waiting thread gets the first value pushed, alone*/
+	k_stack_push_n(&stack, values, STACK_LEN);
+	k_sleep(10);
+
+	zassert_equal(rx_count, 1, NULL);
+	zassert_equal(rx_waiter[0], values[0], NULL);
+	check_content(&values[1], STACK_LEN - 1);
+
+	k_thread_abort(tid);
+}
+
+void test_stack_batch_isr(void)
+{
+	int i;
+
+	k_stack_init(&stack, buffer, STACK_LEN);
+
+	/**TESTPOINT: batch push and pop from an isr*/
+	irq_offload(tIsr_entry_push_n, &stack);
+
+	rx_count = 0;
+	irq_offload(tIsr_entry_pop_n, &stack);
+
+	zassert_equal(rx_count, STACK_LEN, NULL);
+	for (i = 0; i < STACK_LEN; i++) {
+		zassert_equal(rx_waiter[i], values[STACK_LEN - 1 - i], NULL);
+	}
+}
@@ -0,0 +1,343 @@
+/*
+ * Copyright (c) 2017 Intel Corporation
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+/**
+ * @addtogroup t_tasklet
+ * @{
+ * @defgroup t_tasklet_api test_tasklet_api
+ * @brief TestPurpose: verify that tasklets wait on kernel objects and
+ *                     timeouts, and resume where they left off
+ * - API coverage
+ *   -# k_tasklet_init K_TASKLET_DEFINE k_tasklet_start
+ *   -# K_TASKLET_SEM_TAKE K_TASKLET_QUEUE_GET K_TASKLET_SIGNAL_WAIT
+ *   -# K_TASKLET_SLEEP K_TASKLET_YIELD
+ * @}
+ */
+
+#include <ztest.h>
+#include <irq_offload.h>
+
+#define TIMEOUT 100
+#define NUM_TASKLETS 32
+#define NUM_STEPS 3
+
+struct test_tasklet {
+	struct k_tasklet tasklet;
+	int steps;
+	int results[NUM_STEPS];
+	void *data;
+};
+
+static struct test_tasklet tasklets[NUM_TASKLETS];
+
+K_SEM_DEFINE(sem, 0, NUM_TASKLETS);
+K_FIFO_DEFINE(fifo);
+static struct k_poll_signal signal;
+
+static void reset(void)
+{
+	int i;
+
+	for (i = 0; i < NUM_TASKLETS; i++) {
+		zassert_true(k_tasklet_is_idle(&tasklets[i].tasklet),
+			     "tasklet of a previous test still running");
+	}
+
+	memset(tasklets, 0, sizeof(tasklets));
+	k_sem_reset(&sem);
+	k_poll_signal_init(&signal);
+}
+
+static void start(struct test_tasklet *t, k_tasklet_handler_t handler)
+{
+	k_tasklet_init(&t->tasklet, handler);
+	zassert_equal(k_tasklet_start(&k_sys_tasklet_executor, &t->tasklet),
+		      0, NULL);
+}
+
+/* the system executor runs when the test thread sleeps */
+static void wait_idle(struct test_tasklet *t)
+{
+	int i;
+
+	for (i = 0; i < 10 && !k_tasklet_is_idle(&t->tasklet); i++) {
+		k_sleep(TIMEOUT);
+	}
+
+	zassert_true(k_tasklet_is_idle(&t->tasklet), "tasklet not ended");
+}
+
+static void sem_handler(struct k_tasklet *tasklet)
+{
+	struct test_tasklet *t = CONTAINER_OF(tasklet, struct test_tasklet,
+					      tasklet);
+
+	K_TASKLET_BEGIN(tasklet);
+
+	for (t->steps = 0; t->steps < NUM_STEPS; t->steps++) {
+		K_TASKLET_SEM_TAKE(tasklet, &sem, K_FOREVER);
+		t->results[t->steps] = k_tasklet_result(tasklet);
+	}
+
+	K_TASKLET_END(tasklet);
+}
+
+/*test cases*/
+void test_tasklet_sem_take(void)
+{
+	struct test_tasklet *t = &tasklets[0];
+	int i;
+
+	reset();
+	start(t, sem_handler);
+
+	/**TESTPOINT: the tasklet resumes each time the semaphore is given*/
+	for (i = 0; i < NUM_STEPS; i++) {
+		k_sleep(10);
+		zassert_equal(t->steps, i, "tasklet did not wait");
+		k_sem_give(&sem);
+	}
+
+	wait_idle(t);
+	zassert_equal(t->steps, NUM_STEPS, NULL);
+	for (i = 0; i < NUM_STEPS; i++) {
+		zassert_equal(t->results[i], 0, NULL);
+	}
+}
+
+static void timeout_handler(struct k_tasklet *tasklet)
+{
+	struct test_tasklet *t = CONTAINER_OF(tasklet, struct test_tasklet,
+					      tasklet);
+
+	K_TASKLET_BEGIN(tasklet);
+
+	K_TASKLET_SEM_TAKE(tasklet, &sem, K_NO_WAIT);
+	t->results[0] = k_tasklet_result(tasklet);
+
+	K_TASKLET_SEM_TAKE(tasklet, &sem, TIMEOUT);
+	t->results[1] = k_tasklet_result(tasklet);
+
+	K_TASKLET_END(tasklet);
+}
+
+void test_tasklet_sem_take_timeout(void)
+{
+	struct test_tasklet *t = &tasklets[0];
+	s64_t stamp;
+
+	reset();
+
+	stamp = k_uptime_get();
+	start(t, timeout_handler);
+	wait_idle(t);
+
+	/**TESTPOINT: waits without the object fail as k_sem_take() does*/
+	zassert_equal(t->results[0], -EBUSY, NULL);
+	zassert_equal(t->results[1], -EAGAIN, NULL);
+	zassert_true(k_uptime_delta(&stamp) >= TIMEOUT, "timed out early");
+}
+
+static void queue_handler(struct k_tasklet *tasklet)
+{
+	struct test_tasklet *t = CONTAINER_OF(tasklet, struct test_tasklet,
+					      tasklet);
+
+	K_TASKLET_BEGIN(tasklet);
+
+	for (t->steps = 0; t->steps < NUM_STEPS; t->steps++) {
+		K_TASKLET_QUEUE_GET(tasklet, &fifo._queue, t->data, TIMEOUT);
+		t->results[t->steps] = (int)(long)t->data;
+	}
+
+	K_TASKLET_END(tasklet);
+}
+
+void test_tasklet_queue_get(void)
+{
+	struct test_tasklet *t = &tasklets[0];
+	static void *items[2][2];
+
+	reset();
+	start(t, queue_handler);
+
+	/**TESTPOINT: the tasklet gets the elements, then times out*/
+	k_fifo_put(&fifo, items[0]);
+	k_sleep(10);
+	k_fifo_put(&fifo, items[1]);
+
+	wait_idle(t);
+	zassert_equal(t->results[0], (int)(long)items[0], NULL);
+	zassert_equal(t->results[1], (int)(long)items[1], NULL);
+	zassert_equal(t->results[2], 0, "got an element from an empty queue");
+	zassert_equal(k_tasklet_result(&t->tasklet), -EAGAIN, NULL);
+}
+
+static void signal_handler(struct k_tasklet *tasklet)
+{
+	struct test_tasklet *t = CONTAINER_OF(tasklet, struct test_tasklet,
+					      tasklet);
+
+	K_TASKLET_BEGIN(tasklet);
+
+	K_TASKLET_SIGNAL_WAIT(tasklet, &signal, K_FOREVER);
+	t->results[0] = signal.result;
+
+	K_TASKLET_END(tasklet);
+}
+
+static void tisr_entry(void *p)
+{
+	k_poll_signal((struct k_poll_signal *)p, 0x5a);
+}
+
+void test_tasklet_signal_wait(void)
+{
+	struct test_tasklet *t = &tasklets[0];
+
+	reset();
+	start(t, signal_handler);
+	k_sleep(10);
+
+	/**TESTPOINT: the tasklet is woken by a signal raised from an isr*/
+	irq_offload(tisr_entry, &signal);
+
+	wait_idle(t);
+	zassert_equal(t->results[0], 0x5a, NULL);
+}
+
+static void sleep_handler(struct k_tasklet *tasklet)
+{
+	K_TASKLET_BEGIN(tasklet);
+	K_TASKLET_SLEEP(tasklet, TIMEOUT);
+	K_TASKLET_END(tasklet);
+}
+
+void test_tasklet_sleep(void)
+{
+	struct test_tasklet *t = &tasklets[0];
+	s64_t stamp;
+
+	reset();
+
+	stamp = k_uptime_get();
+	start(t, sleep_handler);
+
+	/**TESTPOINT: the tasklet cannot be started again until it ends*/
+	zassert_equal(k_tasklet_start(&k_sys_tasklet_executor, &t->tasklet),
+		      -EBUSY, NULL);
+
+	k_sleep(TIMEOUT / 2);
+	zassert_false(k_tasklet_is_idle(&t->tasklet), "woke up early");
+
+	wait_idle(t);
+	zassert_true(k_uptime_delta(&stamp) >= TIMEOUT, NULL);
+}
+
+static int yield_order[NUM_TASKLETS * NUM_STEPS];
+static int yield_count;
+
+static void yield_handler(struct k_tasklet *tasklet)
+{
+	struct test_tasklet *t = CONTAINER_OF(tasklet, struct test_tasklet,
+					      tasklet);
+
+	K_TASKLET_BEGIN(tasklet);
+
+	for (t->steps = 0; t->steps < NUM_STEPS; t->steps++) {
+		yield_order[yield_count++] = t - tasklets;
+		K_TASKLET_YIELD(tasklet);
+	}
+
+	K_TASKLET_END(tasklet);
+}
+
+void test_tasklet_yield(void)
+{
+	int i;
+
+	reset();
+	yield_count = 0;
+
+	for (i = 0; i < 2; i++) {
+		start(&tasklets[i], yield_handler);
+	}
+
+	wait_idle(&tasklets[0]);
+	wait_idle(&tasklets[1]);
+
+	/**TESTPOINT: yielding tasklets run in turn*/
+	zassert_equal(yield_count, 2 * NUM_STEPS, NULL);
+	for (i = 0; i < yield_count; i++) {
+		zassert_equal(yield_order[i], i % 2,
+			      "tasklets did not alternate");
+	}
+}
+
+void test_tasklet_many(void)
+{
+	int i, step;
+
+	reset();
+
+	for (i = 0; i < NUM_TASKLETS; i++) {
+		start(&tasklets[i], sem_handler);
+	}
+
+	/**TESTPOINT: many tasklets wait on the same semaphore*/
+	for (step = 0; step < NUM_STEPS; step++) {
+		for (i = 0; i < NUM_TASKLETS; i++) {
+			k_sem_give(&sem);
+		}
+		k_sleep(10);
+	}
+
+	for (i = 0; i < NUM_TASKLETS; i++) {
+		wait_idle(&tasklets[i]);
+		zassert_equal(tasklets[i].steps, NUM_STEPS, NULL);
+	}
+	zassert_equal(k_sem_count_get(&sem), 0, NULL);
+}
+
+static void define_handler(struct k_tasklet *tasklet)
+{
+	K_TASKLET_BEGIN(tasklet);
+	K_TASKLET_SEM_TAKE(tasklet, &sem, K_FOREVER);
+	K_TASKLET_END(tasklet);
+}
+
+/**TESTPOINT: init via K_TASKLET_DEFINE*/
+K_TASKLET_DEFINE(defined_tasklet, define_handler);
+
+void test_tasklet_define(void)
+{
+	reset();
+
+	zassert_true(k_tasklet_is_idle(&defined_tasklet), NULL);
+	zassert_equal(k_tasklet_start(&k_sys_tasklet_executor,
+				      &defined_tasklet), 0, NULL);
+	k_sleep(10);
+	zassert_false(k_tasklet_is_idle(&defined_tasklet), NULL);
+
+	k_sem_give(&sem);
+	k_sleep(10);
+	zassert_true(k_tasklet_is_idle(&defined_tasklet), NULL);
+}
+
+/*test case main entry*/
+void test_main(void)
+{
+	ztest_test_suite(test_tasklet_api,
+			 ztest_unit_test(test_tasklet_sem_take),
+			 ztest_unit_test(test_tasklet_sem_take_timeout),
+			 ztest_unit_test(test_tasklet_queue_get),
+			 ztest_unit_test(test_tasklet_signal_wait),
+			 ztest_unit_test(test_tasklet_sleep),
+			 ztest_unit_test(test_tasklet_yield),
+			 ztest_unit_test(test_tasklet_many),
+			 ztest_unit_test(test_tasklet_define));
+	ztest_run_test_suite(test_tasklet_api);
+}
@@ -0,0 +1,105 @@
+/*
+ * Copyright (c) 2017 Intel Corporation
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+/**
+ * @addtogroup t_kernel_threads
+ * @{
+ * @defgroup t_threads_deadline test_threads_deadline
+ * @brief TestPurpose: verify earliest-deadline-first ordering of threads
+ * of the same priority
+ * @}
+ */
+
+#include <ztest.h>
+
+#define NUM_THREADS 8
+#define STACK_SIZE 512
+#define THREAD_PRIO K_PRIO_PREEMPT(1)
+
+K_THREAD_STACK_ARRAY_DEFINE(tstacks, NUM_THREADS, STACK_SIZE);
+static struct k_thread tdata[NUM_THREADS];
+
+/* deadlines, in cycles, deliberately not in creation order */
+static const int deadlines[NUM_THREADS] = {
+	8000, 3000, 6000, 1000, 7000, 2000, 5000, 4000
+};
+
+static int run_order[NUM_THREADS];
+static int run_count;
+
+static void worker(void *p1, void *p2, void *p3)
+{
+	ARG_UNUSED(p2);
+	ARG_UNUSED(p3);
+
+	run_order[run_count++] = (int)p1;
+}
+
+/**
+ * @brief Check that threads of equal priority run by earliest deadline
+ *
+ * @details Spawn threads at the same priority, lower than the test thread,
+ * give each a deadline that does not follow the creation order, then let
+ * them run and check they ran by increasing deadline.
+ */
+void test_deadline_order(void)
+{
+	int i;
+
+	zassert_true(k_thread_priority_get(k_current_get()) <
+		     THREAD_PRIO, "test thread must not be preempted");
+
+	run_count = 0;
+
+	for (i = 0; i < NUM_THREADS; i++) {
+		k_thread_create(&tdata[i], tstacks[i], STACK_SIZE, worker,
+				(void *)i, NULL, NULL, THREAD_PRIO, 0, K_NO_WAIT);
+		k_thread_deadline_set(&tdata[i], deadlines[i]);
+	}
+
+	zassert_equal(run_count, 0, "threads ran before the test thread slept");
+
+	k_sleep(K_MSEC(100));
+
+	zassert_equal(run_count, NUM_THREADS, "not all threads ran");
+
+	for (i = 1; i < NUM_THREADS; i++) {
+		zassert_true(deadlines[run_order[i - 1]] <
+			     deadlines[run_order[i]],
+			     "threads did not run in deadline order");
+	}
+}
+
+/**
+ * @brief Check that a deadline does not override the static priority
+ */
+void test_deadline_vs_priority(void)
+{
+	run_count = 0;
+
+	/* latest deadline, but higher priority: must run first */
+	k_thread_create(&tdata[0], tstacks[0], STACK_SIZE, worker,
+			(void *)0, NULL, NULL, THREAD_PRIO, 0, K_NO_WAIT);
+	k_thread_deadline_set(&tdata[0], 100000);
+
+	k_thread_create(&tdata[1], tstacks[1], STACK_SIZE, worker,
+			(void *)1, NULL, NULL, THREAD_PRIO + 1, 0, K_NO_WAIT);
+	k_thread_deadline_set(&tdata[1], 1000);
+
+	k_sleep(K_MSEC(100));
+
+	zassert_equal(run_count, 2, "not all threads ran");
+	zassert_equal(run_order[0], 0, "deadline overrode static priority");
+	zassert_equal(run_order[1], 1, "deadline overrode static priority");
+}
+
+void test_main(void)
+{
+	ztest_test_suite(test_threads_deadline,
+			 ztest_unit_test(test_deadline_order),
+			 ztest_unit_test(test_deadline_vs_priority));
+	ztest_run_test_suite(test_threads_deadline);
+}
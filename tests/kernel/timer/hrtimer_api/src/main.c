@@ -0,0 +1,183 @@
+/*
+ * Copyright (c) 2017 Intel Corporation
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+/**
+ * @addtogroup t_kernel_timer
+ * @{
+ * @defgroup t_hrtimer_api test_hrtimer_api
+ * @brief TestPurpose: verify high-resolution timer api functionality
+ * - API coverage
+ *   -# k_hrtimer_init
+ *   -# k_hrtimer_start
+ *   -# k_hrtimer_stop
+ *   -# k_hrtimer_us_to_cycles
+ *   -# k_hrtimer_user_data_set
+ *   -# k_hrtimer_user_data_get
+ * @}
+ */
+
+#include <ztest.h>
+
+#define DURATION_US 300
+#define PERIOD_US 500
+#define NUM_OF_PERIODS 10
+#define NUM_OF_TIMERS 3
+#define TIMEOUT 100
+
+static struct k_hrtimer timers[NUM_OF_TIMERS];
+static K_SEM_DEFINE(expiry_sema, 0, UINT_MAX);
+
+static volatile u32_t expiry_cycles;
+static volatile int expiry_count;
+static struct k_hrtimer *expired[NUM_OF_TIMERS];
+
+static void expiry_fn(struct k_hrtimer *timer)
+{
+	expiry_cycles = k_cycle_get_32();
+	if (expiry_count < NUM_OF_TIMERS) {
+		expired[expiry_count] = timer;
+	}
+	expiry_count++;
+	k_sem_give(&expiry_sema);
+}
+
+static void init_timers(void)
+{
+	int i;
+
+	for (i = 0; i < NUM_OF_TIMERS; i++) {
+		k_hrtimer_init(&timers[i], expiry_fn);
+	}
+
+	expiry_count = 0;
+	k_sem_reset(&expiry_sema);
+}
+
+/*test cases*/
+void test_hrtimer_oneshot(void)
+{
+	u32_t duration = k_hrtimer_us_to_cycles(DURATION_US);
+	u32_t start;
+
+	init_timers();
+
+	start = k_cycle_get_32();
+	k_hrtimer_start(&timers[0], duration, 0);
+
+	/**TESTPOINT: expires once, not before its duration*/
+	zassert_equal(k_sem_take(&expiry_sema, TIMEOUT), 0, NULL);
+	zassert_true(expiry_cycles - start >= duration, NULL);
+
+	k_sleep(1);
+	zassert_equal(expiry_count, 1, NULL);
+}
+
+void test_hrtimer_periodic(void)
+{
+	u32_t duration = k_hrtimer_us_to_cycles(DURATION_US);
+	u32_t period = k_hrtimer_us_to_cycles(PERIOD_US);
+	u32_t start;
+	int i;
+
+	init_timers();
+
+	start = k_cycle_get_32();
+	k_hrtimer_start(&timers[0], duration, period);
+
+	for (i = 0; i < NUM_OF_PERIODS; i++) {
+		zassert_equal(k_sem_take(&expiry_sema, TIMEOUT), 0, NULL);
+	}
+
+	k_hrtimer_stop(&timers[0]);
+
+	/**TESTPOINT: periods do not expire early*/
+	zassert_true(expiry_cycles - start >=
+		     duration + (NUM_OF_PERIODS - 1) * period, NULL);
+
+	/**TESTPOINT: a stopped timer does not expire anymore*/
+	i = expiry_count;
+	k_sleep(2 * PERIOD_US / 1000 + 1);
+	zassert_equal(expiry_count, i, NULL);
+}
+
+void test_hrtimer_stop(void)
+{
+	init_timers();
+
+	k_hrtimer_start(&timers[0], k_hrtimer_us_to_cycles(DURATION_US), 0);
+	k_hrtimer_stop(&timers[0]);
+
+	/**TESTPOINT: stopping before expiry, and stopping twice*/
+	k_sleep(DURATION_US / 1000 + 1);
+	zassert_equal(expiry_count, 0, NULL);
+	k_hrtimer_stop(&timers[0]);
+}
+
+void test_hrtimer_order(void)
+{
+	static const u32_t durations_us[NUM_OF_TIMERS] = { 900, 300, 600 };
+	int i;
+
+	init_timers();
+
+	for (i = 0; i < NUM_OF_TIMERS; i++) {
+		k_hrtimer_start(&timers[i],
+				k_hrtimer_us_to_cycles(durations_us[i]), 0);
+	}
+
+	for (i = 0; i < NUM_OF_TIMERS; i++) {
+		zassert_equal(k_sem_take(&expiry_sema, TIMEOUT), 0, NULL);
+	}
+
+	/**TESTPOINT: timers expire in the order of their expiry time*/
+	zassert_equal_ptr(expired[0], &timers[1], NULL);
+	zassert_equal_ptr(expired[1], &timers[2], NULL);
+	zassert_equal_ptr(expired[2], &timers[0], NULL);
+}
+
+void test_hrtimer_with_ticks(void)
+{
+	u32_t period = k_hrtimer_us_to_cycles(PERIOD_US);
+	s64_t stamp;
+
+	init_timers();
+
+	k_hrtimer_start(&timers[0], period, period);
+
+	/**TESTPOINT: tick based timeouts still expire on time*/
+	stamp = k_uptime_get();
+	k_sleep(10);
+	zassert_true(k_uptime_get() - stamp >= 10, NULL);
+
+	k_hrtimer_stop(&timers[0]);
+
+	zassert_true(expiry_count >= 10 * 1000 / PERIOD_US - 1, NULL);
+}
+
+void test_hrtimer_user_data(void)
+{
+	static int data;
+
+	init_timers();
+
+	zassert_is_null(k_hrtimer_user_data_get(&timers[0]), NULL);
+	k_hrtimer_user_data_set(&timers[0], &data);
+	zassert_equal_ptr(k_hrtimer_user_data_get(&timers[0]), &data, NULL);
+}
+
+void test_main(void)
+{
+	k_enable_sys_clock_always_on();
+
+	ztest_test_suite(test_hrtimer_api,
+			 ztest_unit_test(test_hrtimer_oneshot),
+			 ztest_unit_test(test_hrtimer_periodic),
+			 ztest_unit_test(test_hrtimer_stop),
+			 ztest_unit_test(test_hrtimer_order),
+			 ztest_unit_test(test_hrtimer_with_ticks),
+			 ztest_unit_test(test_hrtimer_user_data));
+	ztest_run_test_suite(test_hrtimer_api);
+}
@@ -18,6 +18,10 @@ extern void test_delayed_work_cancel_from_queue_thread(void);
 extern void test_delayed_work_cancel_from_queue_isr(void);
 extern void test_delayed_work_cancel_thread(void);
 extern void test_delayed_work_cancel_isr(void);
+extern void test_work_pool_submit_before_start(void);
+extern void test_work_pool_no_head_of_line_blocking(void);
+extern void test_work_pool_stats(void);
+extern void test_work_pool_prio(void);
 
 /*test case main entry*/
 void test_main(void)
@@ -35,6 +39,10 @@ void test_main(void)
 			 ztest_unit_test(test_delayed_work_cancel_from_queue_thread),
 			 ztest_unit_test(test_delayed_work_cancel_from_queue_isr),
 			 ztest_unit_test(test_delayed_work_cancel_thread),
-			 ztest_unit_test(test_delayed_work_cancel_isr));
+			 ztest_unit_test(test_delayed_work_cancel_isr),
+			 ztest_unit_test(test_work_pool_submit_before_start),
+			 ztest_unit_test(test_work_pool_no_head_of_line_blocking),
+			 ztest_unit_test(test_work_pool_stats),
+			 ztest_unit_test(test_work_pool_prio));
 	ztest_run_test_suite(test_workq_api);
 }
@@ -0,0 +1,175 @@
+/*
+ * Copyright (c) 2017 Intel Corporation
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+/**
+ * @addtogroup t_workq
+ * @{
+ * @defgroup t_work_pool test_work_pool
+ * @brief TestPurpose: verify workqueue pool API functionalities
+ * - API coverage
+ *   -# K_WORK_POOL_DEFINE
+ *   -# k_work_pool_start
+ *   -# k_work_pool_submit
+ *   -# k_work_pool_submit_prio
+ *   -# k_work_pool_stats_get
+ * @}
+ */
+
+#include <ztest.h>
+
+#define TIMEOUT 100
+#define STACK_SIZE 512
+#define NUM_OF_THREADS 2
+#define NUM_OF_PRIO_WORK 4
+
+K_WORK_POOL_DEFINE(pool, NUM_OF_THREADS, STACK_SIZE);
+
+static struct k_work blocking_work[NUM_OF_THREADS];
+static struct k_work quick_work;
+static struct k_work prio_work[NUM_OF_PRIO_WORK];
+
+static K_SEM_DEFINE(release_sema, 0, NUM_OF_THREADS);
+static K_SEM_DEFINE(done_sema, 0, NUM_OF_PRIO_WORK + NUM_OF_THREADS);
+
+static struct k_work *processed[NUM_OF_PRIO_WORK];
+static int num_processed;
+
+static void blocking_handler(struct k_work *w)
+{
+	k_sem_take(&release_sema, K_FOREVER);
+	k_sem_give(&done_sema);
+}
+
+static void recording_handler(struct k_work *w)
+{
+	processed[num_processed++] = w;
+	k_sem_give(&done_sema);
+}
+
+static void wait_done(int count)
+{
+	while (count--) {
+		zassert_equal(k_sem_take(&done_sema, TIMEOUT), 0, NULL);
+	}
+}
+
+/* keep all threads of the pool blocked in a handler */
+static void block_pool(void)
+{
+	int i;
+
+	for (i = 0; i < NUM_OF_THREADS; i++) {
+		k_work_init(&blocking_work[i], blocking_handler);
+		k_work_pool_submit(&pool, &blocking_work[i]);
+	}
+
+	/* let them take their work item */
+	k_sleep(TIMEOUT / 10);
+}
+
+static void release_pool(void)
+{
+	int i;
+
+	for (i = 0; i < NUM_OF_THREADS; i++) {
+		k_sem_give(&release_sema);
+	}
+}
+
+/*test cases*/
+void test_work_pool_submit_before_start(void)
+{
+	k_work_init(&quick_work, recording_handler);
+	num_processed = 0;
+
+	/**TESTPOINT: a work item submitted before the start waits for it*/
+	k_work_pool_submit(&pool, &quick_work);
+	k_sleep(TIMEOUT / 10);
+	zassert_true(k_work_pending(&quick_work), NULL);
+	zassert_equal(num_processed, 0, NULL);
+
+	k_work_pool_start(&pool, K_PRIO_PREEMPT(0));
+	wait_done(1);
+	zassert_equal(num_processed, 1, NULL);
+	zassert_false(k_work_pending(&quick_work), NULL);
+}
+
+void test_work_pool_no_head_of_line_blocking(void)
+{
+	k_work_init(&blocking_work[0], blocking_handler);
+	k_work_init(&quick_work, recording_handler);
+	num_processed = 0;
+
+	/**TESTPOINT: a work item is processed while another one blocks*/
+	k_work_pool_submit(&pool, &blocking_work[0]);
+	k_work_pool_submit(&pool, &quick_work);
+	wait_done(1);
+	zassert_equal(num_processed, 1, NULL);
+	zassert_false(k_work_pending(&blocking_work[0]), NULL);
+
+	k_sem_give(&release_sema);
+	wait_done(1);
+}
+
+void test_work_pool_stats(void)
+{
+	struct k_work_pool_stats stats;
+	int i;
+
+	block_pool();
+	num_processed = 0;
+
+	for (i = 0; i < NUM_OF_PRIO_WORK; i++) {
+		k_work_init(&prio_work[i], recording_handler);
+		k_work_pool_submit(&pool, &prio_work[i]);
+	}
+
+	/**TESTPOINT: the work items wait in the queue*/
+	k_work_pool_stats_get(&pool, &stats);
+	zassert_equal(stats.depth, NUM_OF_PRIO_WORK, NULL);
+	zassert_true(stats.max_depth >= NUM_OF_PRIO_WORK, NULL);
+
+	/**TESTPOINT: resubmitting a pending work item has no effect*/
+	k_work_pool_submit(&pool, &prio_work[0]);
+	k_work_pool_stats_get(&pool, &stats);
+	zassert_equal(stats.depth, NUM_OF_PRIO_WORK, NULL);
+
+	release_pool();
+	wait_done(NUM_OF_THREADS + NUM_OF_PRIO_WORK);
+
+	k_work_pool_stats_get(&pool, &stats);
+	zassert_equal(stats.depth, 0, NULL);
+	zassert_equal(num_processed, NUM_OF_PRIO_WORK, NULL);
+	zassert_true(stats.processed >= NUM_OF_THREADS + NUM_OF_PRIO_WORK,
+		     NULL);
+	/* the blocking handlers waited for the test to release them */
+	zassert_true(stats.max_handler_cycles > 0, NULL);
+}
+
+void test_work_pool_prio(void)
+{
+	/* submitted in that order, expected to be processed as 1, 3, 2, 0 */
+	static const int prios[NUM_OF_PRIO_WORK] = { 5, -1, 3, -1 };
+	int i;
+
+	block_pool();
+	num_processed = 0;
+
+	for (i = 0; i < NUM_OF_PRIO_WORK; i++) {
+		k_work_init(&prio_work[i], recording_handler);
+		k_work_pool_submit_prio(&pool, &prio_work[i], prios[i]);
+	}
+
+	release_pool();
+	wait_done(NUM_OF_THREADS + NUM_OF_PRIO_WORK);
+
+	/**TESTPOINT: higher priorities first, in order of submission*/
+	zassert_equal(num_processed, NUM_OF_PRIO_WORK, NULL);
+	zassert_equal_ptr(processed[0], &prio_work[1], NULL);
+	zassert_equal_ptr(processed[1], &prio_work[3], NULL);
+	zassert_equal_ptr(processed[2], &prio_work[2], NULL);
+	zassert_equal_ptr(processed[3], &prio_work[0], NULL);
+}
@@ -0,0 +1,191 @@
+/*
+ * Copyright (c) 2017 Intel Corporation
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+#include <ztest.h>
+#include <power.h>
+
+#define STATE_SHALLOW 0
+#define STATE_DEEP 1
+
+static const struct sys_pm_idle_state test_states[] = {
+	{ "shallow", 0, 0 },
+	{ "deep", 100, 50000 },
+};
+
+static const struct sys_pm_idle_state too_many_states[
+	CONFIG_SYS_POWER_IDLE_GOVERNOR_STATES + 1];
+
+/* number of times _sys_soc_suspend() was asked to enter each state */
+static volatile int suspends[ARRAY_SIZE(test_states)];
+
+int _sys_soc_suspend(s32_t ticks)
+{
+	ARG_UNUSED(ticks);
+
+	suspends[sys_pm_idle_state_get()]++;
+
+	/* enables interrupts */
+	k_cpu_idle();
+
+	return SYS_PM_LOW_POWER_STATE;
+}
+
+static void reset(void)
+{
+	int i;
+
+	sys_pm_idle_latency_max_set(UINT32_MAX);
+	sys_pm_idle_stats_reset();
+
+	for (i = 0; i < ARRAY_SIZE(test_states); i++) {
+		suspends[i] = 0;
+	}
+}
+
+/**
+ * @brief Check the description of the power states
+ */
+void test_idle_states_set(void)
+{
+	const struct sys_pm_idle_state *states;
+
+	zassert_equal(sys_pm_idle_states_set(test_states, 0), -EINVAL, NULL);
+	zassert_equal(sys_pm_idle_states_set(too_many_states,
+					     ARRAY_SIZE(too_many_states)),
+		      -EINVAL, NULL);
+
+	zassert_equal(sys_pm_idle_states_set(test_states,
+					     ARRAY_SIZE(test_states)), 0, NULL);
+	zassert_equal(sys_pm_idle_states_get(&states),
+		      ARRAY_SIZE(test_states), NULL);
+	zassert_equal(states, test_states, NULL);
+}
+
+/**
+ * @brief Check that long idles use the deep state
+ */
+void test_idle_long(void)
+{
+	struct sys_pm_idle_state_stats stats;
+	int i;
+
+	reset();
+
+	for (i = 0; i < 5; i++) {
+		k_sleep(200);
+	}
+
+	zassert_true(suspends[STATE_DEEP] >= 5, "deep state not used");
+
+	zassert_equal(sys_pm_idle_stats_get(STATE_DEEP, &stats), 0, NULL);
+	zassert_true(stats.entries >= 5, NULL);
+	zassert_true(stats.residency_us >= 5 * 150 * USEC_PER_MSEC,
+		     "residency not accounted");
+}
+
+/**
+ * @brief Check that idles of a tick, shorter than the minimum residency of
+ * the deep state, use the shallow state
+ */
+void test_idle_short(void)
+{
+	struct sys_pm_idle_state_stats stats;
+	int i;
+
+	reset();
+
+	for (i = 0; i < 20; i++) {
+		k_sleep(1);
+	}
+
+	zassert_equal(suspends[STATE_DEEP], 0, "deep state used");
+	zassert_true(suspends[STATE_SHALLOW] >= 20, "shallow state not used");
+
+	zassert_equal(sys_pm_idle_stats_get(STATE_DEEP, &stats), 0, NULL);
+	zassert_equal(stats.entries, 0, NULL);
+	zassert_equal(sys_pm_idle_stats_get(STATE_SHALLOW, &stats), 0, NULL);
+	zassert_equal(stats.too_long, 0, "idles were long enough");
+}
+
+/**
+ * @brief Check that states with too long an exit latency are not used, nor
+ * count the idles they would have suited as too long for the others
+ */
+void test_idle_latency_max(void)
+{
+	struct sys_pm_idle_state_stats stats;
+	int i;
+
+	reset();
+	sys_pm_idle_latency_max_set(test_states[STATE_DEEP].exit_latency_us - 1);
+
+	for (i = 0; i < 5; i++) {
+		k_sleep(200);
+	}
+
+	zassert_equal(suspends[STATE_DEEP], 0, "deep state used");
+
+	zassert_equal(sys_pm_idle_stats_get(STATE_SHALLOW, &stats), 0, NULL);
+	zassert_true(stats.entries >= 5, NULL);
+	zassert_equal(stats.too_long, 0, "no deeper state allowed");
+}
+
+/**
+ * @brief Check that wakes from idle are attributed to the timer
+ */
+void test_idle_wake_sources(void)
+{
+	struct sys_pm_idle_wake_source
+		sources[CONFIG_SYS_POWER_IDLE_GOVERNOR_WAKE_SOURCES];
+	int i, n;
+
+	reset();
+
+	for (i = 0; i < 10; i++) {
+		k_sleep(100);
+	}
+
+	n = sys_pm_idle_wake_sources_get(sources, ARRAY_SIZE(sources));
+	zassert_true(n > 0, "no wake source");
+
+	for (i = 0; i < n; i++) {
+		if (sources[i].source == SYS_PM_IDLE_WAKE_TIMER) {
+			break;
+		}
+	}
+
+	zassert_true(i < n, "timer not tracked");
+	zassert_true(sources[i].wakes >= 10, NULL);
+	zassert_true(sources[i].interval_us > 80 * USEC_PER_MSEC &&
+		     sources[i].interval_us < 120 * USEC_PER_MSEC,
+		     "wrong interval between wakes");
+}
+
+/**
+ * @brief Check the validation of the state index
+ */
+void test_idle_stats_get(void)
+{
+	struct sys_pm_idle_state_stats stats;
+
+	zassert_equal(sys_pm_idle_stats_get(SYS_PM_IDLE_CPU, &stats), 0, NULL);
+	zassert_equal(sys_pm_idle_stats_get(SYS_PM_IDLE_CPU - 1, &stats),
+		      -EINVAL, NULL);
+	zassert_equal(sys_pm_idle_stats_get(ARRAY_SIZE(test_states), &stats),
+		      -EINVAL, NULL);
+}
+
+void test_main(void)
+{
+	ztest_test_suite(test_idle_governor,
+			 ztest_unit_test(test_idle_states_set),
+			 ztest_unit_test(test_idle_long),
+			 ztest_unit_test(test_idle_short),
+			 ztest_unit_test(test_idle_latency_max),
+			 ztest_unit_test(test_idle_wake_sources),
+			 ztest_unit_test(test_idle_stats_get));
+	ztest_run_test_suite(test_idle_governor);
+}
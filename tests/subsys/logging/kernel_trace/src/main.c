@@ -0,0 +1,109 @@
+/*
+ * Copyright (c) 2017 Intel Corporation
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+#include <ztest.h>
+#include <logging/kernel_trace.h>
+
+#define NUM_RECORDS CONFIG_KERNEL_TRACE_RECORDS
+
+#define TEST_EVENT (SYS_TRACE_USER + 1)
+
+static K_SEM_DEFINE(sem, 0, 1);
+
+/* index of the first record with that event and object, from start on */
+static int find_record(u32_t start, u16_t id, const void *obj,
+		       struct sys_trace_record *record)
+{
+	u32_t index;
+
+	for (index = start; index != sys_trace_head(); index++) {
+		if (sys_trace_get(index, record) == 0 && record->id == id &&
+		    record->obj == (u32_t)obj) {
+			return index;
+		}
+	}
+
+	return -1;
+}
+
+/**
+ * @brief Check that semaphore operations are recorded, in order
+ */
+void test_trace_sem(void)
+{
+	struct sys_trace_record give, take;
+	u32_t start = sys_trace_head();
+	int give_index, take_index;
+
+	k_sem_give(&sem);
+	zassert_equal(k_sem_take(&sem, K_NO_WAIT), 0, NULL);
+
+	give_index = find_record(start, SYS_TRACE_SEM_GIVE, &sem, &give);
+	take_index = find_record(start, SYS_TRACE_SEM_TAKE, &sem, &take);
+
+	zassert_true(give_index >= 0, "give not recorded");
+	zassert_true(take_index > give_index, "take not recorded after give");
+	zassert_equal(give.arg, 0, "wrong count");
+	zassert_equal(take.arg, K_NO_WAIT, "wrong timeout");
+	zassert_true(take.timestamp - give.timestamp < 0x80000000,
+		     "timestamps out of order");
+}
+
+/**
+ * @brief Check that the oldest records are overwritten
+ */
+void test_trace_overwrite(void)
+{
+	struct sys_trace_record record;
+	u32_t start = sys_trace_head();
+	int i;
+
+	for (i = 0; i < NUM_RECORDS + 8; i++) {
+		sys_trace_event(TEST_EVENT, &record, i);
+	}
+
+	zassert_equal(sys_trace_get(start, &record), -ENOENT,
+		      "oldest record not overwritten");
+
+	zassert_equal(sys_trace_get(sys_trace_head() - 1, &record), 0,
+		      "last record not readable");
+	zassert_equal(record.id, TEST_EVENT, "wrong event");
+	zassert_equal(record.arg, NUM_RECORDS + 7, "wrong argument");
+
+	zassert_equal(sys_trace_get(sys_trace_head(), &record), -ENOENT,
+		      "future record readable");
+}
+
+/**
+ * @brief Check that nothing is recorded while tracing is stopped
+ */
+void test_trace_enable(void)
+{
+	u32_t head;
+
+	sys_trace_enable(0);
+	head = sys_trace_head();
+
+	sys_trace_event(TEST_EVENT, NULL, 0);
+	k_sem_give(&sem);
+	k_sem_take(&sem, K_NO_WAIT);
+
+	zassert_equal(sys_trace_head(), head, "recorded while stopped");
+
+	sys_trace_enable(1);
+	sys_trace_event(TEST_EVENT, NULL, 0);
+
+	zassert_not_equal(sys_trace_head(), head, "not recorded once resumed");
+}
+
+void test_main(void)
+{
+	ztest_test_suite(test_kernel_trace,
+			 ztest_unit_test(test_trace_sem),
+			 ztest_unit_test(test_trace_overwrite),
+			 ztest_unit_test(test_trace_enable));
+	ztest_run_test_suite(test_kernel_trace);
+}
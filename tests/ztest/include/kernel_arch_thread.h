@@ -11,6 +11,7 @@
  * This file contains definitions for
  *
  *  struct _thread_arch
+ *  struct _thread_arch_hot
  *  struct _callee_saved
  *  struct _caller_saved
  *
@@ -33,6 +34,11 @@ struct _callee_saved {
 
 typedef struct _callee_saved _callee_saved_t;
 
+struct _thread_arch_hot {
+};
+
+typedef struct _thread_arch_hot _thread_arch_hot_t;
+
 struct _thread_arch {
 };
 